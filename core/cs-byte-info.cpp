@@ -0,0 +1,63 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "cs-byte-info.hpp"
+
+#include <ndn-cxx/encoding/block-helpers.hpp>
+
+namespace nfd {
+
+Block
+appendCsByteInfo(const Block& csInfo, const CsByteInfo& byteInfo)
+{
+  Block wire(csInfo);
+  wire.parse();
+  if (byteInfo.byteCapacity) {
+    wire.push_back(ndn::encoding::makeNonNegativeIntegerBlock(tlv::CsByteCapacity, *byteInfo.byteCapacity));
+  }
+  wire.push_back(ndn::encoding::makeNonNegativeIntegerBlock(tlv::CsNBytes, byteInfo.nBytes));
+  wire.encode();
+  return wire;
+}
+
+optional<CsByteInfo>
+extractCsByteInfo(const Block& csInfo)
+{
+  csInfo.parse();
+  auto nBytes = csInfo.find(tlv::CsNBytes);
+  if (nBytes == csInfo.elements_end()) {
+    return nullopt;
+  }
+
+  CsByteInfo byteInfo;
+  byteInfo.nBytes = ndn::encoding::readNonNegativeInteger(*nBytes);
+  auto byteCapacity = csInfo.find(tlv::CsByteCapacity);
+  if (byteCapacity != csInfo.elements_end()) {
+    byteInfo.byteCapacity = ndn::encoding::readNonNegativeInteger(*byteCapacity);
+  }
+  return byteInfo;
+}
+
+} // namespace nfd
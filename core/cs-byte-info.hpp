@@ -0,0 +1,69 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_CORE_CS_BYTE_INFO_HPP
+#define NFD_CORE_CS_BYTE_INFO_HPP
+
+#include "common.hpp"
+
+namespace nfd {
+
+namespace tlv {
+
+/** \brief TLV-TYPE numbers of the byte usage fields appended to CsInfo
+ */
+enum : uint32_t {
+  CsByteCapacity = 0x0C80,
+  CsNBytes       = 0x0C82,
+};
+
+} // namespace tlv
+
+/** \brief byte usage of the Content Store
+ *
+ *  NFD carries these fields in the CsInfo dataset, after the fields defined by the
+ *  NFD Management Protocol. Decoders that do not know them ignore them.
+ */
+struct CsByteInfo
+{
+  /// byte capacity, nullopt if the Content Store has no byte limit
+  optional<uint64_t> byteCapacity;
+  /// bytes used by stored packets, including per-entry overhead
+  uint64_t nBytes = 0;
+};
+
+/** \return \p csInfo with the fields of \p byteInfo appended
+ */
+Block
+appendCsByteInfo(const Block& csInfo, const CsByteInfo& byteInfo);
+
+/** \return the byte usage carried in \p csInfo, or nullopt if it carries none
+ */
+optional<CsByteInfo>
+extractCsByteInfo(const Block& csInfo);
+
+} // namespace nfd
+
+#endif // NFD_CORE_CS_BYTE_INFO_HPP
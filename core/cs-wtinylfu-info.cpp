@@ -0,0 +1,72 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "cs-wtinylfu-info.hpp"
+
+#include <ndn-cxx/encoding/block-helpers.hpp>
+
+namespace nfd {
+
+Block
+appendCsWTinyLfuInfo(const Block& csInfo, const CsWTinyLfuInfo& info)
+{
+  Block wire(csInfo);
+  wire.parse();
+  wire.push_back(ndn::encoding::makeNonNegativeIntegerBlock(tlv::CsNWindowHits, info.nWindowHits));
+  wire.push_back(ndn::encoding::makeNonNegativeIntegerBlock(tlv::CsNProbationHits, info.nProbationHits));
+  wire.push_back(ndn::encoding::makeNonNegativeIntegerBlock(tlv::CsNProtectedHits, info.nProtectedHits));
+  wire.push_back(ndn::encoding::makeNonNegativeIntegerBlock(tlv::CsNInserted, info.nInserted));
+  wire.push_back(ndn::encoding::makeNonNegativeIntegerBlock(tlv::CsNAdmitted, info.nAdmitted));
+  wire.push_back(ndn::encoding::makeNonNegativeIntegerBlock(tlv::CsNRejected, info.nRejected));
+  wire.encode();
+  return wire;
+}
+
+static uint64_t
+readCounter(const Block& csInfo, uint32_t type)
+{
+  auto element = csInfo.find(type);
+  return element == csInfo.elements_end() ? 0 : ndn::encoding::readNonNegativeInteger(*element);
+}
+
+optional<CsWTinyLfuInfo>
+extractCsWTinyLfuInfo(const Block& csInfo)
+{
+  csInfo.parse();
+  if (csInfo.find(tlv::CsNInserted) == csInfo.elements_end()) {
+    return nullopt;
+  }
+
+  CsWTinyLfuInfo info;
+  info.nWindowHits = readCounter(csInfo, tlv::CsNWindowHits);
+  info.nProbationHits = readCounter(csInfo, tlv::CsNProbationHits);
+  info.nProtectedHits = readCounter(csInfo, tlv::CsNProtectedHits);
+  info.nInserted = readCounter(csInfo, tlv::CsNInserted);
+  info.nAdmitted = readCounter(csInfo, tlv::CsNAdmitted);
+  info.nRejected = readCounter(csInfo, tlv::CsNRejected);
+  return info;
+}
+
+} // namespace nfd
@@ -0,0 +1,82 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_CORE_CS_WTINYLFU_INFO_HPP
+#define NFD_CORE_CS_WTINYLFU_INFO_HPP
+
+#include "common.hpp"
+
+namespace nfd {
+
+namespace tlv {
+
+/** \brief TLV-TYPE numbers of the W-TinyLFU policy counters appended to CsInfo
+ */
+enum : uint32_t {
+  CsNWindowHits    = 0x0C84,
+  CsNProbationHits = 0x0C86,
+  CsNProtectedHits = 0x0C88,
+  CsNInserted      = 0x0C8A,
+  CsNAdmitted      = 0x0C8C,
+  CsNRejected      = 0x0C8E,
+};
+
+} // namespace tlv
+
+/** \brief counters of the W-TinyLFU replacement policy of the Content Store
+ *
+ *  NFD carries these fields in the CsInfo dataset when the Content Store uses the W-TinyLFU
+ *  policy, after the fields defined by the NFD Management Protocol and CsByteInfo.
+ *  Decoders that do not know them ignore them.
+ */
+struct CsWTinyLfuInfo
+{
+  /// lookups matched by an entry in the window
+  uint64_t nWindowHits = 0;
+  /// lookups matched by an entry on probation in the main cache
+  uint64_t nProbationHits = 0;
+  /// lookups matched by a protected entry in the main cache
+  uint64_t nProtectedHits = 0;
+  /// new entries
+  uint64_t nInserted = 0;
+  /// window entries admitted into the main cache over a victim
+  uint64_t nAdmitted = 0;
+  /// window entries evicted in favor of a main cache entry
+  uint64_t nRejected = 0;
+};
+
+/** \return \p csInfo with the fields of \p info appended
+ */
+Block
+appendCsWTinyLfuInfo(const Block& csInfo, const CsWTinyLfuInfo& info);
+
+/** \return the W-TinyLFU counters carried in \p csInfo, or nullopt if it carries none
+ */
+optional<CsWTinyLfuInfo>
+extractCsWTinyLfuInfo(const Block& csInfo);
+
+} // namespace nfd
+
+#endif // NFD_CORE_CS_WTINYLFU_INFO_HPP
@@ -0,0 +1,75 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "face-contention-info.hpp"
+
+#include <ndn-cxx/encoding/block-helpers.hpp>
+
+namespace nfd {
+
+Block
+appendFaceContentionInfo(const Block& faceStatus, const FaceContentionInfo& info)
+{
+  Block wire(faceStatus);
+  wire.parse();
+  wire.push_back(ndn::encoding::makeNonNegativeIntegerBlock(tlv::NDuplicateInterests,
+                                                            info.nDuplicateInterests));
+  wire.push_back(ndn::encoding::makeNonNegativeIntegerBlock(tlv::NDeferredInterests,
+                                                            info.nDeferredInterests));
+  wire.push_back(ndn::encoding::makeNonNegativeIntegerBlock(tlv::NSuppressedInterests,
+                                                            info.nSuppressedInterests));
+  wire.push_back(ndn::encoding::makeNonNegativeIntegerBlock(tlv::NRebroadcastInterests,
+                                                            info.nRebroadcastInterests));
+  wire.push_back(ndn::encoding::makeNonNegativeIntegerBlock(tlv::NRedundantRebroadcasts,
+                                                            info.nRedundantRebroadcasts));
+  wire.encode();
+  return wire;
+}
+
+static uint64_t
+readCounter(const Block& faceStatus, uint32_t type)
+{
+  auto element = faceStatus.find(type);
+  return element == faceStatus.elements_end() ? 0 : ndn::encoding::readNonNegativeInteger(*element);
+}
+
+optional<FaceContentionInfo>
+extractFaceContentionInfo(const Block& faceStatus)
+{
+  faceStatus.parse();
+  if (faceStatus.find(tlv::NDeferredInterests) == faceStatus.elements_end()) {
+    return nullopt;
+  }
+
+  FaceContentionInfo info;
+  info.nDuplicateInterests = readCounter(faceStatus, tlv::NDuplicateInterests);
+  info.nDeferredInterests = readCounter(faceStatus, tlv::NDeferredInterests);
+  info.nSuppressedInterests = readCounter(faceStatus, tlv::NSuppressedInterests);
+  info.nRebroadcastInterests = readCounter(faceStatus, tlv::NRebroadcastInterests);
+  info.nRedundantRebroadcasts = readCounter(faceStatus, tlv::NRedundantRebroadcasts);
+  return info;
+}
+
+} // namespace nfd
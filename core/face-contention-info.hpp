@@ -0,0 +1,78 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_CORE_FACE_CONTENTION_INFO_HPP
+#define NFD_CORE_FACE_CONTENTION_INFO_HPP
+
+#include "common.hpp"
+
+namespace nfd {
+
+namespace tlv {
+
+/** \brief TLV-TYPE numbers of the contention counters appended to FaceStatus
+ */
+enum : uint32_t {
+  NDuplicateInterests    = 0x0C90,
+  NDeferredInterests     = 0x0C92,
+  NSuppressedInterests   = 0x0C94,
+  NRebroadcastInterests  = 0x0C96,
+  NRedundantRebroadcasts = 0x0C98,
+};
+
+} // namespace tlv
+
+/** \brief counters of the Interest rebroadcasts deferred on an ad-hoc face
+ *
+ *  NFD carries these fields in the FaceStatus of ad-hoc faces, after the fields defined by
+ *  the NFD Management Protocol. Decoders that do not know them ignore them.
+ */
+struct FaceContentionInfo
+{
+  /// incoming Interests that had already been deferred or sent
+  uint64_t nDuplicateInterests = 0;
+  /// outgoing Interests deferred by a contention delay
+  uint64_t nDeferredInterests = 0;
+  /// deferred Interests cancelled because a neighbor was overheard sending them
+  uint64_t nSuppressedInterests = 0;
+  /// deferred Interests sent after their contention delay
+  uint64_t nRebroadcastInterests = 0;
+  /// sent Interests that a neighbor was also overheard sending
+  uint64_t nRedundantRebroadcasts = 0;
+};
+
+/** \return \p faceStatus with the fields of \p info appended
+ */
+Block
+appendFaceContentionInfo(const Block& faceStatus, const FaceContentionInfo& info);
+
+/** \return the contention counters carried in \p faceStatus, or nullopt if it carries none
+ */
+optional<FaceContentionInfo>
+extractFaceContentionInfo(const Block& faceStatus);
+
+} // namespace nfd
+
+#endif // NFD_CORE_FACE_CONTENTION_INFO_HPP
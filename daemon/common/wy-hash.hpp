@@ -0,0 +1,121 @@
+// This is free and unencumbered software released into the public domain.
+//
+// Anyone is free to copy, modify, publish, use, compile, sell, or
+// distribute this software, either in source code form or as a compiled
+// binary, for any purpose, commercial or non-commercial, and by any
+// means.
+//
+// For more information, please refer to <http://unlicense.org/>
+//
+// wyhash, by Wang Yi
+//
+// https://github.com/wangyi-fudan/wyhash
+//
+// This file provides WyHash64, adapted from the final version 4 of wyhash.
+// It hashes short strings, such as name components, in a few multiplications
+// and passes SMHasher. The seed allows chaining: hashing each string with the
+// hash of the previous ones as seed yields a hash of the whole sequence.
+//
+// The hash value depends on the byte order of the host, so it must not be
+// stored or sent to other hosts.
+
+#ifndef WY_HASH_HPP
+#define WY_HASH_HPP
+
+#include <stdint.h>
+#include <string.h>  // for memcpy and size_t.
+
+namespace wyhash_detail {
+
+const uint64_t WYP[4] = {0x2d358dccaa6c78a5ull, 0x8bb84b93962eacc9ull,
+                         0x4b33a62ed433d4a3ull, 0x4d5a2da51de1aa47ull};
+
+// 64x64 to 128-bit multiplication; *A receives the low half, *B the high half.
+inline void Mum(uint64_t* A, uint64_t* B) {
+#if defined(__SIZEOF_INT128__)
+  __uint128_t r = *A;
+  r *= *B;
+  *A = static_cast<uint64_t>(r);
+  *B = static_cast<uint64_t>(r >> 64);
+#else
+  uint64_t ha = *A >> 32, hb = *B >> 32, la = static_cast<uint32_t>(*A), lb = static_cast<uint32_t>(*B);
+  uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb, t = rl + (rm0 << 32);
+  uint64_t c = t < rl;
+  uint64_t lo = t + (rm1 << 32);
+  c += lo < t;
+  uint64_t hi = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+  *A = lo;
+  *B = hi;
+#endif
+}
+
+inline uint64_t Mix(uint64_t A, uint64_t B) {
+  Mum(&A, &B);
+  return A ^ B;
+}
+
+inline uint64_t Read8(const uint8_t* p) {
+  uint64_t v;
+  memcpy(&v, p, 8);
+  return v;
+}
+
+inline uint64_t Read4(const uint8_t* p) {
+  uint32_t v;
+  memcpy(&v, p, 4);
+  return v;
+}
+
+inline uint64_t Read3(const uint8_t* p, size_t k) {
+  return (static_cast<uint64_t>(p[0]) << 16) | (static_cast<uint64_t>(p[k >> 1]) << 8) | p[k - 1];
+}
+
+} // namespace wyhash_detail
+
+inline uint64_t WyHash64(const void* key, size_t len, uint64_t seed) {
+  using namespace wyhash_detail;
+
+  const uint8_t* p = static_cast<const uint8_t*>(key);
+  seed ^= Mix(seed ^ WYP[0], WYP[1]);
+  uint64_t a, b;
+  if (len <= 16) {
+    if (len >= 4) {
+      a = (Read4(p) << 32) | Read4(p + ((len >> 3) << 2));
+      b = (Read4(p + len - 4) << 32) | Read4(p + len - 4 - ((len >> 3) << 2));
+    }
+    else if (len > 0) {
+      a = Read3(p, len);
+      b = 0;
+    }
+    else {
+      a = b = 0;
+    }
+  }
+  else {
+    size_t i = len;
+    if (i > 48) {
+      uint64_t see1 = seed, see2 = seed;
+      do {
+        seed = Mix(Read8(p) ^ WYP[1], Read8(p + 8) ^ seed);
+        see1 = Mix(Read8(p + 16) ^ WYP[2], Read8(p + 24) ^ see1);
+        see2 = Mix(Read8(p + 32) ^ WYP[3], Read8(p + 40) ^ see2);
+        p += 48;
+        i -= 48;
+      } while (i > 48);
+      seed ^= see1 ^ see2;
+    }
+    while (i > 16) {
+      seed = Mix(Read8(p) ^ WYP[1], Read8(p + 8) ^ seed);
+      i -= 16;
+      p += 16;
+    }
+    a = Read8(p + i - 16);
+    b = Read8(p + i - 8);
+  }
+  a ^= WYP[1];
+  b ^= seed;
+  Mum(&a, &b);
+  return Mix(a ^ WYP[0] ^ len, b ^ WYP[1]);
+}
+
+#endif  // WY_HASH_HPP
@@ -89,6 +89,26 @@ public:
    */
   PacketCounter nOutHopLimitZero;
 
+  /** \brief count of incoming Interests that a contention-based strategy had already deferred or sent
+   */
+  PacketCounter nDuplicateInterests;
+
+  /** \brief count of outgoing Interests deferred by a contention delay
+   */
+  PacketCounter nDeferredInterests;
+
+  /** \brief count of deferred Interests cancelled because a neighbor was overheard sending them
+   */
+  PacketCounter nSuppressedInterests;
+
+  /** \brief count of deferred Interests sent after their contention delay
+   */
+  PacketCounter nRebroadcastInterests;
+
+  /** \brief count of sent Interests that a neighbor was also overheard sending
+   */
+  PacketCounter nRedundantRebroadcasts;
+
 private:
   const LinkService::Counters& m_linkServiceCounters;
   const Transport::Counters& m_transportCounters;
@@ -24,6 +24,7 @@
  */
 
 #include "generic-link-service.hpp"
+#include "lp-location.hpp"
 
 #include <ndn-cxx/lp/pit-token.hpp>
 #include <ndn-cxx/lp/tags.hpp>
@@ -182,6 +183,13 @@ GenericLinkService::encodeLpFields(const ndn::PacketBase& netPkt, lp::Packet& lp
   if (pitToken != nullptr) {
     lpPacket.add<lp::PitTokenField>(*pitToken);
   }
+
+  // the value is kept encoded by the tag, so it is copied without encoding the locations;
+  // an lp::LocationTag attached outside NFD is translated first
+  auto locationTag = getLocationTag(netPkt);
+  if (locationTag != nullptr) {
+    lpPacket.add<LocationField>(locationTag->getValue());
+  }
 }
 
 void
@@ -408,6 +416,13 @@ GenericLinkService::decodeInterest(const Block& netPkt, const lp::Packet& firstP
     interest->setTag(make_shared<lp::PitToken>(firstPkt.get<lp::PitTokenField>()));
   }
 
+  if (firstPkt.has<LocationField>()) {
+    auto locationTag = make_shared<LocationTag>(firstPkt.get<LocationField>());
+    // applications reading lp::LocationTag see the locations as received
+    interest->setTag(make_shared<lp::LocationTag>(locationTag->get()));
+    interest->setTag(std::move(locationTag));
+  }
+
   this->receiveInterest(*interest, endpointId);
 }
 
@@ -462,6 +477,13 @@ GenericLinkService::decodeData(const Block& netPkt, const lp::Packet& firstPkt,
     }
   }
 
+  if (firstPkt.has<LocationField>()) {
+    auto locationTag = make_shared<LocationTag>(firstPkt.get<LocationField>());
+    // applications reading lp::LocationTag see the locations as received
+    data->setTag(make_shared<lp::LocationTag>(locationTag->get()));
+    data->setTag(std::move(locationTag));
+  }
+
   this->receiveData(*data, endpointId);
 }
 
@@ -0,0 +1,131 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "lp-location.hpp"
+
+#include <boost/endian/conversion.hpp>
+
+#include <cstring>
+
+namespace nfd {
+namespace face {
+
+LocationTag::LocationTag()
+{
+  m_value.fill(0);
+  m_header.setMyLocation(ndn::Location(0, 0));
+  m_header.setPrevLocation(ndn::Location(0, 0));
+  m_header.setDestLocation(ndn::Location(0, 0));
+}
+
+LocationTag::LocationTag(const Value& value)
+  : m_value(value)
+{
+  m_header.setMyLocation(read(MY_OFFSET));
+  m_header.setPrevLocation(read(PREV_OFFSET));
+  m_header.setDestLocation(read(DEST_OFFSET));
+}
+
+LocationTag::LocationTag(const lp::LocationHeader& header)
+  : m_header(header)
+{
+  patch(MY_OFFSET, header.getMyLocation());
+  patch(PREV_OFFSET, header.getPrevLocation());
+  patch(DEST_OFFSET, header.getDestLocation());
+}
+
+void
+LocationTag::setMyLocation(const ndn::Location& location)
+{
+  patch(MY_OFFSET, location);
+  m_header.setMyLocation(location);
+}
+
+void
+LocationTag::setPrevLocation(const ndn::Location& location)
+{
+  patch(PREV_OFFSET, location);
+  m_header.setPrevLocation(location);
+}
+
+void
+LocationTag::setDestLocation(const ndn::Location& location)
+{
+  patch(DEST_OFFSET, location);
+  m_header.setDestLocation(location);
+}
+
+static void
+writeDouble(uint8_t* pos, double x)
+{
+  static_assert(sizeof(double) == sizeof(uint64_t), "double must be 64 bits");
+  uint64_t bits = 0;
+  std::memcpy(&bits, &x, sizeof(bits));
+  boost::endian::native_to_big_inplace(bits);
+  std::memcpy(pos, &bits, sizeof(bits));
+}
+
+static double
+readDouble(const uint8_t* pos)
+{
+  uint64_t bits = 0;
+  std::memcpy(&bits, pos, sizeof(bits));
+  boost::endian::big_to_native_inplace(bits);
+  double x = 0;
+  std::memcpy(&x, &bits, sizeof(x));
+  return x;
+}
+
+void
+LocationTag::patch(size_t offset, const ndn::Location& location)
+{
+  writeDouble(&m_value[offset], location.getLatitude());
+  writeDouble(&m_value[offset + sizeof(double)], location.getLongitude());
+}
+
+ndn::Location
+LocationTag::read(size_t offset) const
+{
+  return ndn::Location(readDouble(&m_value[offset]), readDouble(&m_value[offset + sizeof(double)]));
+}
+
+LocationField::ValueType
+LocationField::decode(const Block& wire)
+{
+  if (wire.type() != TlvType::value) {
+    NDN_THROW(ndn::tlv::Error("Unexpected TLV-TYPE " + to_string(wire.type())));
+  }
+  if (wire.value_size() != LocationTag::VALUE_SIZE) {
+    NDN_THROW(ndn::tlv::Error("Location field must have " + to_string(LocationTag::VALUE_SIZE) +
+                              " octets, not " + to_string(wire.value_size())));
+  }
+
+  ValueType value;
+  std::copy(wire.value_begin(), wire.value_end(), value.begin());
+  return value;
+}
+
+} // namespace face
+} // namespace nfd
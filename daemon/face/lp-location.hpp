@@ -0,0 +1,176 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_FACE_LP_LOCATION_HPP
+#define NFD_DAEMON_FACE_LP_LOCATION_HPP
+
+#include "core/common.hpp"
+
+#include <ndn-cxx/encoding/encoding-buffer.hpp>
+#include <ndn-cxx/lp/field.hpp>
+#include <ndn-cxx/lp/location-header.hpp>
+#include <ndn-cxx/lp/tags.hpp>
+#include <ndn-cxx/tag.hpp>
+
+#include <array>
+
+namespace nfd {
+namespace face {
+
+/** \brief TLV-TYPE of the NDNLPv2 header field carrying the locations of a CLF hop
+ *
+ *  The type is in the range of header fields that a receiver not recognizing them can ignore.
+ */
+constexpr uint64_t TLV_LOCATION_FIELD = 908;
+
+/** \brief locations of a CLF hop, kept in a fixed-size encoding that is patched in place
+ *
+ *  The value is three (latitude, longitude) pairs for MyLocation, PrevLocation and
+ *  DestLocation, each coordinate an IEEE 754 double in network byte order. Because every
+ *  coordinate has a fixed offset, setting a location rewrites 16 bytes of the value instead
+ *  of re-encoding the header, and GenericLinkService copies the value into the LpPacket as is.
+ *
+ *  A forwarder owns the tag of a packet it received, so it can update the locations before
+ *  sending the packet on, without allocating another tag. A tag shared by several packets
+ *  must not be patched.
+ */
+class LocationTag : public ndn::Tag
+{
+public:
+  static constexpr int
+  getTypeId() noexcept
+  {
+    return 0x434c4601;
+  }
+
+  static constexpr size_t VALUE_SIZE = 3 * 2 * sizeof(double);
+  using Value = std::array<uint8_t, VALUE_SIZE>;
+
+  /** \brief create a tag with all locations (0, 0), i.e., unknown
+   */
+  LocationTag();
+
+  explicit
+  LocationTag(const Value& value);
+
+  /** \brief create a tag with the locations of \p header
+   */
+  explicit
+  LocationTag(const lp::LocationHeader& header);
+
+  const lp::LocationHeader&
+  get() const noexcept
+  {
+    return m_header;
+  }
+
+  const Value&
+  getValue() const noexcept
+  {
+    return m_value;
+  }
+
+  void
+  setMyLocation(const ndn::Location& location);
+
+  void
+  setPrevLocation(const ndn::Location& location);
+
+  void
+  setDestLocation(const ndn::Location& location);
+
+private:
+  enum : size_t {
+    MY_OFFSET = 0,
+    PREV_OFFSET = 2 * sizeof(double),
+    DEST_OFFSET = 4 * sizeof(double),
+  };
+
+  void
+  patch(size_t offset, const ndn::Location& location);
+
+  ndn::Location
+  read(size_t offset) const;
+
+private:
+  lp::LocationHeader m_header;
+  Value m_value;
+};
+
+/** \brief get the LocationTag of \p packet
+ *
+ *  Applications and link layers outside NFD, such as ndnSIM's, attach the locations as an
+ *  lp::LocationTag. If \p packet only has that tag, it is translated into a LocationTag,
+ *  which is attached to \p packet so that later updates of the locations go with it.
+ *
+ *  \return the LocationTag, or nullptr if \p packet has neither tag
+ */
+template<typename Packet>
+shared_ptr<LocationTag>
+getLocationTag(const Packet& packet)
+{
+  auto tag = packet.template getTag<LocationTag>();
+  if (tag == nullptr) {
+    auto lpTag = packet.template getTag<lp::LocationTag>();
+    if (lpTag != nullptr) {
+      tag = make_shared<LocationTag>(lpTag->get());
+      packet.setTag(tag);
+    }
+  }
+  return tag;
+}
+
+/** \brief NDNLPv2 header field carrying the value of a LocationTag
+ *
+ *  This follows the interface of lp::FieldDecl, so that it can be used with
+ *  lp::Packet::add, get and has.
+ */
+struct LocationField
+{
+  using FieldLocation = lp::field_location_tags::Header;
+  using ValueType = LocationTag::Value;
+  using TlvType = std::integral_constant<uint64_t, TLV_LOCATION_FIELD>;
+  using IsRepeatable = std::false_type;
+
+  /** \throw ndn::tlv::Error \p wire is not a location field of VALUE_SIZE octets
+   */
+  static ValueType
+  decode(const Block& wire);
+
+  template<ndn::encoding::Tag TAG>
+  static size_t
+  encode(ndn::EncodingImpl<TAG>& encoder, const ValueType& value)
+  {
+    size_t length = encoder.prependBytes(value);
+    length += encoder.prependVarNumber(length);
+    length += encoder.prependVarNumber(TlvType::value);
+    return length;
+  }
+};
+
+} // namespace face
+} // namespace nfd
+
+#endif // NFD_DAEMON_FACE_LP_LOCATION_HPP
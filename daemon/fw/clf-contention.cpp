@@ -0,0 +1,155 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "clf-contention.hpp"
+
+namespace nfd {
+    namespace fw {
+        namespace clf {
+
+            std::ostream &
+            operator<<(std::ostream &os, ContentionMode mode) {
+                switch (mode) {
+                    case ContentionMode::FIXED:
+                        return os << "fixed";
+                    case ContentionMode::ADAPTIVE:
+                        return os << "adaptive";
+                }
+                return os << static_cast<int>(mode);
+            }
+
+            ContentionMode
+            parseContentionMode(const std::string &mode) {
+                if (mode == "fixed") {
+                    return ContentionMode::FIXED;
+                }
+                if (mode == "adaptive") {
+                    return ContentionMode::ADAPTIVE;
+                }
+                BOOST_THROW_EXCEPTION(std::invalid_argument("Unknown contention mode '" + mode + "'"));
+            }
+
+            constexpr double ContentionController::REFERENCE_DENSITY;
+            constexpr double ContentionController::DUPLICATE_WEIGHT;
+            constexpr double ContentionController::DUPLICATE_RATE_ALPHA;
+            constexpr double ContentionController::MIN_SCALE;
+            constexpr double ContentionController::MAX_SCALE;
+
+            ContentionController::ContentionController(const NeighborTable &neighbors, ContentionMode mode,
+                                                       const FaceTable *faceTable)
+                    : m_neighbors(neighbors)
+                    , m_mode(mode)
+                    , m_faceTable(faceTable) {
+            }
+
+            face::FaceCounters *
+            ContentionController::getFaceCounters(FaceId faceId) const {
+                Face *face = m_faceTable == nullptr ? nullptr : m_faceTable->get(faceId);
+                return face == nullptr ? nullptr : &face->getCounters();
+            }
+
+            double
+            ContentionController::getScale(FaceId faceId, time::steady_clock::TimePoint now) const {
+                if (m_mode == ContentionMode::FIXED) {
+                    return 1.0;
+                }
+
+                size_t nNeighbors = m_neighbors.countNeighbors(faceId, now);
+                double scale = std::max<size_t>(nNeighbors, 1) / REFERENCE_DENSITY;
+
+                auto it = m_faces.find(faceId);
+                if (it != m_faces.end()) {
+                    scale *= 1 + DUPLICATE_WEIGHT * it->second.duplicateRate;
+                }
+                return std::min(MAX_SCALE, std::max(MIN_SCALE, scale));
+            }
+
+            time::nanoseconds
+            ContentionController::computeDelay(FaceId faceId, time::nanoseconds baseDelay,
+                                               time::steady_clock::TimePoint now) {
+                ++m_faces[faceId].nDeferred;
+                if (auto faceCounters = getFaceCounters(faceId)) {
+                    ++faceCounters->nDeferredInterests;
+                }
+                if (m_mode == ContentionMode::FIXED) {
+                    return baseDelay;
+                }
+                return time::duration_cast<time::nanoseconds>(baseDelay * getScale(faceId, now));
+            }
+
+            void
+            ContentionController::recordInterest(FaceId faceId, bool isDuplicate) {
+                FaceCounters &counters = m_faces[faceId];
+                ++counters.nInterests;
+                if (isDuplicate) {
+                    ++counters.nDuplicates;
+                    if (auto faceCounters = getFaceCounters(faceId)) {
+                        ++faceCounters->nDuplicateInterests;
+                    }
+                }
+                counters.duplicateRate = DUPLICATE_RATE_ALPHA * (isDuplicate ? 1 : 0) +
+                                         (1 - DUPLICATE_RATE_ALPHA) * counters.duplicateRate;
+            }
+
+            void
+            ContentionController::recordSuppressed(FaceId faceId) {
+                ++m_faces[faceId].nSuppressed;
+                if (auto faceCounters = getFaceCounters(faceId)) {
+                    ++faceCounters->nSuppressedInterests;
+                }
+            }
+
+            void
+            ContentionController::recordRebroadcast(FaceId faceId, time::nanoseconds delay) {
+                FaceCounters &counters = m_faces[faceId];
+                ++counters.nRebroadcasts;
+                counters.addedLatency += delay;
+                if (auto faceCounters = getFaceCounters(faceId)) {
+                    ++faceCounters->nRebroadcastInterests;
+                }
+            }
+
+            void
+            ContentionController::recordRedundantRebroadcast(FaceId faceId) {
+                ++m_faces[faceId].nRedundantRebroadcasts;
+                if (auto faceCounters = getFaceCounters(faceId)) {
+                    ++faceCounters->nRedundantRebroadcasts;
+                }
+            }
+
+            const ContentionController::FaceCounters *
+            ContentionController::getCounters(FaceId faceId) const {
+                auto it = m_faces.find(faceId);
+                return it == m_faces.end() ? nullptr : &it->second;
+            }
+
+            void
+            ContentionController::eraseFace(FaceId faceId) {
+                m_faces.erase(faceId);
+            }
+
+        } // namespace clf
+    } // namespace fw
+} // namespace nfd
@@ -0,0 +1,148 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_FW_CLF_CONTENTION_HPP
+#define NFD_DAEMON_FW_CLF_CONTENTION_HPP
+
+#include "fw/clf-neighbor-table.hpp"
+#include "fw/face-table.hpp"
+#include "common/counter.hpp"
+
+namespace nfd {
+    namespace fw {
+        namespace clf {
+
+            /** \brief how the contention delay of a deferred rebroadcast is chosen
+             */
+            enum class ContentionMode {
+                /** \brief use the delay computed by the forwarding algorithm as is
+                 */
+                FIXED,
+                /** \brief scale the delay by the local density and the recent duplicate rate
+                 */
+                ADAPTIVE
+            };
+
+            std::ostream &
+            operator<<(std::ostream &os, ContentionMode mode);
+
+            /** \brief parse "fixed" or "adaptive"
+             *  \throw std::invalid_argument the mode is unknown
+             */
+            ContentionMode
+            parseContentionMode(const std::string &mode);
+
+            /** \brief chooses contention delays of deferred rebroadcasts on ad-hoc faces, and
+             *         counts how well broadcast suppression works on each face
+             *
+             *  In ADAPTIVE mode, the delay computed by the forwarding algorithm is multiplied by
+             *  (n / REFERENCE_DENSITY) * (1 + DUPLICATE_WEIGHT * d), clamped to [MIN_SCALE, MAX_SCALE],
+             *  where n is the number of live neighbors on the face and d is the smoothed fraction of
+             *  Interests received on the face that were duplicates. A dense neighborhood, or one where
+             *  suppression often fails, spreads the rebroadcasts over a wider window, while a sparse
+             *  one shortens the wait. Without any known neighbor, n is taken as 1, the sparsest
+             *  neighborhood, so that the scale never decreases as neighbors are learned.
+             *
+             *  The counters are kept per controller, and also added to the FaceCounters of the face,
+             *  where operators read them from the face dataset.
+             */
+            class ContentionController : noncopyable {
+            public:
+                struct FaceCounters {
+                    PacketCounter nInterests; ///< Interests received, duplicates included
+                    PacketCounter nDuplicates; ///< received Interests that were already deferred or sent
+                    PacketCounter nDeferred; ///< rebroadcasts deferred by a contention delay
+                    PacketCounter nSuppressed; ///< deferred rebroadcasts cancelled by overheard packets
+                    PacketCounter nRebroadcasts; ///< deferred rebroadcasts sent after their delay
+                    PacketCounter nRedundantRebroadcasts; ///< sent rebroadcasts that were also sent by a neighbor
+                    time::nanoseconds addedLatency = 0_ns; ///< total delay of sent rebroadcasts
+                    double duplicateRate = 0; ///< smoothed fraction of received Interests that were duplicates
+                };
+
+                /** \param faceTable the faces whose FaceCounters are updated, nullptr updates none
+                 */
+                ContentionController(const NeighborTable &neighbors, ContentionMode mode,
+                                     const FaceTable *faceTable = nullptr);
+
+                ContentionMode
+                getMode() const {
+                    return m_mode;
+                }
+
+                /** \return factor applied to the contention delays on \p faceId
+                 */
+                double
+                getScale(FaceId faceId, time::steady_clock::TimePoint now = time::steady_clock::now()) const;
+
+                /** \brief choose the delay of a rebroadcast on \p faceId, and count it as deferred
+                 *  \param baseDelay delay computed by the forwarding algorithm
+                 */
+                time::nanoseconds
+                computeDelay(FaceId faceId, time::nanoseconds baseDelay,
+                             time::steady_clock::TimePoint now = time::steady_clock::now());
+
+                void
+                recordInterest(FaceId faceId, bool isDuplicate);
+
+                void
+                recordSuppressed(FaceId faceId);
+
+                void
+                recordRebroadcast(FaceId faceId, time::nanoseconds delay);
+
+                void
+                recordRedundantRebroadcast(FaceId faceId);
+
+                /** \return counters of \p faceId, or nullptr if nothing was recorded on this face
+                 */
+                const FaceCounters *
+                getCounters(FaceId faceId) const;
+
+                void
+                eraseFace(FaceId faceId);
+
+            public:
+                static constexpr double REFERENCE_DENSITY = 4.0;
+                static constexpr double DUPLICATE_WEIGHT = 1.0;
+                static constexpr double DUPLICATE_RATE_ALPHA = 0.1;
+                static constexpr double MIN_SCALE = 0.1;
+                static constexpr double MAX_SCALE = 10.0;
+
+            private:
+                face::FaceCounters *
+                getFaceCounters(FaceId faceId) const;
+
+            private:
+                const NeighborTable &m_neighbors;
+                ContentionMode m_mode;
+                const FaceTable *m_faceTable;
+                std::unordered_map <FaceId, FaceCounters> m_faces;
+            };
+
+        } // namespace clf
+    } // namespace fw
+} // namespace nfd
+
+#endif // NFD_DAEMON_FW_CLF_CONTENTION_HPP
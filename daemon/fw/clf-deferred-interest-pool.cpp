@@ -0,0 +1,461 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "clf-deferred-interest-pool.hpp"
+#include "clf-logger.hpp"
+
+#include <algorithm>
+#include <tuple>
+
+namespace nfd {
+    namespace fw {
+        namespace clf {
+
+            NFD_LOG_INIT(ClfDeferredInterestPool);
+
+            constexpr DeferredInterestPool::NodeIndex DeferredInterestPool::INVALID_NODE;
+            constexpr time::nanoseconds DeferredInterestPool::DEFAULT_TICK_INTERVAL;
+            constexpr size_t DeferredInterestPool::DEFAULT_N_SLOTS;
+
+            static constexpr size_t INITIAL_N_BUCKETS = 64;
+
+            DeferredInterestPool::DeferredInterestPool(TimerBackend &timers, time::nanoseconds tickInterval,
+                                                       size_t nSlots)
+                    : m_timers(timers)
+                    , m_tickInterval(tickInterval)
+                    , m_slots(nSlots, INVALID_NODE)
+                    , m_occupiedSlots((nSlots + 63) / 64, 0)
+                    , m_buckets(INITIAL_N_BUCKETS, INVALID_NODE)
+                    , m_startTime(timers.now())
+            {
+                BOOST_ASSERT(m_tickInterval > time::nanoseconds::zero());
+                BOOST_ASSERT(nSlots > 0 && (nSlots & (nSlots - 1)) == 0); // power of two
+            }
+
+            DeferredInterestPool::~DeferredInterestPool() {
+                m_tickTimer.cancel();
+            }
+
+            void
+            DeferredInterestPool::schedule(const Name &name, name_tree::HashValue hash, time::nanoseconds delay,
+                                           Callback callback, BatchKey batchKey) {
+                BOOST_ASSERT(callback != nullptr);
+                Node &node = insertNode(name, hash, delay, batchKey);
+                node.name = name;
+                node.callback = std::move(callback);
+            }
+
+            void
+            DeferredInterestPool::schedule(const Name &name, name_tree::HashValue hash, time::nanoseconds delay,
+                                           const DeferredAction &action, BatchKey batchKey) {
+                BOOST_ASSERT(m_actionCallback != nullptr);
+                BOOST_ASSERT(!action.empty());
+                BOOST_ASSERT(action.hasName(name));
+                insertNode(name, hash, delay, batchKey).action = action;
+            }
+
+            DeferredInterestPool::Node &
+            DeferredInterestPool::insertNode(const Name &name, name_tree::HashValue hash, time::nanoseconds delay,
+                                             BatchKey batchKey) {
+                NodeIndex existing = findNode(name, hash);
+                if (existing != INVALID_NODE) {
+                    CLF_LOG_TRACE("replace " << name);
+                    releaseNode(existing);
+                }
+
+                uint64_t nTicks = 1;
+                if (delay > m_tickInterval) {
+                    nTicks = static_cast<uint64_t>((delay.count() + m_tickInterval.count() - 1) / m_tickInterval.count());
+                }
+
+                NodeIndex index = allocateNode();
+                Node &node = m_nodes[index];
+                node.hash = hash;
+                node.delay = delay;
+                node.batchKey = batchKey;
+                node.isPending = true;
+                // slots between m_currentTick and now are processed by the pending timer callback
+                uint64_t expiryTick = std::max(m_currentTick, computeCurrentTick()) + nTicks;
+                if (m_windowTicks > 1) {
+                    expiryTick = (expiryTick + m_windowTicks - 1) / m_windowTicks * m_windowTicks;
+                }
+                node.expiryTick = expiryTick;
+
+                insertIntoSlot(index);
+                insertIntoBucket(index);
+                ++m_size;
+                ++m_counters.nScheduled;
+
+                if (m_size > m_buckets.size()) {
+                    rehash(m_buckets.size() * 2);
+                }
+
+                // onTick arms the timer after firing
+                if (!m_isProcessing && (!m_isTicking || expiryTick < m_armedTick)) {
+                    m_tickTimer.cancel();
+                    armTimer(expiryTick);
+                }
+                return m_nodes[index];
+            }
+
+            bool
+            DeferredInterestPool::cancel(const Name &name, name_tree::HashValue hash) {
+                if (!erase(name, hash)) {
+                    return false;
+                }
+
+                ++m_counters.nCancelled;
+                return true;
+            }
+
+            bool
+            DeferredInterestPool::erase(const Name &name, name_tree::HashValue hash) {
+                NodeIndex index = findNode(name, hash);
+                if (index == INVALID_NODE) {
+                    return false;
+                }
+
+                releaseNode(index);
+
+                if (m_size == 0) {
+                    m_tickTimer.cancel();
+                    m_isTicking = false;
+                }
+                return true;
+            }
+
+            bool
+            DeferredInterestPool::contains(const Name &name, name_tree::HashValue hash) const {
+                return findNode(name, hash) != INVALID_NODE;
+            }
+
+            size_t
+            DeferredInterestPool::cancelBatch(BatchKey batchKey) {
+                size_t nCancelled = 0;
+                for (NodeIndex head : m_slots) {
+                    while (head != INVALID_NODE) {
+                        NodeIndex next = m_nodes[head].slotNext;
+                        if (m_nodes[head].batchKey == batchKey) {
+                            releaseNode(head);
+                            ++nCancelled;
+                        }
+                        head = next;
+                    }
+                }
+                m_counters.nCancelled += nCancelled;
+
+                if (m_size == 0) {
+                    m_tickTimer.cancel();
+                    m_isTicking = false;
+                }
+                return nCancelled;
+            }
+
+            void
+            DeferredInterestPool::clear() {
+                for (NodeIndex head : m_slots) {
+                    while (head != INVALID_NODE) {
+                        NodeIndex next = m_nodes[head].slotNext;
+                        releaseNode(head);
+                        ++m_counters.nCancelled;
+                        head = next;
+                    }
+                }
+
+                m_tickTimer.cancel();
+                m_isTicking = false;
+            }
+
+            void
+            DeferredInterestPool::setCoalescingWindow(time::nanoseconds window) {
+                BOOST_ASSERT(window >= time::nanoseconds::zero());
+                m_windowTicks = std::max<uint64_t>(1, static_cast<uint64_t>(
+                        (window.count() + m_tickInterval.count() - 1) / m_tickInterval.count()));
+            }
+
+            DeferredInterestPool::NodeIndex
+            DeferredInterestPool::findNode(const Name &name, name_tree::HashValue hash) const {
+                for (NodeIndex index = m_buckets[computeBucketIndex(hash)]; index != INVALID_NODE;
+                     index = m_nodes[index].hashNext) {
+                    const Node &node = m_nodes[index];
+                    if (node.hash == hash && hasName(node, name)) {
+                        return index;
+                    }
+                }
+                return INVALID_NODE;
+            }
+
+            bool
+            DeferredInterestPool::hasName(const Node &node, const Name &name) {
+                if (node.callback != nullptr) {
+                    return node.name == name;
+                }
+                return node.action.hasName(name);
+            }
+
+            DeferredInterestPool::NodeIndex
+            DeferredInterestPool::allocateNode() {
+                if (m_freeList != INVALID_NODE) {
+                    NodeIndex index = m_freeList;
+                    m_freeList = m_nodes[index].hashNext;
+                    m_nodes[index].hashNext = INVALID_NODE;
+                    return index;
+                }
+
+                BOOST_ASSERT(m_nodes.size() < INVALID_NODE);
+                m_nodes.emplace_back();
+                return static_cast<NodeIndex>(m_nodes.size() - 1);
+            }
+
+            void
+            DeferredInterestPool::releaseNode(NodeIndex index) {
+                if (!m_nodes[index].isExpiring) {
+                    removeFromSlot(index);
+                }
+                removeFromBucket(index);
+                --m_size;
+
+                Node &node = m_nodes[index];
+                node.callback = nullptr;
+                node.action.reset();
+                node.isPending = false;
+                if (!node.isExpiring) { // otherwise onTick returns it to the free list
+                    node.hashNext = m_freeList;
+                    m_freeList = index;
+                }
+            }
+
+            void
+            DeferredInterestPool::insertIntoSlot(NodeIndex index) {
+                Node &node = m_nodes[index];
+                NodeIndex &head = m_slots[node.expiryTick & (m_slots.size() - 1)];
+
+                node.slotPrev = INVALID_NODE;
+                node.slotNext = head;
+                if (head != INVALID_NODE) {
+                    m_nodes[head].slotPrev = index;
+                }
+                head = index;
+
+                size_t slot = node.expiryTick & (m_slots.size() - 1);
+                m_occupiedSlots[slot / 64] |= uint64_t(1) << (slot % 64);
+            }
+
+            void
+            DeferredInterestPool::removeFromSlot(NodeIndex index) {
+                Node &node = m_nodes[index];
+                if (node.slotPrev != INVALID_NODE) {
+                    m_nodes[node.slotPrev].slotNext = node.slotNext;
+                } else {
+                    size_t slot = node.expiryTick & (m_slots.size() - 1);
+                    m_slots[slot] = node.slotNext;
+                    if (node.slotNext == INVALID_NODE) {
+                        m_occupiedSlots[slot / 64] &= ~(uint64_t(1) << (slot % 64));
+                    }
+                }
+                if (node.slotNext != INVALID_NODE) {
+                    m_nodes[node.slotNext].slotPrev = node.slotPrev;
+                }
+                node.slotPrev = node.slotNext = INVALID_NODE;
+            }
+
+            void
+            DeferredInterestPool::insertIntoBucket(NodeIndex index) {
+                Node &node = m_nodes[index];
+                NodeIndex &head = m_buckets[computeBucketIndex(node.hash)];
+                node.hashNext = head;
+                head = index;
+            }
+
+            void
+            DeferredInterestPool::removeFromBucket(NodeIndex index) {
+                NodeIndex *link = &m_buckets[computeBucketIndex(m_nodes[index].hash)];
+                while (*link != index) {
+                    BOOST_ASSERT(*link != INVALID_NODE);
+                    link = &m_nodes[*link].hashNext;
+                }
+                *link = m_nodes[index].hashNext;
+                m_nodes[index].hashNext = INVALID_NODE;
+            }
+
+            void
+            DeferredInterestPool::rehash(size_t nBuckets) {
+                CLF_LOG_TRACE("rehash " << m_buckets.size() << " to " << nBuckets);
+                m_buckets.assign(nBuckets, INVALID_NODE);
+
+                // every pending node is in exactly one slot
+                for (NodeIndex head : m_slots) {
+                    for (NodeIndex index = head; index != INVALID_NODE; index = m_nodes[index].slotNext) {
+                        insertIntoBucket(index);
+                    }
+                }
+            }
+
+            uint64_t
+            DeferredInterestPool::computeCurrentTick() const {
+                auto elapsed = time::duration_cast<time::nanoseconds>(m_timers.now() - m_startTime);
+                if (elapsed <= time::nanoseconds::zero()) {
+                    return 0;
+                }
+                return static_cast<uint64_t>(elapsed.count() / m_tickInterval.count());
+            }
+
+            size_t
+            DeferredInterestPool::findOccupiedSlot(size_t slot) const {
+                // the word of slot is visited twice: first from slot on, last for the slots before it
+                size_t word = slot / 64;
+                uint64_t bits = m_occupiedSlots[word] & (~uint64_t(0) << (slot % 64));
+                for (size_t i = 0; i <= m_occupiedSlots.size(); ++i) {
+                    if (bits != 0) {
+                        return word * 64 + static_cast<size_t>(__builtin_ctzll(bits));
+                    }
+                    word = word + 1 == m_occupiedSlots.size() ? 0 : word + 1;
+                    bits = m_occupiedSlots[word];
+                }
+                return m_slots.size();
+            }
+
+            uint64_t
+            DeferredInterestPool::findNextTick() const {
+                BOOST_ASSERT(m_size > 0);
+
+                // a node due within one rotation is found in the slot of its expiry tick, and the
+                // non-empty slots are visited in tick order; if there is none, every node has been visited
+                const size_t mask = m_slots.size() - 1;
+                uint64_t nextTick = std::numeric_limits<uint64_t>::max();
+                uint64_t tick = m_currentTick + 1;
+                const uint64_t endTick = m_currentTick + m_slots.size();
+                while (tick <= endTick) {
+                    size_t slot = findOccupiedSlot(tick & mask);
+                    if (slot == m_slots.size()) {
+                        break;
+                    }
+                    tick += (slot - (tick & mask)) & mask;
+                    if (tick > endTick) {
+                        break;
+                    }
+
+                    for (NodeIndex index = m_slots[slot]; index != INVALID_NODE; index = m_nodes[index].slotNext) {
+                        if (m_nodes[index].expiryTick == tick) {
+                            return tick;
+                        }
+                        nextTick = std::min(nextTick, m_nodes[index].expiryTick);
+                    }
+                    ++tick;
+                }
+                return nextTick;
+            }
+
+            void
+            DeferredInterestPool::armTimer(uint64_t tick) {
+                time::nanoseconds delay = time::duration_cast<time::nanoseconds>(
+                        m_startTime + m_tickInterval * static_cast<int64_t>(tick) - m_timers.now());
+                m_armedTick = tick;
+                m_isTicking = true;
+                m_tickTimer = m_timers.schedule(std::max(delay, time::nanoseconds::zero()), [this] { onTick(); });
+            }
+
+            void
+            DeferredInterestPool::onTick() {
+                m_isTicking = false;
+                m_isProcessing = true;
+                uint64_t lastTick = m_currentTick;
+                m_currentTick = std::max(m_currentTick, computeCurrentTick());
+
+                // collect and unlink every node due in the slots passed since the last callback;
+                // nodes of later rounds stay in place
+                std::vector<NodeIndex> expired;
+                expired.swap(m_expired);
+                uint64_t endTick = std::min<uint64_t>(m_currentTick, lastTick + m_slots.size());
+                for (uint64_t tick = lastTick + 1; tick <= endTick; ++tick) {
+                    for (NodeIndex index = m_slots[tick & (m_slots.size() - 1)]; index != INVALID_NODE;
+                         index = m_nodes[index].slotNext) {
+                        if (m_nodes[index].expiryTick <= m_currentTick) {
+                            expired.push_back(index);
+                        }
+                    }
+                }
+                for (NodeIndex index : expired) {
+                    removeFromSlot(index);
+                    m_nodes[index].isExpiring = true;
+                }
+                std::stable_sort(expired.begin(), expired.end(), [this] (NodeIndex a, NodeIndex b) {
+                    return std::tie(m_nodes[a].expiryTick, m_nodes[a].batchKey) <
+                           std::tie(m_nodes[b].expiryTick, m_nodes[b].batchKey);
+                });
+
+                // a callback may cancel or replace another transmission being fired,
+                // which releases that node
+                bool isFirst = true;
+                uint64_t lastExpiryTick = 0;
+                BatchKey lastKey = 0;
+                for (NodeIndex index : expired) {
+                    if (!m_nodes[index].isPending) {
+                        continue;
+                    }
+                    removeFromBucket(index);
+                    --m_size;
+
+                    if (isFirst || m_nodes[index].expiryTick != lastExpiryTick ||
+                        m_nodes[index].batchKey != lastKey) {
+                        ++m_counters.nBatches;
+                        isFirst = false;
+                        lastExpiryTick = m_nodes[index].expiryTick;
+                        lastKey = m_nodes[index].batchKey;
+                    }
+
+                    Node &node = m_nodes[index];
+                    node.isPending = false;
+                    ++m_counters.nFired;
+                    if (node.callback != nullptr) {
+                        Callback callback = std::move(node.callback);
+                        node.callback = nullptr;
+                        callback();
+                    } else {
+                        // moving the weak references out leaves the node empty, without allocation;
+                        // the callback may grow m_nodes, so the node is not used afterwards
+                        DeferredAction action = std::move(node.action);
+                        node.action.reset();
+                        m_actionCallback(action, node.delay);
+                    }
+                }
+
+                for (NodeIndex index : expired) {
+                    m_nodes[index].isExpiring = false;
+                    m_nodes[index].hashNext = m_freeList;
+                    m_freeList = index;
+                }
+                expired.clear();
+                m_expired.swap(expired);
+
+                m_isProcessing = false;
+                if (m_size > 0) {
+                    armTimer(findNextTick());
+                }
+            }
+
+        } // namespace clf
+    } // namespace fw
+} // namespace nfd
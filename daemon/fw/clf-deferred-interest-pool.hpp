@@ -0,0 +1,292 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_FW_CLF_DEFERRED_INTEREST_POOL_HPP
+#define NFD_DAEMON_FW_CLF_DEFERRED_INTEREST_POOL_HPP
+
+#include "fw/clf-timer.hpp"
+#include "fw/deferred-action.hpp"
+#include "table/name-tree-hashtable.hpp"
+
+namespace nfd {
+    namespace fw {
+        namespace clf {
+
+            /** \brief a pool of deferred Interest transmissions, organized as a hashed timing wheel
+             *
+             *  Each pending transmission is keyed by the name tree hash of its Interest name, so that
+             *  schedule, find and cancel take O(1) time without hashing the name again. The name itself
+             *  is only compared to tell colliding hashes apart: an action is compared with the name of
+             *  the PIT entry it refers to, so the pool does not copy the names of actions, and a
+             *  callback keeps a copy of its name.
+             *  Expiry times are rounded up to a tick, and transmissions due in the same tick are fired
+             *  in bulk. The wheel is anchored to the time the pool is created and derives the current
+             *  tick from the clock of the TimerBackend, so a late timer callback fires everything that
+             *  became due since the previous callback, and lateness does not accumulate. The backend
+             *  timer is only armed for the next tick that has a transmission due, which is found
+             *  through a bitmap of the non-empty slots rather than by visiting every slot.
+             *
+             *  A transmission fires between (ticks - 1) and ticks tick intervals after it is scheduled,
+             *  where ticks = ceil(delay / tickInterval).
+             *
+             *  Transmissions due in the same tick fire grouped by their batch key (e.g. the outgoing
+             *  face). Optionally, expiry times are further rounded up to a coalescing window, so that
+             *  transmissions due in the same window go out as one burst of back-to-back sends per key.
+             *
+             *  A transmission is either a callback, or a DeferredAction passed to the pool's action
+             *  callback. Nodes are pooled and reused, and a DeferredAction is stored in its node
+             *  without allocation, so scheduling actions does not allocate once the pool has grown.
+             */
+            class DeferredInterestPool : noncopyable {
+            public:
+                typedef std::function<void()> Callback;
+                typedef std::function<void(const DeferredAction &action, time::nanoseconds delay)> ActionCallback;
+                typedef uint64_t BatchKey;
+
+                struct Counters {
+                    PacketCounter nScheduled;
+                    PacketCounter nCancelled;
+                    PacketCounter nFired;
+                    PacketCounter nBatches; ///< number of groups of transmissions fired together
+                };
+
+                explicit
+                DeferredInterestPool(TimerBackend &timers,
+                                     time::nanoseconds tickInterval = DEFAULT_TICK_INTERVAL,
+                                     size_t nSlots = DEFAULT_N_SLOTS);
+
+                ~DeferredInterestPool();
+
+                /** \brief schedule \p callback to be invoked after \p delay
+                 *
+                 *  If a transmission of \p name is already pending, it is replaced.
+                 *  \param batchKey transmissions due in the same tick fire grouped by this key
+                 */
+                void
+                schedule(const Name &name, name_tree::HashValue hash, time::nanoseconds delay,
+                         Callback callback, BatchKey batchKey = 0);
+
+                /** \brief schedule \p action to be passed to the action callback after \p delay
+                 *
+                 *  If a transmission of \p name is already pending, it is replaced.
+                 *  \pre an action callback is set
+                 */
+                void
+                schedule(const Name &name, name_tree::HashValue hash, time::nanoseconds delay,
+                         const DeferredAction &action, BatchKey batchKey = 0);
+
+                /** \brief set the callback that performs actions when they are due
+                 */
+                void
+                setActionCallback(ActionCallback callback) {
+                    m_actionCallback = std::move(callback);
+                }
+
+                /** \brief cancel the pending transmission of \p name
+                 *
+                 *  An action whose PIT entry has been erased is not found by name; it is discarded
+                 *  when it is due.
+                 *  \return whether a pending transmission was cancelled
+                 */
+                bool
+                cancel(const Name &name, name_tree::HashValue hash);
+
+                /** \brief remove the pending transmission of \p name without counting it as cancelled
+                 *
+                 *  This is used when the Interest has been sent through another path.
+                 */
+                bool
+                erase(const Name &name, name_tree::HashValue hash);
+
+                bool
+                contains(const Name &name, name_tree::HashValue hash) const;
+
+                /** \brief cancel the pending transmissions with \p batchKey, e.g. when their face is removed
+                 *  \return number of cancelled transmissions
+                 */
+                size_t
+                cancelBatch(BatchKey batchKey);
+
+                /** \brief cancel all pending transmissions
+                 */
+                void
+                clear();
+
+                size_t
+                size() const {
+                    return m_size;
+                }
+
+                bool
+                empty() const {
+                    return m_size == 0;
+                }
+
+                time::nanoseconds
+                getTickInterval() const {
+                    return m_tickInterval;
+                }
+
+                /** \brief round the expiry of transmissions scheduled from now on up to a multiple of
+                 *         \p window, zero disables coalescing
+                 *
+                 *  \p window is itself rounded up to a multiple of the tick interval.
+                 */
+                void
+                setCoalescingWindow(time::nanoseconds window);
+
+                /** \return the coalescing window, or zero if a window is not longer than one tick
+                 */
+                time::nanoseconds
+                getCoalescingWindow() const {
+                    if (m_windowTicks <= 1) {
+                        return time::nanoseconds::zero();
+                    }
+                    return m_tickInterval * static_cast<int64_t>(m_windowTicks);
+                }
+
+                const Counters &
+                getCounters() const {
+                    return m_counters;
+                }
+
+            private:
+                typedef uint32_t NodeIndex;
+                static constexpr NodeIndex INVALID_NODE = std::numeric_limits<NodeIndex>::max();
+
+                struct Node {
+                    Name name; ///< name of a callback; an action is named by its PIT entry
+                    name_tree::HashValue hash = 0;
+                    Callback callback; ///< empty if the transmission is an action
+                    DeferredAction action;
+                    time::nanoseconds delay;
+                    BatchKey batchKey = 0;
+                    uint64_t expiryTick = 0;
+                    NodeIndex slotPrev = INVALID_NODE;
+                    NodeIndex slotNext = INVALID_NODE;
+                    NodeIndex hashNext = INVALID_NODE; ///< next node in hash bucket, or in free list
+                    bool isExpiring = false; ///< node is due in the tick being processed
+                    bool isPending = false; ///< node holds a transmission that is neither fired nor cancelled
+                };
+
+                /** \brief insert a pending node of \p name, replacing an existing one, and arm the timer
+                 *         if the node is due before the tick it is armed for
+                 *  \return the node, whose callback or action the caller sets
+                 */
+                Node &
+                insertNode(const Name &name, name_tree::HashValue hash, time::nanoseconds delay, BatchKey batchKey);
+
+                NodeIndex
+                findNode(const Name &name, name_tree::HashValue hash) const;
+
+                /** \return whether \p node is a transmission of \p name
+                 */
+                static bool
+                hasName(const Node &node, const Name &name);
+
+                NodeIndex
+                allocateNode();
+
+                /** \brief unlink a node from its slot and hash bucket, and return it to the free list
+                 */
+                void
+                releaseNode(NodeIndex index);
+
+                void
+                insertIntoSlot(NodeIndex index);
+
+                void
+                removeFromSlot(NodeIndex index);
+
+                void
+                insertIntoBucket(NodeIndex index);
+
+                void
+                removeFromBucket(NodeIndex index);
+
+                void
+                rehash(size_t nBuckets);
+
+                size_t
+                computeBucketIndex(name_tree::HashValue hash) const {
+                    return hash & (m_buckets.size() - 1);
+                }
+
+                /** \return the tick that contains the current time of the TimerBackend
+                 */
+                uint64_t
+                computeCurrentTick() const;
+
+                /** \return the first non-empty slot at or after \p slot in the order of the wheel,
+                 *          or m_slots.size() if every slot is empty
+                 */
+                size_t
+                findOccupiedSlot(size_t slot) const;
+
+                /** \return the earliest expiry tick of the pending nodes
+                 *  \pre the pool is not empty
+                 */
+                uint64_t
+                findNextTick() const;
+
+                void
+                armTimer(uint64_t tick);
+
+                void
+                onTick();
+
+            public:
+                static constexpr time::nanoseconds DEFAULT_TICK_INTERVAL = 100_us;
+                static constexpr size_t DEFAULT_N_SLOTS = 1024;
+
+            private:
+                TimerBackend &m_timers;
+                ActionCallback m_actionCallback;
+                const time::nanoseconds m_tickInterval;
+                uint64_t m_windowTicks = 1; ///< expiry ticks are multiples of this
+
+                std::vector<Node> m_nodes;
+                NodeIndex m_freeList = INVALID_NODE;
+                std::vector<NodeIndex> m_slots;    ///< head of each slot's doubly linked list
+                std::vector<uint64_t> m_occupiedSlots; ///< one bit per slot, set if the slot is not empty
+                std::vector<NodeIndex> m_buckets;  ///< head of each hash bucket's singly linked list
+                std::vector<NodeIndex> m_expired;  ///< scratch space for bulk expiry
+                size_t m_size = 0;
+
+                const time::steady_clock::TimePoint m_startTime; ///< start of tick 0
+                uint64_t m_currentTick = 0; ///< last tick whose slot has been processed
+                uint64_t m_armedTick = 0; ///< tick the timer is armed for, valid if m_isTicking
+                TimerId m_tickTimer;
+                bool m_isTicking = false;
+                bool m_isProcessing = false; ///< onTick is firing transmissions
+
+                Counters m_counters;
+            };
+
+        } // namespace clf
+    } // namespace fw
+} // namespace nfd
+
+#endif // NFD_DAEMON_FW_CLF_DEFERRED_INTEREST_POOL_HPP
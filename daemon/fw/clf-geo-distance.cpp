@@ -0,0 +1,291 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "clf-geo-distance.hpp"
+
+#include <cmath>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace nfd {
+    namespace fw {
+        namespace clf {
+
+            namespace {
+
+                constexpr double DEG_TO_RAD = 3.14159265358979323846 / 180.0;
+
+                // the batched kernels process destinations in blocks of this many elements
+                constexpr size_t CHUNK_SIZE = 64;
+
+#if defined(__AVX__) || defined(__SSE2__)
+#define NFD_CLF_GEO_DISTANCE_SIMD
+#if defined(__AVX__)
+                using Vec = __m256d;
+                constexpr size_t N_LANES = 4;
+
+                inline Vec vload(const double *p) { return _mm256_loadu_pd(p); }
+                inline void vstore(double *p, Vec v) { _mm256_storeu_pd(p, v); }
+                inline Vec vset(double x) { return _mm256_set1_pd(x); }
+                inline Vec vadd(Vec a, Vec b) { return _mm256_add_pd(a, b); }
+                inline Vec vsub(Vec a, Vec b) { return _mm256_sub_pd(a, b); }
+                inline Vec vmul(Vec a, Vec b) { return _mm256_mul_pd(a, b); }
+                inline Vec vdiv(Vec a, Vec b) { return _mm256_div_pd(a, b); }
+                inline Vec vsqrt(Vec a) { return _mm256_sqrt_pd(a); }
+                inline Vec vmax(Vec a, Vec b) { return _mm256_max_pd(a, b); }
+                // a where mask > 0, otherwise 0
+                inline Vec vwherePositive(Vec mask, Vec a) {
+                    return _mm256_and_pd(_mm256_cmp_pd(mask, _mm256_setzero_pd(), _CMP_GT_OQ), a);
+                }
+#else
+                using Vec = __m128d;
+                constexpr size_t N_LANES = 2;
+
+                inline Vec vload(const double *p) { return _mm_loadu_pd(p); }
+                inline void vstore(double *p, Vec v) { _mm_storeu_pd(p, v); }
+                inline Vec vset(double x) { return _mm_set1_pd(x); }
+                inline Vec vadd(Vec a, Vec b) { return _mm_add_pd(a, b); }
+                inline Vec vsub(Vec a, Vec b) { return _mm_sub_pd(a, b); }
+                inline Vec vmul(Vec a, Vec b) { return _mm_mul_pd(a, b); }
+                inline Vec vdiv(Vec a, Vec b) { return _mm_div_pd(a, b); }
+                inline Vec vsqrt(Vec a) { return _mm_sqrt_pd(a); }
+                inline Vec vmax(Vec a, Vec b) { return _mm_max_pd(a, b); }
+                // a where mask > 0, otherwise 0
+                inline Vec vwherePositive(Vec mask, Vec a) {
+                    return _mm_and_pd(_mm_cmpgt_pd(mask, _mm_setzero_pd()), a);
+                }
+#endif
+#endif // defined(__AVX__) || defined(__SSE2__)
+
+                /** \brief a location with its cosine of latitude, shared by every destination of a batch
+                 */
+                struct Origin {
+                    explicit
+                    Origin(const ndn::Location &location)
+                            : latitude(location.getLatitude())
+                            , longitude(location.getLongitude())
+                            , cosLatitude(std::cos(location.getLatitude() * DEG_TO_RAD)) {
+                    }
+
+                    double latitude;
+                    double longitude;
+                    double cosLatitude;
+                };
+
+                void
+                computePlanar(const Origin &from, const double *lat, const double *lon, size_t n,
+                              double *out) {
+                    size_t i = 0;
+#ifdef NFD_CLF_GEO_DISTANCE_SIMD
+                    const Vec fromLat = vset(from.latitude);
+                    const Vec fromLon = vset(from.longitude);
+                    for (; i + N_LANES <= n; i += N_LANES) {
+                        Vec dLat = vsub(vload(lat + i), fromLat);
+                        Vec dLon = vsub(vload(lon + i), fromLon);
+                        vstore(out + i, vsqrt(vadd(vmul(dLat, dLat), vmul(dLon, dLon))));
+                    }
+#endif
+                    for (; i < n; ++i) {
+                        double dLat = lat[i] - from.latitude;
+                        double dLon = lon[i] - from.longitude;
+                        out[i] = std::sqrt(dLat * dLat + dLon * dLon);
+                    }
+                }
+
+                void
+                computeEquirectangular(const Origin &from, const double *lat, const double *lon,
+                                       const double *cosLat, size_t n, double *out) {
+                    size_t i = 0;
+#ifdef NFD_CLF_GEO_DISTANCE_SIMD
+                    const Vec fromLat = vset(from.latitude);
+                    const Vec fromLon = vset(from.longitude);
+                    const Vec fromCos = vset(from.cosLatitude);
+                    const Vec degToRad = vset(DEG_TO_RAD);
+                    const Vec half = vset(0.5);
+                    const Vec radius = vset(EARTH_RADIUS_KM);
+                    for (; i + N_LANES <= n; i += N_LANES) {
+                        Vec meanCos = vmul(vadd(vload(cosLat + i), fromCos), half);
+                        Vec x = vmul(vmul(vsub(vload(lon + i), fromLon), degToRad), meanCos);
+                        Vec y = vmul(vsub(vload(lat + i), fromLat), degToRad);
+                        vstore(out + i, vmul(radius, vsqrt(vadd(vmul(x, x), vmul(y, y)))));
+                    }
+#endif
+                    for (; i < n; ++i) {
+                        double meanCos = (cosLat[i] + from.cosLatitude) * 0.5;
+                        double x = (lon[i] - from.longitude) * DEG_TO_RAD * meanCos;
+                        double y = (lat[i] - from.latitude) * DEG_TO_RAD;
+                        out[i] = EARTH_RADIUS_KM * std::sqrt(x * x + y * y);
+                    }
+                }
+
+                void
+                computeHaversine(const Origin &from, const double *lat, const double *lon,
+                                 const double *cosLat, size_t n, double *out) {
+                    // sin and asin have no SSE/AVX instruction; the cached cosines still save two
+                    // of the five trigonometric calls of the pairwise formula
+                    for (size_t i = 0; i < n; ++i) {
+                        double u = std::sin((lat[i] - from.latitude) * DEG_TO_RAD / 2);
+                        double v = std::sin((lon[i] - from.longitude) * DEG_TO_RAD / 2);
+                        double h = std::min(1.0, u * u + from.cosLatitude * cosLat[i] * v * v);
+                        out[i] = 2.0 * EARTH_RADIUS_KM * std::asin(std::sqrt(h));
+                    }
+                }
+
+                void
+                computeDistancesRaw(DistanceMode mode, const Origin &from, const double *lat,
+                                    const double *lon, const double *cosLat, size_t n, double *out) {
+                    switch (mode) {
+                        case DistanceMode::PLANAR:
+                            computePlanar(from, lat, lon, n, out);
+                            break;
+                        case DistanceMode::EQUIRECTANGULAR:
+                            computeEquirectangular(from, lat, lon, cosLat, n, out);
+                            break;
+                        case DistanceMode::HAVERSINE:
+                            computeHaversine(from, lat, lon, cosLat, n, out);
+                            break;
+                    }
+                }
+
+                void
+                computeScores(const double *dMe, const double *dPrev, size_t n, double *scores) {
+                    size_t i = 0;
+#ifdef NFD_CLF_GEO_DISTANCE_SIMD
+                    const Vec one = vset(1.0);
+                    for (; i + N_LANES <= n; i += N_LANES) {
+                        Vec me = vload(dMe + i);
+                        Vec denom = vmax(me, vload(dPrev + i));
+                        vstore(scores + i, vwherePositive(denom, vsub(one, vdiv(me, denom))));
+                    }
+#endif
+                    for (; i < n; ++i) {
+                        double denom = std::max(dMe[i], dPrev[i]);
+                        scores[i] = denom > 0 ? 1 - dMe[i] / denom : 0;
+                    }
+                }
+
+            } // namespace
+
+            std::ostream &
+            operator<<(std::ostream &os, DistanceMode mode) {
+                switch (mode) {
+                    case DistanceMode::PLANAR:
+                        return os << "planar";
+                    case DistanceMode::EQUIRECTANGULAR:
+                        return os << "equirectangular";
+                    case DistanceMode::HAVERSINE:
+                        return os << "haversine";
+                }
+                return os << static_cast<int>(mode);
+            }
+
+            DistanceMode
+            parseDistanceMode(const std::string &mode) {
+                if (mode == "planar") {
+                    return DistanceMode::PLANAR;
+                }
+                if (mode == "equirectangular") {
+                    return DistanceMode::EQUIRECTANGULAR;
+                }
+                if (mode == "haversine") {
+                    return DistanceMode::HAVERSINE;
+                }
+                BOOST_THROW_EXCEPTION(std::invalid_argument("Unknown distance mode '" + mode + "'"));
+            }
+
+            void
+            LocationBatch::reserve(size_t n) {
+                m_latitudes.reserve(n);
+                m_longitudes.reserve(n);
+                m_cosLatitudes.reserve(n);
+            }
+
+            void
+            LocationBatch::clear() {
+                m_latitudes.clear();
+                m_longitudes.clear();
+                m_cosLatitudes.clear();
+            }
+
+            void
+            LocationBatch::push_back(const ndn::Location &location) {
+                m_latitudes.push_back(location.getLatitude());
+                m_longitudes.push_back(location.getLongitude());
+                m_cosLatitudes.push_back(std::cos(location.getLatitude() * DEG_TO_RAD));
+            }
+
+            double
+            computeDistance(DistanceMode mode, const ndn::Location &a, const ndn::Location &b) {
+                double lat = b.getLatitude();
+                double lon = b.getLongitude();
+                double cosLat = mode == DistanceMode::PLANAR ? 0 : std::cos(lat * DEG_TO_RAD);
+                double distance = 0;
+                computeDistancesRaw(mode, Origin(a), &lat, &lon, &cosLat, 1, &distance);
+                return distance;
+            }
+
+            void
+            computeDistances(DistanceMode mode, const ndn::Location &from, const LocationBatch &to,
+                             double *distances) {
+                computeDistancesRaw(mode, Origin(from), to.getLatitudes(), to.getLongitudes(),
+                                    to.getCosLatitudes(), to.size(), distances);
+            }
+
+            double
+            computeLocationScore(DistanceMode mode, const ndn::Location &prev, const ndn::Location &me,
+                                 const ndn::Location &dest) {
+                double dMe = computeDistance(mode, me, dest);
+                double dPrev = computeDistance(mode, prev, dest);
+                double score = 0;
+                computeScores(&dMe, &dPrev, 1, &score);
+                return score;
+            }
+
+            void
+            computeLocationScores(DistanceMode mode, const ndn::Location &prev, const ndn::Location &me,
+                                  const LocationBatch &dests, double *scores) {
+                Origin fromMe(me);
+                Origin fromPrev(prev);
+                double dMe[CHUNK_SIZE];
+                double dPrev[CHUNK_SIZE];
+
+                for (size_t begin = 0; begin < dests.size(); begin += CHUNK_SIZE) {
+                    size_t n = std::min(CHUNK_SIZE, dests.size() - begin);
+                    const double *lat = dests.getLatitudes() + begin;
+                    const double *lon = dests.getLongitudes() + begin;
+                    const double *cosLat = dests.getCosLatitudes() + begin;
+                    computeDistancesRaw(mode, fromMe, lat, lon, cosLat, n, dMe);
+                    computeDistancesRaw(mode, fromPrev, lat, lon, cosLat, n, dPrev);
+                    computeScores(dMe, dPrev, n, scores + begin);
+                }
+            }
+
+        } // namespace clf
+    } // namespace fw
+} // namespace nfd
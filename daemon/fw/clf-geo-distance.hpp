@@ -0,0 +1,158 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_FW_CLF_GEO_DISTANCE_HPP
+#define NFD_DAEMON_FW_CLF_GEO_DISTANCE_HPP
+
+#include "core/common.hpp"
+
+#include <ndn-cxx/lp/location-header.hpp>
+
+namespace nfd {
+    namespace fw {
+        namespace clf {
+
+            /** \brief how distances between locations are computed
+             */
+            enum class DistanceMode {
+                /** \brief Euclidean distance over (latitude, longitude), in coordinate units
+                 *
+                 *  This is how ClfStrategy has always scored locations, and how PrefixLocationTree
+                 *  indexes them. It is the cheapest mode and the default.
+                 */
+                PLANAR,
+                /** \brief equirectangular projection on a sphere, in kilometers
+                 *
+                 *  The cosine of the mean latitude is approximated by the mean of the cosines, so the
+                 *  batched kernel has no trigonometric call per destination. The error is well below
+                 *  one percent over the few kilometers covered by a vehicular network.
+                 */
+                EQUIRECTANGULAR,
+                /** \brief great-circle distance by the haversine formula, in kilometers
+                 */
+                HAVERSINE
+            };
+
+            std::ostream &
+            operator<<(std::ostream &os, DistanceMode mode);
+
+            /** \brief parse "planar", "equirectangular" or "haversine"
+             *  \throw std::invalid_argument the mode is unknown
+             */
+            DistanceMode
+            parseDistanceMode(const std::string &mode);
+
+            /** \brief a set of destinations stored as a structure of arrays, to be scored in one call
+             *
+             *  The cosine of each latitude is computed once when the destination is added, and
+             *  reused by every computation against the batch.
+             */
+            class LocationBatch {
+            public:
+                void
+                reserve(size_t n);
+
+                void
+                clear();
+
+                void
+                push_back(const ndn::Location &location);
+
+                size_t
+                size() const {
+                    return m_latitudes.size();
+                }
+
+                bool
+                empty() const {
+                    return m_latitudes.empty();
+                }
+
+                ndn::Location
+                operator[](size_t i) const {
+                    return ndn::Location(m_latitudes[i], m_longitudes[i]);
+                }
+
+                const double *
+                getLatitudes() const {
+                    return m_latitudes.data();
+                }
+
+                const double *
+                getLongitudes() const {
+                    return m_longitudes.data();
+                }
+
+                const double *
+                getCosLatitudes() const {
+                    return m_cosLatitudes.data();
+                }
+
+            private:
+                std::vector<double> m_latitudes;
+                std::vector<double> m_longitudes;
+                std::vector<double> m_cosLatitudes;
+            };
+
+            /** \brief compute the distance between \p a and \p b
+             */
+            double
+            computeDistance(DistanceMode mode, const ndn::Location &a, const ndn::Location &b);
+
+            /** \brief compute the distances from \p from to every destination in \p to
+             *  \param[out] distances array of at least to.size() elements
+             */
+            void
+            computeDistances(DistanceMode mode, const ndn::Location &from, const LocationBatch &to,
+                             double *distances);
+
+            /** \brief compute the location score of \p me for destination \p dest
+             *
+             *  The score is 1 - d(me, dest) / max(d(me, dest), d(prev, dest)): it is positive when
+             *  \p me is closer to \p dest than the previous hop \p prev, and zero otherwise,
+             *  including when both are at \p dest.
+             */
+            double
+            computeLocationScore(DistanceMode mode, const ndn::Location &prev, const ndn::Location &me,
+                                 const ndn::Location &dest);
+
+            /** \brief compute the location scores of one Interest's (\p prev, \p me) pair for every
+             *         destination in \p dests
+             *  \param[out] scores array of at least dests.size() elements
+             *  \sa computeLocationScore
+             */
+            void
+            computeLocationScores(DistanceMode mode, const ndn::Location &prev, const ndn::Location &me,
+                                  const LocationBatch &dests, double *scores);
+
+            /** \brief mean radius of the Earth, in kilometers
+             */
+            constexpr double EARTH_RADIUS_KM = 6371.0;
+
+        } // namespace clf
+    } // namespace fw
+} // namespace nfd
+
+#endif // NFD_DAEMON_FW_CLF_GEO_DISTANCE_HPP
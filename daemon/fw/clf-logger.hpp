@@ -0,0 +1,62 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_FW_CLF_LOGGER_HPP
+#define NFD_DAEMON_FW_CLF_LOGGER_HPP
+
+#include "core/common.hpp"
+#include "common/logger.hpp"
+
+#include <iostream>
+
+/** \file
+ *  \brief per-packet logging of the CLF strategy and its tables
+ *
+ *  CLF_LOG_TRACE and CLF_LOG_DEBUG are NFD_LOG_TRACE and NFD_LOG_DEBUG, unless NFD_WITHOUT_CLF_DEBUG_LOG
+ *  is defined, which NFD configured with --without-clf-debug-log does. Then they are compiled out: the
+ *  expression is still type-checked, so that the code does not rot, but no code is generated for it.
+ *  Logging stays enabled in builds that do not use the generated config header.
+ */
+
+#ifdef NFD_WITHOUT_CLF_DEBUG_LOG
+
+#define CLF_LOG_DISCARD(expression) \
+  do {                              \
+    if (false) {                    \
+      ::std::clog << expression;    \
+    }                               \
+  } while (false)
+
+#define CLF_LOG_TRACE(expression) CLF_LOG_DISCARD(expression)
+#define CLF_LOG_DEBUG(expression) CLF_LOG_DISCARD(expression)
+
+#else
+
+#define CLF_LOG_TRACE(expression) NFD_LOG_TRACE(expression)
+#define CLF_LOG_DEBUG(expression) NFD_LOG_DEBUG(expression)
+
+#endif // NFD_WITHOUT_CLF_DEBUG_LOG
+
+#endif // NFD_DAEMON_FW_CLF_LOGGER_HPP
@@ -0,0 +1,122 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "clf-neighbor-table.hpp"
+
+namespace nfd {
+    namespace fw {
+        namespace clf {
+
+            constexpr time::nanoseconds NeighborTable::DEFAULT_LIFETIME;
+            constexpr double NeighborTable::VELOCITY_ALPHA;
+
+            ndn::Location
+            NeighborTable::Entry::predictPosition(time::steady_clock::TimePoint now) const {
+                double elapsed = time::duration_cast<time::duration<double>>(now - lastHeard).count();
+                return ndn::Location(position.getLatitude() + latitudeSpeed * elapsed,
+                                     position.getLongitude() + longitudeSpeed * elapsed);
+            }
+
+            NeighborTable::NeighborTable(time::nanoseconds lifetime)
+                    : m_lifetime(lifetime)
+                    , m_nextCleanup(time::steady_clock::TimePoint::min()) {
+                BOOST_ASSERT(lifetime > time::nanoseconds::zero());
+            }
+
+            const NeighborTable::Entry &
+            NeighborTable::update(FaceId faceId, EndpointId endpointId, const ndn::Location &position,
+                                  time::steady_clock::TimePoint now) {
+                if (now >= m_nextCleanup) {
+                    removeExpired(now);
+                    m_nextCleanup = now + m_lifetime;
+                }
+
+                auto it = m_table.find({faceId, endpointId});
+                if (it == m_table.end()) {
+                    Entry entry;
+                    entry.faceId = faceId;
+                    entry.endpointId = endpointId;
+                    entry.position = position;
+                    entry.lastHeard = now;
+                    return m_table.emplace(std::make_pair(faceId, endpointId), entry).first->second;
+                }
+
+                Entry &entry = it->second;
+                double elapsed = time::duration_cast<time::duration<double>>(now - entry.lastHeard).count();
+                if (elapsed > 0) {
+                    double latitudeSpeed = (position.getLatitude() - entry.position.getLatitude()) / elapsed;
+                    double longitudeSpeed = (position.getLongitude() - entry.position.getLongitude()) / elapsed;
+                    entry.latitudeSpeed = VELOCITY_ALPHA * latitudeSpeed + (1 - VELOCITY_ALPHA) * entry.latitudeSpeed;
+                    entry.longitudeSpeed = VELOCITY_ALPHA * longitudeSpeed + (1 - VELOCITY_ALPHA) * entry.longitudeSpeed;
+                }
+                entry.position = position;
+                entry.lastHeard = now;
+                return entry;
+            }
+
+            const NeighborTable::Entry *
+            NeighborTable::find(FaceId faceId, EndpointId endpointId, time::steady_clock::TimePoint now) const {
+                auto it = m_table.find({faceId, endpointId});
+                if (it == m_table.end() || !isAlive(it->second, now)) {
+                    return nullptr;
+                }
+                return &it->second;
+            }
+
+            size_t
+            NeighborTable::countNeighbors(FaceId faceId, time::steady_clock::TimePoint now) const {
+                size_t count = 0;
+                for (auto it = m_table.lower_bound({faceId, 0});
+                     it != m_table.end() && it->first.first == faceId; ++it) {
+                    if (isAlive(it->second, now)) {
+                        ++count;
+                    }
+                }
+                return count;
+            }
+
+            void
+            NeighborTable::eraseFace(FaceId faceId) {
+                m_table.erase(m_table.lower_bound({faceId, 0}),
+                              m_table.lower_bound({faceId + 1, 0}));
+            }
+
+            size_t
+            NeighborTable::removeExpired(time::steady_clock::TimePoint now) {
+                size_t nRemoved = 0;
+                for (auto it = m_table.begin(); it != m_table.end();) {
+                    if (isAlive(it->second, now)) {
+                        ++it;
+                    } else {
+                        it = m_table.erase(it);
+                        ++nRemoved;
+                    }
+                }
+                return nRemoved;
+            }
+
+        } // namespace clf
+    } // namespace fw
+} // namespace nfd
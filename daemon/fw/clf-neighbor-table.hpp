@@ -0,0 +1,138 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_FW_CLF_NEIGHBOR_TABLE_HPP
+#define NFD_DAEMON_FW_CLF_NEIGHBOR_TABLE_HPP
+
+#include "fw/clf-geo-distance.hpp"
+#include "face/face-common.hpp"
+
+namespace nfd {
+    namespace fw {
+        namespace clf {
+
+            /** \brief positions of the vehicles heard on ad-hoc faces
+             *
+             *  Each neighbor is identified by the face and the EndpointId it was heard from. Its
+             *  position is taken from the Location header of every Interest and Data it sends, so the
+             *  table is kept up to date by overheard traffic alone. A velocity estimate is derived
+             *  from successive positions, and neighbors that are not heard for a lifetime age out.
+             */
+            class NeighborTable : noncopyable {
+            public:
+                struct Entry {
+                    FaceId faceId;
+                    EndpointId endpointId;
+                    ndn::Location position;
+                    double latitudeSpeed = 0; ///< latitude units per second
+                    double longitudeSpeed = 0; ///< longitude units per second
+                    time::steady_clock::TimePoint lastHeard;
+
+                    /** \brief extrapolate the position of the neighbor at \p now from its velocity
+                     */
+                    ndn::Location
+                    predictPosition(time::steady_clock::TimePoint now) const;
+                };
+
+                typedef std::map <std::pair<FaceId, EndpointId>, Entry> Table;
+                typedef Table::const_iterator const_iterator;
+
+                explicit
+                NeighborTable(time::nanoseconds lifetime = DEFAULT_LIFETIME);
+
+                /** \brief record that a packet carrying \p position was heard from a neighbor
+                 *
+                 *  Entries that have aged out are removed from time to time by this function.
+                 */
+                const Entry &
+                update(FaceId faceId, EndpointId endpointId, const ndn::Location &position,
+                       time::steady_clock::TimePoint now = time::steady_clock::now());
+
+                /** \return the neighbor, or nullptr if it is unknown or has aged out
+                 */
+                const Entry *
+                find(FaceId faceId, EndpointId endpointId,
+                     time::steady_clock::TimePoint now = time::steady_clock::now()) const;
+
+                /** \return number of neighbors heard on \p faceId within the lifetime
+                 */
+                size_t
+                countNeighbors(FaceId faceId, time::steady_clock::TimePoint now = time::steady_clock::now()) const;
+
+                /** \brief remove all neighbors heard on \p faceId
+                 */
+                void
+                eraseFace(FaceId faceId);
+
+                /** \brief remove neighbors that have aged out
+                 *  \return number of removed neighbors
+                 */
+                size_t
+                removeExpired(time::steady_clock::TimePoint now = time::steady_clock::now());
+
+                size_t
+                size() const {
+                    return m_table.size();
+                }
+
+                const_iterator
+                begin() const {
+                    return m_table.begin();
+                }
+
+                const_iterator
+                end() const {
+                    return m_table.end();
+                }
+
+                time::nanoseconds
+                getLifetime() const {
+                    return m_lifetime;
+                }
+
+            private:
+                bool
+                isAlive(const Entry &entry, time::steady_clock::TimePoint now) const {
+                    return now - entry.lastHeard <= m_lifetime;
+                }
+
+            public:
+                static constexpr time::nanoseconds DEFAULT_LIFETIME = 5_s;
+
+                /** \brief weight of the latest sample in the velocity estimate
+                 */
+                static constexpr double VELOCITY_ALPHA = 0.5;
+
+            private:
+                Table m_table;
+                time::nanoseconds m_lifetime;
+                time::steady_clock::TimePoint m_nextCleanup;
+            };
+
+        } // namespace clf
+    } // namespace fw
+} // namespace nfd
+
+#endif // NFD_DAEMON_FW_CLF_NEIGHBOR_TABLE_HPP
@@ -1,6 +1,9 @@
 #include "clf-prefix-location-tree.hpp"
 
-#include "core/logger.hpp"
+#include "clf-logger.hpp"
+
+#include <algorithm>
+#include <cmath>
 
 namespace nfd {
     namespace fw {
@@ -8,8 +11,50 @@ namespace nfd {
 
             NFD_LOG_INIT(PrefixLocationTree);
 
+            constexpr double PrefixLocationTree::DEFAULT_CELL_SIZE;
+
+            constexpr size_t PrefixLocationEntry::MAX_REPLICAS;
+
             PrefixLocationEntry::PrefixLocationEntry(Name prefix, ndn::Location dl)
-                    : m_name(prefix), m_destLocation(dl) {
+                    : m_name(prefix) {
+                setLocation(dl);
+            }
+
+            PrefixLocationEntry::PrefixLocationEntry() = default;
+
+            void
+            PrefixLocationEntry::setLocation(const ndn::Location &destLocation,
+                                             time::steady_clock::TimePoint now) {
+                m_replicas.clear();
+                m_replicas.push_back(Replica{destLocation, now});
+            }
+
+            const ndn::Location &
+            PrefixLocationEntry::getLocation() const {
+                static const ndn::Location NO_LOCATION(0, 0);
+                return m_replicas.empty() ? NO_LOCATION : m_replicas.front().location;
+            }
+
+            void
+            PrefixLocationEntry::addReplica(const ndn::Location &location, double mergeDistance,
+                                            time::steady_clock::TimePoint now) {
+                auto it = std::find_if(m_replicas.begin(), m_replicas.end(), [&] (const Replica &replica) {
+                    return std::hypot(replica.location.getLatitude() - location.getLatitude(),
+                                      replica.location.getLongitude() - location.getLongitude()) <= mergeDistance;
+                });
+
+                if (it == m_replicas.end()) {
+                    if (m_replicas.size() == MAX_REPLICAS) {
+                        // replicas are ranked by recency, the last one is the least recently seen
+                        m_replicas.pop_back();
+                    }
+                    m_replicas.insert(m_replicas.begin(), Replica{location, now});
+                    return;
+                }
+
+                // move the refreshed replica to the front
+                std::rotate(m_replicas.begin(), it, it + 1);
+                m_replicas.front() = Replica{location, now};
             }
 
             void
@@ -26,106 +71,373 @@ namespace nfd {
                 m_children.remove(child);
             }
 
-            PrefixLocationTree::PrefixLocationTree()
-                    : m_nItems(0) {
+            constexpr size_t PrefixLocationTree::DEFAULT_MAX_ENTRIES;
+            constexpr time::nanoseconds PrefixLocationTree::DEFAULT_LIFETIME;
+            constexpr double PrefixLocationTree::REPLICA_MERGE_DISTANCE;
+
+            PrefixLocationTree::PrefixLocationTree(double cellSize, size_t maxEntries, time::nanoseconds lifetime)
+                    : m_cellSize(cellSize), m_nItems(0)
+                    , m_maxEntries(maxEntries), m_lifetime(lifetime), m_memoryUsage(0) {
+                BOOST_ASSERT(m_cellSize > 0);
+                if (m_maxEntries == 0) {
+                    BOOST_THROW_EXCEPTION(std::invalid_argument("maxEntries must be positive"));
+                }
             }
 
             PrefixLocationTree::const_iterator
             PrefixLocationTree::find(const Name &prefix) const {
-                NFD_LOG_DEBUG("Lookup " << prefix << " in PrefixLocationTable");
+                CLF_LOG_DEBUG("Lookup " << prefix << " in PrefixLocationTable");
                 return m_prefixLocationTable.find(prefix);
             }
 
             shared_ptr <PrefixLocationEntry>
-            PrefixLocationTree::findLongestPrefix(const Name &prefix) const {
-                PrefixLocationTree::const_iterator entryIt = find(prefix);
+            PrefixLocationTree::findLongestPrefix(const Name &name) const {
+                for (size_t prefixLen = name.size() + 1; prefixLen > 0; --prefixLen) {
+                    auto entryIt = m_prefixLocationTable.find(NamePrefixRef{name, prefixLen - 1});
+                    if (entryIt != m_prefixLocationTable.end()) {
+                        return entryIt->second;
+                    }
+                }
+
+                return nullptr;
+            }
+
+            shared_ptr <PrefixLocationEntry>
+            PrefixLocationTree::findParent(const Name &prefix) const {
+                for (size_t prefixLen = prefix.size(); prefixLen > 0; --prefixLen) {
+                    auto entryIt = m_prefixLocationTable.find(NamePrefixRef{prefix, prefixLen - 1});
+                    if (entryIt != m_prefixLocationTable.end()) {
+                        return entryIt->second;
+                    }
+                }
+
+                return nullptr;
+            }
+
+            PrefixLocationTree::EntryList
+            PrefixLocationTree::findDescendants(const Name &prefix) const {
+                // descendants of a name immediately follow it in canonical order
+                EntryList descendants;
+                for (auto it = m_prefixLocationTable.upper_bound(prefix);
+                     it != m_prefixLocationTable.end() && prefix.isPrefixOf(it->first); ++it) {
+                    descendants.push_back(it->second);
+                }
+
+                return descendants;
+            }
+
+            PrefixLocationTree::EntryList
+            PrefixLocationTree::findDescendantsForNonInsertedName(const Name &prefix) const {
+                EntryList descendants;
+                for (auto it = m_prefixLocationTable.lower_bound(prefix);
+                     it != m_prefixLocationTable.end() && prefix.isPrefixOf(it->first); ++it) {
+                    descendants.push_back(it->second);
+                }
+
+                return descendants;
+            }
+
+            shared_ptr <PrefixLocationEntry>
+            PrefixLocationTree::insert(const Name &prefix, const ndn::Location &location,
+                                       time::steady_clock::TimePoint now) {
+                auto prefixLocationIt = m_prefixLocationTable.find(prefix);
+
+                if (prefixLocationIt == m_prefixLocationTable.end()) {
+                    auto entry = make_shared<PrefixLocationEntry>(prefix, location);
+                    insert(prefix, entry, now);
+                    return entry;
+                }
+
+                // Name prefix exists, move it to the new DestLocation
+                shared_ptr <PrefixLocationEntry> entry = prefixLocationIt->second;
+                CLF_LOG_DEBUG("Update " << prefix << " in PrefixLocationTable");
+                removeFromGrid(entry);
+                entry->setLocation(location, now);
+                addToGrid(entry);
+                touch(*entry, now);
+                return entry;
+            }
+
+            shared_ptr <PrefixLocationEntry>
+            PrefixLocationTree::addReplica(const Name &prefix, const ndn::Location &location,
+                                           time::steady_clock::TimePoint now) {
+                auto prefixLocationIt = m_prefixLocationTable.find(prefix);
+                if (prefixLocationIt == m_prefixLocationTable.end()) {
+                    return insert(prefix, location, now);
+                }
 
-                return entryIt->second;
+                shared_ptr <PrefixLocationEntry> entry = prefixLocationIt->second;
+                CLF_LOG_DEBUG("Add replica of " << prefix << " to PrefixLocationTable");
+                removeFromGrid(entry);
+                entry->addReplica(location, REPLICA_MERGE_DISTANCE, now);
+                addToGrid(entry);
+                touch(*entry, now);
+                return entry;
             }
 
             void
-            PrefixLocationTree::insert(const Name &prefix, shared_ptr <PrefixLocationEntry> entry) {
+            PrefixLocationTree::insert(const Name &prefix, shared_ptr <PrefixLocationEntry> entry,
+                                       time::steady_clock::TimePoint now) {
+                BOOST_ASSERT(entry != nullptr);
                 auto prefixLocationIt = m_prefixLocationTable.find(prefix);
 
-                NFD_LOG_DEBUG("Insert " << prefix << " to PrefixLocationTable");
+                if (prefixLocationIt != m_prefixLocationTable.end()) {
+                    // Name prefix exists, keep the existing entry and its position in the tree
+                    insert(prefix, entry->getLocation(), now);
+                    return;
+                }
+
+                CLF_LOG_DEBUG("Insert " << prefix << " to PrefixLocationTable");
 
+                entry->setName(prefix);
                 m_prefixLocationTable[prefix] = entry;
-                // Name prefix exist, not sure what needs to be done. Right now just updating it with the new DestLocation
-                if (prefixLocationIt != m_prefixLocationTable.end()) {
-                    /*shared_ptr<PrefixLocationEntry> entry(prefixLocationIt->second);
-                    m_prefixLocationTable[prefix] = entry;*/
-                } else { // just increase the count for now, if it is new
-                    m_nItems++;
-                    // New name prefix
-                    /*auto entry = make_shared<PrefixLocationTreeEntry>();
+                m_nItems++;
+                m_memoryUsage += computeEntrySize(prefix);
 
-                    m_prefixLocationTable[prefix] = entry;
-                    m_nItems++;
+                attach(entry);
+                addToGrid(entry);
 
-                    entry->setName(prefix);
-                    auto routeIt = entry->insertRoute(route).first;
+                entry->m_lruIt = m_lru.insert(m_lru.begin(), entry.get());
+                entry->m_lastUsed = now;
+                evict(now);
+            }
 
-                    // Find prefix's parent
-                    shared_ptr<PrefixLocationTreeEntry> parent = findParent(prefix);
+            void
+            PrefixLocationTree::touch(PrefixLocationEntry &entry, time::steady_clock::TimePoint now) {
+                BOOST_ASSERT(m_prefixLocationTable.count(entry.getName()) > 0);
+                m_lru.splice(m_lru.begin(), m_lru, entry.m_lruIt);
+                entry.m_lastUsed = now;
+                evict(now);
+            }
 
-                    // Add self to parent's children
-                    if (parent != nullptr) {
-                      parent->addChild(entry);
+            size_t
+            PrefixLocationTree::evict(time::steady_clock::TimePoint now) {
+                size_t nErased = 0;
+                while (!m_lru.empty()) {
+                    PrefixLocationEntry *entry = m_lru.back();
+                    if (m_lru.size() <= m_maxEntries && entry->m_lastUsed + m_lifetime > now) {
+                        break;
                     }
 
-                    PrefixLocationTreeEntryList children = findDescendants(prefix);
+                    CLF_LOG_DEBUG("Evict " << entry->getName() << " from PrefixLocationTable");
+                    erase(entry->getName());
+                    ++nErased;
+                }
+                return nErased;
+            }
+
+            void
+            PrefixLocationTree::erase(const Name &prefix) {
+                auto prefixLocationIt = m_prefixLocationTable.find(prefix);
+                if (prefixLocationIt == m_prefixLocationTable.end()) {
+                    return;
+                }
+
+                CLF_LOG_DEBUG("Erase " << prefix << " from PrefixLocationTable");
+
+                shared_ptr <PrefixLocationEntry> entry = prefixLocationIt->second;
+                removeFromGrid(entry);
+                detach(entry);
+                m_lru.erase(entry->m_lruIt);
 
-                    for (const auto& child : children) {
-                      if (child->getParent() == parent) {
+                m_prefixLocationTable.erase(prefixLocationIt);
+                m_nItems--;
+                m_memoryUsage -= computeEntrySize(prefix);
+            }
+
+            void
+            PrefixLocationTree::attach(const shared_ptr <PrefixLocationEntry> &entry) {
+                // Find prefix's parent
+                shared_ptr <PrefixLocationEntry> parent = findParent(entry->getName());
+
+                // Add self to parent's children
+                if (parent != nullptr) {
+                    parent->addChild(entry);
+                }
+
+                for (const auto &child : findDescendants(entry->getName())) {
+                    if (child->getParent() == parent) {
                         // Remove child from parent and inherit parent's child
                         if (parent != nullptr) {
-                          parent->removeChild(child);
+                            parent->removeChild(child);
                         }
 
                         entry->addChild(child);
-                      }
                     }
+                }
+            }
+
+            void
+            PrefixLocationTree::detach(const shared_ptr <PrefixLocationEntry> &entry) {
+                shared_ptr <PrefixLocationEntry> parent = entry->getParent();
+                if (parent != nullptr) {
+                    parent->removeChild(entry);
+                }
+
+                // copy, because removeChild modifies the list
+                EntryList children = entry->getChildren();
+                for (const auto &child : children) {
+                    entry->removeChild(child);
+                    if (parent != nullptr) {
+                        parent->addChild(child);
+                    }
+                }
+            }
+
+            int32_t
+            PrefixLocationTree::computeCellIndex(double coordinate) const {
+                double index = std::floor(coordinate / m_cellSize);
+                index = std::max(index, static_cast<double>(std::numeric_limits<int32_t>::min()));
+                index = std::min(index, static_cast<double>(std::numeric_limits<int32_t>::max()));
+                return static_cast<int32_t>(index);
+            }
 
-                    // Register with face lookup table
-                    m_faceMap[route.faceId].push_back(entry);
+            PrefixLocationTree::CellKey
+            PrefixLocationTree::makeCellKey(int32_t x, int32_t y) {
+                return (static_cast<CellKey>(static_cast<uint32_t>(x)) << 32) | static_cast<uint32_t>(y);
+            }
 
-                    // do something after inserting an entry
-                    afterInsertEntry(prefix);
-                    afterAddRoute(PrefixLocationTreeRouteRef{entry, routeIt});
-                */  }
+            PrefixLocationTree::CellKey
+            PrefixLocationTree::computeCellKey(const ndn::Location &location) const {
+                return makeCellKey(computeCellIndex(location.getLatitude()),
+                                   computeCellIndex(location.getLongitude()));
             }
 
-/*
-void
-PrefixLocationTree::erase(const Name& prefix, const Route& route)
-{
-  auto prefixLocationIt = m_prefixLocationTable.find(prefix);
+            void
+            PrefixLocationTree::addToGrid(const shared_ptr <PrefixLocationEntry> &entry) {
+                BOOST_ASSERT(entry->m_cellKeys.empty());
+                const auto &replicas = entry->getReplicas();
+                for (size_t i = 0; i < replicas.size(); ++i) {
+                    CellKey key = computeCellKey(replicas[i].location);
+                    entry->m_cellKeys.push_back(key);
+                    m_grid[key].push_back({entry, i});
+                }
 
-  // Name prefix exists
-  if (prefixLocationIt != m_prefixLocationTable.end()) {
-    shared_ptr<PrefixLocationTreeEntry> entry = prefixLocationIt->second;
-    auto routeIt = entry->findRoute(route);
+                // computeEntrySize accounts for the grid slot of one replica
+                if (replicas.size() > 1) {
+                    m_memoryUsage += (replicas.size() - 1) * sizeof(GridItem);
+                }
+            }
 
-    if (routeIt != entry->end()) {
-      beforeRemoveRoute(PrefixLocationTreeRouteRef{entry, routeIt});
+            void
+            PrefixLocationTree::removeFromGrid(const shared_ptr <PrefixLocationEntry> &entry) {
+                if (entry->m_cellKeys.size() > 1) {
+                    m_memoryUsage -= (entry->m_cellKeys.size() - 1) * sizeof(GridItem);
+                }
 
-      auto faceId = route.faceId;
-      entry->eraseRoute(routeIt);
-      m_nItems--;
+                for (CellKey key : entry->m_cellKeys) {
+                    // several replicas may share a cell, all of them are removed at the first visit
+                    auto cellIt = m_grid.find(key);
+                    if (cellIt == m_grid.end()) {
+                        continue;
+                    }
 
-      // If this PrefixLocationTreeEntry no longer has this faceId, unregister from face lookup table
-      if (!entry->hasFaceId(faceId)) {
-        m_faceMap[faceId].remove(entry);
-      }
+                    auto &cell = cellIt->second;
+                    cell.erase(std::remove_if(cell.begin(), cell.end(),
+                                              [&] (const GridItem &item) { return item.entry == entry; }),
+                               cell.end());
+
+                    if (cell.empty()) {
+                        m_grid.erase(cellIt);
+                    }
+                }
+                entry->m_cellKeys.clear();
+            }
+
+            template<typename F>
+            void
+            PrefixLocationTree::visitRing(int32_t cx, int32_t cy, int64_t ring, const F &func) const {
+                auto visitCell = [&] (int64_t x, int64_t y) {
+                    if (x < std::numeric_limits<int32_t>::min() || x > std::numeric_limits<int32_t>::max() ||
+                        y < std::numeric_limits<int32_t>::min() || y > std::numeric_limits<int32_t>::max()) {
+                        return;
+                    }
+                    auto cellIt = m_grid.find(makeCellKey(static_cast<int32_t>(x), static_cast<int32_t>(y)));
+                    if (cellIt != m_grid.end()) {
+                        for (const auto &item : cellIt->second) {
+                            func(item);
+                        }
+                    }
+                };
+
+                if (ring == 0) {
+                    visitCell(cx, cy);
+                    return;
+                }
+
+                // top and bottom rows, then left and right columns without the corners
+                for (int64_t x = cx - ring; x <= cx + ring; ++x) {
+                    visitCell(x, cy - ring);
+                    visitCell(x, cy + ring);
+                }
+                for (int64_t y = cy - ring + 1; y <= cy + ring - 1; ++y) {
+                    visitCell(cx - ring, y);
+                    visitCell(cx + ring, y);
+                }
+            }
+
+            shared_ptr <PrefixLocationEntry>
+            PrefixLocationTree::findNearest(const Name &name, const ndn::Location &location,
+                                            double maxDistance) const {
+                shared_ptr <PrefixLocationEntry> nearest;
+                double nearestDistance = maxDistance;
+
+                auto consider = [&] (const GridItem &item) {
+                    if (!item.entry->getName().isPrefixOf(name)) {
+                        return;
+                    }
+                    double distance = computeDistance(location, item.getLocation());
+                    if (distance <= nearestDistance) {
+                        nearest = item.entry;
+                        nearestDistance = distance;
+                    }
+                };
+
+                int32_t cx = computeCellIndex(location.getLatitude());
+                int32_t cy = computeCellIndex(location.getLongitude());
+
+                for (int64_t ring = 0; ; ++ring) {
+                    // every entry in ring r is at least (r - 1) * cellSize away
+                    double ringDistance = (ring - 1) * m_cellSize;
+                    if (ringDistance > nearestDistance) {
+                        break;
+                    }
+
+                    // once a ring holds more cells than are occupied, scanning the occupied cells is cheaper
+                    if (ring > 0 && 8 * static_cast<size_t>(ring) > m_grid.size()) {
+                        for (const auto &cell : m_grid) {
+                            int64_t x = static_cast<int32_t>(cell.first >> 32);
+                            int64_t y = static_cast<int32_t>(cell.first & 0xFFFFFFFF);
+                            if (std::max(std::abs(x - cx), std::abs(y - cy)) >= ring) {
+                                for (const auto &item : cell.second) {
+                                    consider(item);
+                                }
+                            }
+                        }
+                        break;
+                    }
+
+                    visitRing(cx, cy, ring, consider);
+                }
+
+                return nearest;
+            }
+
+            size_t
+            PrefixLocationTree::computeEntrySize(const Name &prefix) {
+                // the entry and its control block, a table node holding a copy of the name, the grid slot
+                // of one replica and an LRU node; each of the two names owns its encoding
+                return sizeof(PrefixLocationEntry) + 2 * sizeof(void *) +
+                       sizeof(PrefixLocationTable::value_type) + 4 * sizeof(void *) +
+                       sizeof(GridItem) + 3 * sizeof(void *) +
+                       2 * prefix.wireEncode().size();
+            }
+
+            double
+            PrefixLocationTree::computeDistance(const ndn::Location &a, const ndn::Location &b) {
+                return std::hypot(a.getLatitude() - b.getLatitude(), a.getLongitude() - b.getLongitude());
+            }
 
-      // If a PrefixLocationTreeEntry's route list is empty, remove it from the tree
-      if (entry->getRoutes().empty()) {
-        eraseEntry(prefixLocationIt);
-      }
-    }
-  }
-}
-*/
         }
     }
-}
\ No newline at end of file
+}
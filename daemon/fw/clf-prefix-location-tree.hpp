@@ -31,14 +31,29 @@
 
 //#include <ndn-cxx/location.hpp>
 
+#include <boost/container/static_vector.hpp>
+
 #include <list>
 
 namespace nfd {
     namespace fw {
         namespace clf {
 
+            /** \brief locations of the replicas of an announced prefix
+             *
+             *  Up to MAX_REPLICAS producer or cache locations are kept, ranked by the time they were
+             *  last seen, the most recent first.
+             */
             class PrefixLocationEntry : public std::enable_shared_from_this<PrefixLocationEntry> {
             public:
+                struct Replica {
+                    ndn::Location location;
+                    time::steady_clock::TimePoint lastSeen;
+                };
+
+                static constexpr size_t MAX_REPLICAS = 4;
+                typedef boost::container::static_vector<Replica, MAX_REPLICAS> ReplicaList;
+
                 PrefixLocationEntry(Name, ndn::Location);
 
                 PrefixLocationEntry();
@@ -49,12 +64,39 @@ namespace nfd {
                 const Name &
                 getName() const;
 
-                inline void
-                setLocation(const ndn::Location &destLocation);
+                /** \brief replace all replicas by one at \p destLocation
+                 *  \warning if the entry is inserted in a PrefixLocationTree, use
+                 *           PrefixLocationTree::insert instead, so that the spatial index is updated
+                 */
+                void
+                setLocation(const ndn::Location &destLocation,
+                            time::steady_clock::TimePoint now = time::steady_clock::now());
 
-                inline const ndn::Location &
+                /** \return location of the most recently seen replica, or (0, 0) if there is none
+                 */
+                const ndn::Location &
                 getLocation() const;
 
+                const ReplicaList &
+                getReplicas() const;
+
+                /** \return time at which the entry was last inserted or touched in a PrefixLocationTree
+                 */
+                time::steady_clock::TimePoint
+                getLastUsed() const {
+                    return m_lastUsed;
+                }
+
+                /** \brief add a replica at \p location, or refresh the replica within \p mergeDistance of it
+                 *
+                 *  If all MAX_REPLICAS are in use, the least recently seen replica is replaced.
+                 *  \warning if the entry is inserted in a PrefixLocationTree, use
+                 *           PrefixLocationTree::addReplica instead, so that the spatial index is updated
+                 */
+                void
+                addReplica(const ndn::Location &location, double mergeDistance,
+                           time::steady_clock::TimePoint now = time::steady_clock::now());
+
                 shared_ptr <PrefixLocationEntry>
                 getParent() const;
 
@@ -84,9 +126,14 @@ namespace nfd {
             private:
                 Name m_name;
                 std::list <shared_ptr<PrefixLocationEntry>> m_children;
-                shared_ptr <PrefixLocationEntry> m_parent;
+                weak_ptr <PrefixLocationEntry> m_parent;
+
+                ReplicaList m_replicas;
+                boost::container::static_vector<uint64_t, MAX_REPLICAS> m_cellKeys; // grid cell of each replica
+                time::steady_clock::TimePoint m_lastUsed; // last insertion or touch
+                std::list<PrefixLocationEntry *>::iterator m_lruIt; // position in the LRU list of the tree
 
-                ndn::Location m_destLocation;
+                friend class PrefixLocationTree;
             };
 
             inline void
@@ -99,14 +146,9 @@ namespace nfd {
                 return m_name;
             }
 
-            inline void
-            PrefixLocationEntry::setLocation(const ndn::Location &destLocation) {
-                m_destLocation = destLocation;
-            }
-
-            inline const ndn::Location &
-            PrefixLocationEntry::getLocation() const {
-                return m_destLocation;
+            inline const PrefixLocationEntry::ReplicaList &
+            PrefixLocationEntry::getReplicas() const {
+                return m_replicas;
             }
 
             inline void
@@ -116,7 +158,12 @@ namespace nfd {
 
             inline shared_ptr <PrefixLocationEntry>
             PrefixLocationEntry::getParent() const {
-                return m_parent;
+                return m_parent.lock();
+            }
+
+            inline bool
+            PrefixLocationEntry::hasParent() const {
+                return !m_parent.expired();
             }
 
             inline const std::list <shared_ptr<PrefixLocationEntry>> &
@@ -124,18 +171,89 @@ namespace nfd {
                 return m_children;
             }
 
+            inline bool
+            PrefixLocationEntry::hasChildren() const {
+                return !m_children.empty();
+            }
+
+            /** \brief the first \p length components of \p name, looked up without being copied
+             */
+            struct NamePrefixRef {
+                const Name &name;
+                size_t length;
+            };
+
+            /** \brief orders names canonically, and compares them with NamePrefixRef
+             */
+            struct NamePrefixLess {
+                using is_transparent = void;
+
+                bool
+                operator()(const Name &a, const Name &b) const {
+                    return a < b;
+                }
+
+                bool
+                operator()(const Name &a, const NamePrefixRef &b) const {
+                    return a.compare(0, Name::npos, b.name, 0, b.length) < 0;
+                }
+
+                bool
+                operator()(const NamePrefixRef &a, const Name &b) const {
+                    return b.compare(0, Name::npos, a.name, 0, a.length) > 0;
+                }
+            };
+
+            /** \brief a combined name/space index of announced prefix locations
+             *
+             *  Entries are organized by name in an ordered table, which supports longest prefix match
+             *  and descendant enumeration, and by location in a uniform grid of square cells, which
+             *  supports nearest-neighbour queries without scanning every entry. Every
+             *  replica of an entry is indexed in the grid, so spatial queries consider all of them.
+             *
+             *  Distances are planar Euclidean over (latitude, longitude), which is consistent with
+             *  ClfStrategy::calculateDistanceEuclid; the cell size is expressed in the same unit.
+             *
+             *  The tree holds at most maxEntries entries. Entries are also kept in least recently used
+             *  order; when an entry is inserted or touched, entries at the tail of that order are erased
+             *  while the tree is over capacity or they have not been used for the lifetime.
+             */
             class PrefixLocationTree {
             public:
-                typedef std::map <Name, shared_ptr<PrefixLocationEntry>> PrefixLocationTable;
+                typedef std::map <Name, shared_ptr<PrefixLocationEntry>, NamePrefixLess> PrefixLocationTable;
                 typedef PrefixLocationTable::const_iterator const_iterator;
+                typedef std::list <shared_ptr<PrefixLocationEntry>> EntryList;
 
-                PrefixLocationTree();
+                /** \throw std::invalid_argument \p maxEntries is zero
+                 */
+                explicit
+                PrefixLocationTree(double cellSize = DEFAULT_CELL_SIZE,
+                                   size_t maxEntries = DEFAULT_MAX_ENTRIES,
+                                   time::nanoseconds lifetime = DEFAULT_LIFETIME);
 
                 const_iterator
                 find(const Name &prefix) const;
 
+                /** \brief perform a longest prefix match for \p name
+                 *
+                 *  Prefixes of \p name are looked up in place, no Name is constructed.
+                 *  \return the matching entry, or nullptr if no entry is a prefix of \p name
+                 */
                 shared_ptr <PrefixLocationEntry>
-                findLongestPrefix(const Name &prefix) const;
+                findLongestPrefix(const Name &name) const;
+
+                /** \brief find the entry closest to \p location that can serve \p name
+                 *
+                 *  An entry can serve \p name if its prefix is a prefix of \p name.
+                 *  Grid cells are visited in rings of increasing distance from \p location,
+                 *  so the search stops as soon as no unvisited cell can hold a closer entry.
+                 *
+                 *  \param maxDistance search radius; entries farther than this are not considered
+                 *  \return the closest entry, or nullptr if none is found within \p maxDistance
+                 */
+                shared_ptr <PrefixLocationEntry>
+                findNearest(const Name &name, const ndn::Location &location,
+                            double maxDistance = std::numeric_limits<double>::infinity()) const;
 
                 const_iterator
                 begin() const;
@@ -149,22 +267,133 @@ namespace nfd {
                 bool
                 empty() const;
 
+                double
+                getCellSize() const;
+
                 shared_ptr <PrefixLocationEntry>
                 findParent(const Name &prefix) const;
 
-                std::list <shared_ptr<PrefixLocationEntry>>
+                EntryList
                 findDescendants(const Name &prefix) const;
 
-                std::list <shared_ptr<PrefixLocationEntry>>
+                EntryList
                 findDescendantsForNonInsertedName(const Name &prefix) const;
 
+                /** \brief insert an entry, or replace the replicas of an existing entry by one at \p location
+                 *  \return the entry stored in the tree
+                 */
+                shared_ptr <PrefixLocationEntry>
+                insert(const Name &prefix, const ndn::Location &location,
+                       time::steady_clock::TimePoint now = time::steady_clock::now());
+
+                void
+                insert(const Name &prefix, shared_ptr <PrefixLocationEntry> entry,
+                       time::steady_clock::TimePoint now = time::steady_clock::now());
+
+                /** \brief add or refresh a replica of \p prefix at \p location, inserting an entry if needed
+                 *
+                 *  Replicas within REPLICA_MERGE_DISTANCE of each other are considered the same replica.
+                 *  \return the entry stored in the tree
+                 */
+                shared_ptr <PrefixLocationEntry>
+                addReplica(const Name &prefix, const ndn::Location &location,
+                           time::steady_clock::TimePoint now = time::steady_clock::now());
+
+                /** \brief mark \p entry as used, so that it is evicted last
+                 *  \pre \p entry is in the tree
+                 */
+                void
+                touch(PrefixLocationEntry &entry, time::steady_clock::TimePoint now = time::steady_clock::now());
+
+                /** \brief erase least recently used entries beyond maxEntries or lifetime
+                 *  \return number of erased entries
+                 */
+                size_t
+                evict(time::steady_clock::TimePoint now = time::steady_clock::now());
+
+                size_t
+                getMaxEntries() const;
+
+                time::nanoseconds
+                getLifetime() const;
+
+                /** \return approximate number of bytes used by the entries and their indexes
+                 */
+                size_t
+                getMemoryUsage() const;
+
+                /** \brief remove the entry of \p prefix
+                 *
+                 *  Children of the removed entry are attached to its parent.
+                 */
                 void
-                insert(const Name &prefix, shared_ptr <PrefixLocationEntry> entry);
+                erase(const Name &prefix);
+
+            private:
+                typedef uint64_t CellKey;
+
+                /** \brief a replica of an entry, in a grid cell
+                 */
+                struct GridItem {
+                    shared_ptr <PrefixLocationEntry> entry;
+                    size_t replica;
+
+                    const ndn::Location &
+                    getLocation() const {
+                        return entry->getReplicas()[replica].location;
+                    }
+                };
+
+                CellKey
+                computeCellKey(const ndn::Location &location) const;
+
+                static CellKey
+                makeCellKey(int32_t x, int32_t y);
+
+                int32_t
+                computeCellIndex(double coordinate) const;
+
+                void
+                addToGrid(const shared_ptr <PrefixLocationEntry> &entry);
+
+                void
+                removeFromGrid(const shared_ptr <PrefixLocationEntry> &entry);
+
+                void
+                attach(const shared_ptr <PrefixLocationEntry> &entry);
+
+                void
+                detach(const shared_ptr <PrefixLocationEntry> &entry);
+
+                /** \brief invoke \p func on every GridItem in cells at Chebyshev distance \p ring from cell (cx, cy)
+                 */
+                template<typename F>
+                void
+                visitRing(int32_t cx, int32_t cy, int64_t ring, const F &func) const;
+
+                static double
+                computeDistance(const ndn::Location &a, const ndn::Location &b);
+
+                static size_t
+                computeEntrySize(const Name &prefix);
+
+            public:
+                static constexpr double DEFAULT_CELL_SIZE = 100.0;
+                static constexpr size_t DEFAULT_MAX_ENTRIES = 4096;
+                static constexpr time::nanoseconds DEFAULT_LIFETIME = 600_s;
+                static constexpr double REPLICA_MERGE_DISTANCE = 1.0;
 
             private:
                 PrefixLocationTable m_prefixLocationTable;
+                std::unordered_map <CellKey, std::vector<GridItem>> m_grid;
+                double m_cellSize;
 
                 size_t m_nItems;
+
+                size_t m_maxEntries;
+                time::nanoseconds m_lifetime;
+                std::list<PrefixLocationEntry *> m_lru; // front is the most recently used
+                size_t m_memoryUsage;
             };
 
             inline PrefixLocationTree::const_iterator
@@ -187,8 +416,28 @@ namespace nfd {
                 return m_prefixLocationTable.empty();
             }
 
+            inline double
+            PrefixLocationTree::getCellSize() const {
+                return m_cellSize;
+            }
+
+            inline size_t
+            PrefixLocationTree::getMaxEntries() const {
+                return m_maxEntries;
+            }
+
+            inline time::nanoseconds
+            PrefixLocationTree::getLifetime() const {
+                return m_lifetime;
+            }
+
+            inline size_t
+            PrefixLocationTree::getMemoryUsage() const {
+                return m_memoryUsage;
+            }
+
         }
     }
 }
 
-#endif
\ No newline at end of file
+#endif
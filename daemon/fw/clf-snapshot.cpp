@@ -0,0 +1,383 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "clf-snapshot.hpp"
+#include "clf-logger.hpp"
+
+#include <boost/endian/conversion.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <map>
+
+namespace nfd {
+    namespace fw {
+        namespace clf {
+
+            NFD_LOG_INIT(ClfSnapshot);
+
+            constexpr uint16_t StateSnapshot::VERSION;
+
+            static const char MAGIC[4] = {'C', 'L', 'F', 'S'};
+
+            template<typename T>
+            static void
+            writeInteger(std::ostream &os, T value) {
+                value = boost::endian::native_to_little(value);
+                os.write(reinterpret_cast<const char *>(&value), sizeof(value));
+            }
+
+            template<typename T>
+            static T
+            readInteger(std::istream &is) {
+                T value = 0;
+                if (!is.read(reinterpret_cast<char *>(&value), sizeof(value))) {
+                    BOOST_THROW_EXCEPTION(StateSnapshot::Error("Snapshot is truncated"));
+                }
+                return boost::endian::little_to_native(value);
+            }
+
+            static void
+            writeDouble(std::ostream &os, double value) {
+                static_assert(sizeof(double) == sizeof(uint64_t), "double must be 64 bits");
+                uint64_t bits = 0;
+                std::memcpy(&bits, &value, sizeof(bits));
+                writeInteger(os, bits);
+            }
+
+            static double
+            readDouble(std::istream &is) {
+                uint64_t bits = readInteger<uint64_t>(is);
+                double value = 0;
+                std::memcpy(&value, &bits, sizeof(value));
+                return value;
+            }
+
+            static void
+            writeDuration(std::ostream &os, time::nanoseconds duration) {
+                writeInteger<int64_t>(os, duration.count());
+            }
+
+            static time::nanoseconds
+            readDuration(std::istream &is) {
+                time::nanoseconds duration(readInteger<int64_t>(is));
+                if (duration < time::nanoseconds::zero()) {
+                    BOOST_THROW_EXCEPTION(StateSnapshot::Error("Snapshot has a negative duration"));
+                }
+                return duration;
+            }
+
+            static void
+            writeName(std::ostream &os, const Name &name) {
+                const Block &wire = name.wireEncode();
+                writeInteger<uint32_t>(os, static_cast<uint32_t>(wire.size()));
+                os.write(reinterpret_cast<const char *>(wire.wire()), wire.size());
+            }
+
+            static Name
+            readName(std::istream &is) {
+                auto size = readInteger<uint32_t>(is);
+                if (size > ndn::MAX_NDN_PACKET_SIZE) {
+                    BOOST_THROW_EXCEPTION(StateSnapshot::Error("Snapshot has an oversized name"));
+                }
+
+                std::vector<uint8_t> buffer(size);
+                if (!is.read(reinterpret_cast<char *>(buffer.data()), size)) {
+                    BOOST_THROW_EXCEPTION(StateSnapshot::Error("Snapshot is truncated"));
+                }
+
+                bool isOk = false;
+                Block block;
+                std::tie(isOk, block) = Block::fromBuffer(buffer);
+                if (!isOk || block.size() != size) {
+                    BOOST_THROW_EXCEPTION(StateSnapshot::Error("Snapshot has a malformed name"));
+                }
+                try {
+                    return Name(block);
+                }
+                catch (const tlv::Error &) {
+                    BOOST_THROW_EXCEPTION(StateSnapshot::Error("Snapshot has a malformed name"));
+                }
+            }
+
+            static void
+            writeUri(std::ostream &os, const std::string &uri) {
+                size_t size = std::min<size_t>(uri.size(), std::numeric_limits<uint16_t>::max());
+                writeInteger<uint16_t>(os, static_cast<uint16_t>(size));
+                os.write(uri.data(), size);
+            }
+
+            static std::string
+            readUri(std::istream &is) {
+                std::string uri(readInteger<uint16_t>(is), '\0');
+                if (!is.read(&uri[0], uri.size())) {
+                    BOOST_THROW_EXCEPTION(StateSnapshot::Error("Snapshot is truncated"));
+                }
+                return uri;
+            }
+
+            StateSnapshot
+            StateSnapshot::capture(const VanetMeasurements &measurements, const PrefixLocationTree &prefixLocations,
+                                   const FaceTable &faceTable) {
+                StateSnapshot snapshot;
+                snapshot.m_timestamp = time::system_clock::now();
+
+                // idle times are measured on the clock that ages the scores
+                auto now = measurements.getTimers().now();
+                auto namespaces = measurements.exportScores(now);
+                snapshot.m_namespaces.reserve(namespaces.size());
+                for (const auto &ns : namespaces) {
+                    NamespaceRecord record;
+                    record.prefix = ns.prefix;
+                    record.idleTime = ns.idleTime;
+                    for (const auto &score : ns.scores) {
+                        const Face *face = faceTable.get(score.first);
+                        if (face == nullptr) {
+                            continue;
+                        }
+                        record.scores.push_back({face->getLocalUri().toString(), face->getRemoteUri().toString(),
+                                                 score.second});
+                    }
+                    snapshot.m_namespaces.push_back(std::move(record));
+                }
+
+                std::vector<const PrefixLocationEntry *> entries;
+                entries.reserve(prefixLocations.size());
+                for (const auto &item : prefixLocations) {
+                    entries.push_back(item.second.get());
+                }
+                std::stable_sort(entries.begin(), entries.end(),
+                                 [] (const PrefixLocationEntry *a, const PrefixLocationEntry *b) {
+                                     return a->getLastUsed() < b->getLastUsed();
+                                 });
+
+                snapshot.m_prefixLocations.reserve(entries.size());
+                for (const PrefixLocationEntry *entry : entries) {
+                    PrefixLocationRecord record;
+                    record.prefix = entry->getName();
+                    record.idleTime = std::max<time::nanoseconds>(now - entry->getLastUsed(),
+                                                                  time::nanoseconds::zero());
+                    for (const auto &replica : entry->getReplicas()) {
+                        record.replicas.emplace_back(replica.location,
+                                                     std::max<time::nanoseconds>(now - replica.lastSeen,
+                                                                                 time::nanoseconds::zero()));
+                    }
+                    snapshot.m_prefixLocations.push_back(std::move(record));
+                }
+                return snapshot;
+            }
+
+            void
+            StateSnapshot::restore(VanetMeasurements &measurements, PrefixLocationTree &prefixLocations,
+                                   const FaceTable &faceTable, time::system_clock::TimePoint now) const {
+                // a clock that went backwards does not make the state younger
+                time::nanoseconds elapsed = std::max<time::nanoseconds>(now - m_timestamp,
+                                                                        time::nanoseconds::zero());
+                auto steadyNow = measurements.getTimers().now();
+
+                // faces that share both FaceUris cannot be told apart, their scores are dropped
+                std::map<std::pair<std::string, std::string>, FaceId> faceIds;
+                for (const Face &face : faceTable) {
+                    auto key = std::make_pair(face.getLocalUri().toString(), face.getRemoteUri().toString());
+                    auto res = faceIds.emplace(key, face.getId());
+                    if (!res.second) {
+                        res.first->second = face::INVALID_FACEID;
+                    }
+                }
+
+                std::vector<VanetMeasurements::NamespaceRecord> namespaces;
+                namespaces.reserve(m_namespaces.size());
+                size_t nDroppedScores = 0;
+                for (const NamespaceRecord &record : m_namespaces) {
+                    VanetMeasurements::NamespaceRecord ns;
+                    ns.prefix = record.prefix;
+                    ns.idleTime = record.idleTime;
+                    for (const FaceScoreRecord &score : record.scores) {
+                        auto it = faceIds.find(std::make_pair(score.localUri, score.remoteUri));
+                        if (it == faceIds.end() || it->second == face::INVALID_FACEID) {
+                            ++nDroppedScores;
+                            continue;
+                        }
+                        ns.scores.emplace_back(it->second, score.scs);
+                    }
+                    namespaces.push_back(std::move(ns));
+                }
+                if (nDroppedScores > 0) {
+                    CLF_LOG_DEBUG("Dropped " << nDroppedScores << " scores of faces that are missing or ambiguous");
+                }
+
+                size_t nNamespaces = measurements.importScores(namespaces, elapsed, steadyNow);
+
+                BOOST_ASSERT(prefixLocations.empty());
+                time::nanoseconds lifetime = prefixLocations.getLifetime();
+                size_t nPrefixLocations = 0;
+                for (const PrefixLocationRecord &record : m_prefixLocations) {
+                    if (record.idleTime + elapsed >= lifetime) {
+                        continue;
+                    }
+
+                    // add the replicas from the least recently seen, so that their ranking is kept
+                    shared_ptr <PrefixLocationEntry> entry;
+                    for (auto it = record.replicas.rbegin(); it != record.replicas.rend(); ++it) {
+                        if (it->second + elapsed >= lifetime) {
+                            continue;
+                        }
+                        auto lastSeen = steadyNow - (it->second + elapsed);
+                        entry = entry == nullptr ? prefixLocations.insert(record.prefix, it->first, lastSeen) :
+                                                   prefixLocations.addReplica(record.prefix, it->first, lastSeen);
+                    }
+                    if (entry == nullptr) {
+                        continue;
+                    }
+
+                    // records are least recently used first, so the LRU order is rebuilt by touching
+                    prefixLocations.touch(*entry, steadyNow - (record.idleTime + elapsed));
+                    ++nPrefixLocations;
+                }
+                prefixLocations.evict(steadyNow);
+
+                NFD_LOG_INFO("Restored " << nNamespaces << " namespaces and " << nPrefixLocations
+                             << " prefix locations saved " << time::duration_cast<time::seconds>(elapsed) << " ago");
+            }
+
+            void
+            StateSnapshot::write(std::ostream &os) const {
+                os.write(MAGIC, sizeof(MAGIC));
+                writeInteger<uint16_t>(os, VERSION);
+                writeDuration(os, m_timestamp.time_since_epoch());
+
+                writeInteger<uint32_t>(os, static_cast<uint32_t>(m_namespaces.size()));
+                for (const auto &record : m_namespaces) {
+                    writeName(os, record.prefix);
+                    writeDuration(os, record.idleTime);
+                    size_t nScores = std::min<size_t>(record.scores.size(), std::numeric_limits<uint8_t>::max());
+                    writeInteger<uint8_t>(os, static_cast<uint8_t>(nScores));
+                    for (size_t i = 0; i < nScores; ++i) {
+                        writeUri(os, record.scores[i].localUri);
+                        writeUri(os, record.scores[i].remoteUri);
+                        writeDouble(os, record.scores[i].scs);
+                    }
+                }
+
+                writeInteger<uint32_t>(os, static_cast<uint32_t>(m_prefixLocations.size()));
+                for (const auto &record : m_prefixLocations) {
+                    writeName(os, record.prefix);
+                    writeDuration(os, record.idleTime);
+                    size_t nReplicas = std::min(record.replicas.size(), PrefixLocationEntry::MAX_REPLICAS);
+                    writeInteger<uint8_t>(os, static_cast<uint8_t>(nReplicas));
+                    for (size_t i = 0; i < nReplicas; ++i) {
+                        writeDouble(os, record.replicas[i].first.getLatitude());
+                        writeDouble(os, record.replicas[i].first.getLongitude());
+                        writeDuration(os, record.replicas[i].second);
+                    }
+                }
+            }
+
+            StateSnapshot
+            StateSnapshot::read(std::istream &is) {
+                char magic[sizeof(MAGIC)] = {};
+                if (!is.read(magic, sizeof(magic)) || !std::equal(magic, magic + sizeof(magic), MAGIC)) {
+                    BOOST_THROW_EXCEPTION(Error("Not a CLF snapshot"));
+                }
+                auto version = readInteger<uint16_t>(is);
+                if (version != VERSION) {
+                    BOOST_THROW_EXCEPTION(Error("Unsupported CLF snapshot version " + to_string(version)));
+                }
+
+                StateSnapshot snapshot;
+                snapshot.m_timestamp = time::system_clock::TimePoint(
+                        time::duration_cast<time::system_clock::Duration>(readDuration(is)));
+
+                // counts are not trusted for preallocation, a truncated file throws before memory runs out
+                auto nNamespaces = readInteger<uint32_t>(is);
+                for (uint32_t i = 0; i < nNamespaces; ++i) {
+                    NamespaceRecord record;
+                    record.prefix = readName(is);
+                    record.idleTime = readDuration(is);
+                    auto nScores = readInteger<uint8_t>(is);
+                    for (uint8_t j = 0; j < nScores; ++j) {
+                        FaceScoreRecord score;
+                        score.localUri = readUri(is);
+                        score.remoteUri = readUri(is);
+                        score.scs = readDouble(is);
+                        record.scores.push_back(std::move(score));
+                    }
+                    snapshot.m_namespaces.push_back(std::move(record));
+                }
+
+                auto nPrefixLocations = readInteger<uint32_t>(is);
+                for (uint32_t i = 0; i < nPrefixLocations; ++i) {
+                    PrefixLocationRecord record;
+                    record.prefix = readName(is);
+                    record.idleTime = readDuration(is);
+                    auto nReplicas = readInteger<uint8_t>(is);
+                    if (nReplicas > PrefixLocationEntry::MAX_REPLICAS) {
+                        BOOST_THROW_EXCEPTION(Error("Snapshot has too many replicas"));
+                    }
+                    for (uint8_t j = 0; j < nReplicas; ++j) {
+                        double latitude = readDouble(is);
+                        double longitude = readDouble(is);
+                        record.replicas.emplace_back(ndn::Location(latitude, longitude), readDuration(is));
+                    }
+                    snapshot.m_prefixLocations.push_back(std::move(record));
+                }
+                return snapshot;
+            }
+
+            void
+            StateSnapshot::save(const std::string &path) const {
+                // readers never see a partially written snapshot
+                std::string tmpPath = path + ".tmp";
+                {
+                    std::ofstream os(tmpPath, std::ios::binary | std::ios::trunc);
+                    write(os);
+                    os.close();
+                    if (!os) {
+                        std::remove(tmpPath.c_str());
+                        BOOST_THROW_EXCEPTION(Error("Cannot write " + tmpPath));
+                    }
+                }
+                if (std::rename(tmpPath.c_str(), path.c_str()) != 0) {
+                    std::remove(tmpPath.c_str());
+                    BOOST_THROW_EXCEPTION(Error("Cannot rename " + tmpPath + " to " + path));
+                }
+                CLF_LOG_DEBUG("Saved " << m_namespaces.size() << " namespaces and " << m_prefixLocations.size()
+                              << " prefix locations to " << path);
+            }
+
+            StateSnapshot
+            StateSnapshot::load(const std::string &path) {
+                std::ifstream is(path, std::ios::binary);
+                if (!is) {
+                    BOOST_THROW_EXCEPTION(Error("Cannot open " + path));
+                }
+                return read(is);
+            }
+
+        } // namespace clf
+    } // namespace fw
+} // namespace nfd
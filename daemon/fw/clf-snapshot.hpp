@@ -0,0 +1,155 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_FW_CLF_SNAPSHOT_HPP
+#define NFD_DAEMON_FW_CLF_SNAPSHOT_HPP
+
+#include "fw/clf-vanet-measurements.hpp"
+#include "fw/clf-prefix-location-tree.hpp"
+#include "fw/face-table.hpp"
+
+#include <iosfwd>
+
+namespace nfd {
+    namespace fw {
+        namespace clf {
+
+            /** \brief a snapshot of the state learned by ClfStrategy, to warm-start it after a restart
+             *
+             *  A snapshot holds the smoothed centrality score of every namespace on every face, and
+             *  the replica locations of every announced prefix, with how long ago each was last used
+             *  or seen. It is stamped with the wall-clock time at which it was captured, so that the
+             *  restored state is aged by the time elapsed until it is restored, including downtime.
+             *
+             *  The binary format is little-endian:
+             *  \code
+             *  Snapshot       := "CLFS" Version(u16) Timestamp(i64 ns since the Unix epoch)
+             *                    NNamespaces(u32) Namespace* NPrefixLocations(u32) PrefixLocation*
+             *  Namespace      := Name IdleTime(i64 ns) NScores(u8) (LocalUri RemoteUri Scs(f64))*
+             *  PrefixLocation := Name IdleTime(i64 ns) NReplicas(u8) (Latitude(f64) Longitude(f64) Age(i64 ns))*
+             *  Name           := Length(u32) <TLV wire encoding of the name>
+             *  LocalUri       := Length(u16) <FaceUri>
+             *  RemoteUri      := Length(u16) <FaceUri>
+             *  \endcode
+             *  Namespaces and prefix locations are stored least recently used first.
+             *
+             *  FaceIds are assigned when faces are created and are not stable across restarts, so a
+             *  score is saved with the local and remote FaceUri of its face, and restored on the face
+             *  that has the same FaceUris after the restart. Scores whose face does not exist when the
+             *  snapshot is restored, or cannot be told apart from another face, are dropped.
+             */
+            class StateSnapshot {
+            public:
+                class Error : public std::runtime_error {
+                public:
+                    using std::runtime_error::runtime_error;
+                };
+
+                struct FaceScoreRecord {
+                    std::string localUri;
+                    std::string remoteUri;
+                    NamespaceInfo::Cscore scs;
+                };
+
+                struct NamespaceRecord {
+                    Name prefix;
+                    time::nanoseconds idleTime; ///< time since the namespace was last used
+                    std::vector<FaceScoreRecord> scores;
+                };
+
+                struct PrefixLocationRecord {
+                    Name prefix;
+                    time::nanoseconds idleTime; ///< time since the entry was last used
+                    /// location and age of each replica, the most recently seen first
+                    std::vector<std::pair<ndn::Location, time::nanoseconds>> replicas;
+                };
+
+                /** \brief capture the state of \p measurements and \p prefixLocations
+                 *  \param faceTable resolves the FaceIds of the scores to FaceUris
+                 */
+                static StateSnapshot
+                capture(const VanetMeasurements &measurements, const PrefixLocationTree &prefixLocations,
+                        const FaceTable &faceTable);
+
+                /** \brief restore the captured state, aged by the time elapsed since it was captured
+                 *
+                 *  Scores keep decaying over the elapsed time, and entries and replicas that would have
+                 *  expired in the meantime are not restored.
+                 *  \param faceTable resolves the FaceUris of the scores to the FaceIds of existing faces
+                 *  \pre \p measurements and \p prefixLocations are empty
+                 */
+                void
+                restore(VanetMeasurements &measurements, PrefixLocationTree &prefixLocations,
+                        const FaceTable &faceTable,
+                        time::system_clock::TimePoint now = time::system_clock::now()) const;
+
+                void
+                write(std::ostream &os) const;
+
+                /** \throw Error the snapshot is truncated or malformed
+                 */
+                static StateSnapshot
+                read(std::istream &is);
+
+                /** \brief write the snapshot to a temporary file, and rename it to \p path
+                 *  \throw Error the file cannot be written
+                 */
+                void
+                save(const std::string &path) const;
+
+                /** \throw Error the file cannot be opened, or is truncated or malformed
+                 */
+                static StateSnapshot
+                load(const std::string &path);
+
+                time::system_clock::TimePoint
+                getTimestamp() const {
+                    return m_timestamp;
+                }
+
+                const std::vector<NamespaceRecord> &
+                getNamespaces() const {
+                    return m_namespaces;
+                }
+
+                const std::vector<PrefixLocationRecord> &
+                getPrefixLocations() const {
+                    return m_prefixLocations;
+                }
+
+            public:
+                static constexpr uint16_t VERSION = 2;
+
+            private:
+                time::system_clock::TimePoint m_timestamp;
+                std::vector<NamespaceRecord> m_namespaces;
+                std::vector<PrefixLocationRecord> m_prefixLocations;
+            };
+
+        } // namespace clf
+    } // namespace fw
+} // namespace nfd
+
+#endif // NFD_DAEMON_FW_CLF_SNAPSHOT_HPP
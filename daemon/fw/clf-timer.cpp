@@ -0,0 +1,81 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "clf-timer.hpp"
+#include "common/global.hpp"
+
+
+namespace nfd {
+    namespace fw {
+        namespace clf {
+
+            TimerId
+            TimerBackend::schedule(time::nanoseconds delay, Callback callback) {
+                ++m_counters.nScheduled;
+
+                auto isPending = make_shared<bool>(true);
+                TimerId id = doSchedule(delay, [this, isPending, cb = std::move(callback)] {
+                    *isPending = false;
+                    ++m_counters.nFired;
+                    cb();
+                });
+
+                return TimerId([this, isPending, id] () mutable {
+                    if (*isPending) {
+                        *isPending = false;
+                        ++m_counters.nCancelled;
+                        id.cancel();
+                    }
+                });
+            }
+
+            time::steady_clock::TimePoint
+            SchedulerTimerBackend::now() const {
+                return time::steady_clock::now();
+            }
+
+            const std::string &
+            SchedulerTimerBackend::getName() const {
+                static const std::string name("scheduler");
+                return name;
+            }
+
+            TimerId
+            SchedulerTimerBackend::doSchedule(time::nanoseconds delay, Callback callback) {
+                return getScheduler().schedule(delay, std::move(callback));
+            }
+
+            unique_ptr <TimerBackend>
+            makeTimerBackend(const std::string &name) {
+                if (name.empty() || name == "scheduler") {
+                    return make_unique<SchedulerTimerBackend>();
+                }
+
+                BOOST_THROW_EXCEPTION(std::invalid_argument("Timer backend '" + name + "' is not available"));
+            }
+
+        } // namespace clf
+    } // namespace fw
+} // namespace nfd
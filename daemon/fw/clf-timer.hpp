@@ -0,0 +1,118 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_FW_CLF_TIMER_HPP
+#define NFD_DAEMON_FW_CLF_TIMER_HPP
+
+#include "common/counter.hpp"
+
+#include <ndn-cxx/detail/cancel-handle.hpp>
+
+namespace nfd {
+    namespace fw {
+        namespace clf {
+
+            /** \brief identifies a timer scheduled through TimerBackend
+             *
+             *  Calling cancel() on a timer that has fired or has been cancelled is a no-op.
+             */
+            using TimerId = ndn::detail::CancelHandle;
+
+            /** \brief schedules the deferred actions of ClfStrategy and VanetMeasurements
+             *
+             *  This decouples the strategy from the event loop it runs in, so that a simulator
+             *  embedding NFD can drive the deferred actions from its own clock.
+             */
+            class TimerBackend : noncopyable {
+            public:
+                typedef std::function<void()> Callback;
+
+                virtual
+                ~TimerBackend() = default;
+
+                /** \brief schedule \p callback to be invoked after \p delay
+                 */
+                TimerId
+                schedule(time::nanoseconds delay, Callback callback);
+
+                /** \brief return the current time of the clock that timers are scheduled on
+                 */
+                virtual time::steady_clock::TimePoint
+                now() const = 0;
+
+                /** \brief return the name of the backend, used in log messages and strategy parameters
+                 */
+                virtual const std::string &
+                getName() const = 0;
+
+            private:
+                virtual TimerId
+                doSchedule(time::nanoseconds delay, Callback callback) = 0;
+
+            public:
+                /** \brief counters of timer operations, to measure timer overhead under real packet rates
+                 */
+                struct Counters {
+                    PacketCounter nScheduled;
+                    PacketCounter nCancelled;
+                    PacketCounter nFired;
+                };
+
+                Counters &
+                getCounters() {
+                    return m_counters;
+                }
+
+            private:
+                Counters m_counters;
+            };
+
+            /** \brief a TimerBackend on the global ndn::Scheduler of NFD
+             */
+            class SchedulerTimerBackend : public TimerBackend {
+            public:
+                time::steady_clock::TimePoint
+                now() const override;
+
+                const std::string &
+                getName() const override;
+
+            private:
+                TimerId
+                doSchedule(time::nanoseconds delay, Callback callback) override;
+            };
+
+            /** \brief create a TimerBackend by name
+             *  \param name "scheduler"; an empty name selects "scheduler"
+             *  \throw std::invalid_argument the backend is unknown or unavailable in this build
+             */
+            unique_ptr <TimerBackend>
+            makeTimerBackend(const std::string &name = "");
+
+        } // namespace clf
+    } // namespace fw
+} // namespace nfd
+
+#endif // NFD_DAEMON_FW_CLF_TIMER_HPP
@@ -24,6 +24,10 @@
  */
 
 #include "clf-vanet-measurements.hpp"
+#include "clf-logger.hpp"
+
+#include <algorithm>
+#include <cmath>
 
 namespace nfd {
     namespace fw {
@@ -31,69 +35,6 @@ namespace nfd {
 
             NFD_LOG_INIT(ClfMeasurements);
 
-            const double CsStats::ALPHA = 0.125;
-
-            CsStats::CsStats()
-                    : m_noOfInterest(0)
-                    , m_noOfData(0)
-                    , m_cs(0)
-                    , m_scs(0)
-            {
-            }
-
-            CsStats::Cscore
-            CsStats::computeScs(Cscore currentCscore, Cscore previousCscore)
-            {
-                return ALPHA * currentCscore + (1 - ALPHA) * previousCscore;
-            }
-
-            void
-            CsStats::incrementInterestCount(ndn::Name prefix)
-            {
-                m_noOfInterest++;
-                NFD_LOG_DEBUG("Increasing interest count for " << prefix << ". NoOfInterests: " << m_noOfInterest);
-            }
-
-            void
-            CsStats::incrementDataCount(ndn::Name prefix)
-            {
-                m_noOfData++;
-                NFD_LOG_DEBUG("Increasing data count for " << prefix << ". NoOfData: " << m_noOfData);
-            }
-
-            void
-            CsStats::updateScore(ndn::Name prefix)
-            {
-                if (m_noOfData <= m_noOfInterest) {
-                    if (m_noOfData == 0 && m_noOfInterest == 0) {
-                        m_cs = 0;
-                    }
-                    else {
-                        m_cs = (double) m_noOfData/ m_noOfInterest;
-                    }
-                }
-                else { // will happen if a new entry is created from prefix ann.
-                    m_noOfInterest = m_noOfData;
-                    m_cs = 1.0;
-                }
-
-                // calculate new scs
-                m_scs = computeScs(m_cs, m_scs);
-
-                NFD_LOG_DEBUG("Calculating centrality score for " << prefix  << ": NoOfInterests = " << m_noOfInterest << ", NoOfData = " << m_noOfData << ". CS= " << m_cs << ", SCS= " << m_scs);
-
-                // reset interest and data count
-                m_noOfInterest = 0;
-                m_noOfData = 0;
-            }
-
-            void
-            CsStats::decayScore()
-            {
-                NFD_LOG_DEBUG("Decaying score from " << m_scs << " to " << m_scs/2 );
-                m_scs = m_scs * VanetMeasurements::R;
-            }
-
 //            DestLocationInfo::DestLocationInfo()
 //                    : m_destLocation(ndn::Location(0, 0))
 //            {
@@ -106,121 +47,215 @@ namespace nfd {
 //                m_destLocation = destLocation;
 //            }
 
-            FaceInfo::FaceInfo()
+            constexpr NamespaceInfo::Slot NamespaceInfo::INVALID_SLOT;
+            constexpr size_t NamespaceInfo::N_INLINE_FACES;
+
+            // bytes of one face slot beyond the inline ones
+            static constexpr size_t FACE_SLOT_SIZE = sizeof(FaceId) + 2 * sizeof(int) +
+                                                     2 * sizeof(NamespaceInfo::Cscore) + sizeof(uint64_t) +
+                                                     sizeof(time::steady_clock::TimePoint);
+
+            // bytes of a node of VanetMeasurements::m_lru
+            static constexpr size_t LRU_NODE_SIZE = 3 * sizeof(void*);
+
+            NamespaceInfo::NamespaceInfo()
             {
             }
 
-            void
-            FaceInfo::recordCs(const shared_ptr<pit::Entry>& pitEntry, const Face& inFace)
+            NamespaceInfo::~NamespaceInfo()
             {
+                if (m_owner != nullptr) {
+                    m_owner->detach(*this);
+                }
             }
 
-            void
-            FaceInfo::updateScore(ndn::Name prefix)
+            size_t
+            NamespaceInfo::getMemoryUsage() const
             {
-                m_csStats.updateScore(prefix);
+                size_t nSpilled = m_faceIds.size() > N_INLINE_FACES ? m_faceIds.size() - N_INLINE_FACES : 0;
+                return sizeof(NamespaceInfo) + LRU_NODE_SIZE + nSpilled * FACE_SLOT_SIZE;
             }
 
-            void
-            FaceInfo::incrementInterestCount(ndn::Name prefix)
+            NamespaceInfo::Cscore
+            NamespaceInfo::computeScs(double alpha, Cscore currentCscore, Cscore previousCscore)
             {
-                m_csStats.incrementInterestCount(prefix);
+                return alpha * currentCscore + (1 - alpha) * previousCscore;
             }
 
-            void
-            FaceInfo::incrementDataCount(ndn::Name prefix)
+            NamespaceInfo::Slot
+            NamespaceInfo::findFace(FaceId faceId) const
             {
-                m_csStats.incrementDataCount(prefix);
+                for (Slot slot = 0; slot < m_faceIds.size(); ++slot) {
+                    if (m_faceIds[slot] == faceId) {
+                        return slot;
+                    }
+                }
+                return INVALID_SLOT;
             }
 
-            void
-            FaceInfo::decayScore()
+            NamespaceInfo::Slot
+            NamespaceInfo::getOrCreateFace(FaceId faceId)
             {
-                m_csStats.decayScore();
-                // schedule next round of decay here
-//  m_scoreDecayEventId = scheduler::schedule(VanetMeasurements::SCORE_DECAY_TIME, [&] { decayScore(); });
+                Slot slot = findFace(faceId);
+                if (slot != INVALID_SLOT) {
+                    return slot;
+                }
+
+                CLF_LOG_DEBUG("Creating face statistics on face " << faceId);
+                m_faceIds.push_back(faceId);
+                m_nInterests.push_back(0);
+                m_nData.push_back(0);
+                m_cs.push_back(0);
+                m_scs.push_back(0);
+                m_lastEpoch.push_back(0);
+                m_lastUpdate.push_back(time::steady_clock::TimePoint::min());
+
+                if (m_owner != nullptr && m_faceIds.size() > N_INLINE_FACES) {
+                    m_owner->m_memoryUsage += FACE_SLOT_SIZE;
+                }
+                return m_faceIds.size() - 1;
             }
 
-            void
-            FaceInfo::rescheduleScoreDecay(FaceInfo& info, FaceId faceId, ndn::Name prefix)
+            NamespaceInfo::Cscore
+            NamespaceInfo::getScs(Slot slot, uint64_t epoch, time::steady_clock::TimePoint now,
+                                  const ScoreParameters& params) const
             {
-                NFD_LOG_DEBUG("Rescheduling score decay event for " << prefix.toUri());
-                scheduler::cancel(info.getScoreDecayEventId());
+                if (m_scs[slot] == 0) {
+                    return 0;
+                }
 
-                //auto id = scheduler::schedule(VanetMeasurements::SCORE_DECAY_TIME, [&] { decayScore(); });
-                //info.setScoreDecayEventId(id);
-            }
+                // every epoch after the last update had a centrality score of zero
+                BOOST_ASSERT(epoch >= m_lastEpoch[slot]);
+                Cscore scs = m_scs[slot] * std::pow(1 - params.alpha, epoch - m_lastEpoch[slot]);
 
-//            void
-//            FaceInfo::updateLocation(ndn::Name namePrefix, ndn::Location dl)
-//            {
-//                m_destLocationInfo.setLocation(namePrefix, dl);
-//            }
+                // decay by r for every decay period elapsed since the last update
+                if (now > m_lastUpdate[slot]) {
+                    double nPeriods = time::duration_cast<time::duration<double>>(now - m_lastUpdate[slot]) /
+                                      time::duration_cast<time::duration<double>>(params.decayPeriod);
+                    scs *= std::pow(params.r, nPeriods);
+                }
+                return scs;
+            }
 
-            NamespaceInfo::NamespaceInfo()
+            void
+            NamespaceInfo::updateScore(Slot slot, const Name& prefix, uint64_t epoch,
+                                       time::steady_clock::TimePoint now, const ScoreParameters& params)
             {
+                // catch up on the epochs without traffic and on the decay before folding in this epoch
+                BOOST_ASSERT(epoch > m_lastEpoch[slot]);
+                m_scs[slot] = getScs(slot, epoch - 1, now, params);
+                m_lastEpoch[slot] = epoch;
+                m_lastUpdate[slot] = now;
+
+                int& nInterests = m_nInterests[slot];
+                int& nData = m_nData[slot];
+                if (nData <= nInterests) {
+                    if (nData == 0 && nInterests == 0) {
+                        m_cs[slot] = 0;
+                    }
+                    else {
+                        m_cs[slot] = (double) nData / nInterests;
+                    }
+                }
+                else { // will happen if a new entry is created from prefix ann.
+                    nInterests = nData;
+                    m_cs[slot] = 1.0;
+                }
+
+                // calculate new scs
+                m_scs[slot] = computeScs(params.alpha, m_cs[slot], m_scs[slot]);
+
+                CLF_LOG_DEBUG("Calculating centrality score for " << prefix << " on face " << m_faceIds[slot] << ": NoOfInterests = " << nInterests << ", NoOfData = " << nData << ". CS= " << m_cs[slot] << ", SCS= " << m_scs[slot]);
+
+                // reset interest and data count
+                nInterests = 0;
+                nData = 0;
             }
 
-            FaceInfo*
-            NamespaceInfo::getFaceInfo(const fib::Entry& fibEntry, FaceId faceId)
-            {
-                FaceInfoTable::iterator it = m_fit.find(faceId);
+            constexpr time::microseconds VanetMeasurements::MEASUREMENTS_LIFETIME;
+            constexpr time::microseconds VanetMeasurements::SCORE_UPDATE_INTERVAL;
+            constexpr size_t VanetMeasurements::DEFAULT_MAX_ENTRIES;
 
-                if (it != m_fit.end()) {
-                    return &it->second;
+            VanetMeasurements::VanetMeasurements(MeasurementsAccessor& measurements, TimerBackend& timers,
+                                                 size_t maxEntries, time::nanoseconds lifetime,
+                                                 const ScoreParameters& scoreParams)
+                    : m_measurements(measurements)
+                    , m_timers(timers)
+                    , m_maxEntries(maxEntries)
+                    , m_lifetime(lifetime)
+                    , m_scoreParams(scoreParams)
+                    , m_epoch(0)
+                    , m_memoryUsage(0)
+            {
+                if (m_maxEntries == 0) {
+                    BOOST_THROW_EXCEPTION(std::invalid_argument("maxEntries must be positive"));
                 }
-                else {
-                    return nullptr;
+                if (m_lifetime <= SCORE_UPDATE_INTERVAL) {
+                    BOOST_THROW_EXCEPTION(std::invalid_argument("lifetime must be longer than SCORE_UPDATE_INTERVAL"));
+                }
+                if (!(m_scoreParams.alpha > 0 && m_scoreParams.alpha <= 1) ||
+                    !(m_scoreParams.r > 0 && m_scoreParams.r <= 1) ||
+                    m_scoreParams.decayPeriod <= time::nanoseconds::zero()) {
+                    BOOST_THROW_EXCEPTION(std::invalid_argument("alpha and r must be in (0, 1], and the decay period positive"));
                 }
             }
 
-            void
-            NamespaceInfo::rescheduleScoreDecay(FaceInfo& info, FaceId faceId, ndn::Name prefix)
+            VanetMeasurements::~VanetMeasurements()
             {
-                NFD_LOG_DEBUG("Rescheduling score decay event for " << prefix.toUri());
-                scheduler::cancel(info.getScoreDecayEventId());
+                m_scoreUpdateTimer.cancel();
 
-                //auto id = scheduler::schedule(VanetMeasurements::SCORE_DECAY_TIME, [&] { info.decayScore(prefix); });
-                //info.setScoreDecayEventId(id);
+                // NamespaceInfo may outlive this object in the measurements table
+                for (NamespaceInfo* info : m_lru) {
+                    info->m_owner = nullptr;
+                }
             }
 
-            FaceInfo&
-            NamespaceInfo::getOrCreateFaceInfo(const fib::Entry& fibEntry, FaceId faceId)
+            NamespaceInfo&
+            VanetMeasurements::insertNamespaceInfo(measurements::Entry& me, time::steady_clock::TimePoint now)
             {
-                FaceInfoTable::iterator it = m_fit.find(faceId);
-
-                FaceInfo* info = nullptr;
-
-                if (it == m_fit.end()) {
-                    NFD_LOG_DEBUG("Creating FaceInfo on face " << faceId);
-                    const auto& pair = m_fit.emplace(faceId, FaceInfo());
-                    info = &pair.first->second;
+                NamespaceInfo* info = me.insertStrategyInfo<NamespaceInfo>().first;
+                BOOST_ASSERT(info != nullptr);
 
-                    //extendFaceInfoLifetime(*info, faceId);
+                if (info->m_owner == nullptr) {
+                    info->m_owner = this;
+                    info->m_entry = &me;
+                    info->m_lruIt = m_lru.insert(m_lru.begin(), info);
+                    m_memoryUsage += info->getMemoryUsage();
                 }
                 else {
-                    info = &it->second;
+                    m_lru.splice(m_lru.begin(), m_lru, info->m_lruIt);
                 }
-
+                info->m_lastUsed = now;
                 return *info;
-
             }
 
-            constexpr time::microseconds VanetMeasurements::SCORE_DECAY_TIME;
-            constexpr double VanetMeasurements::R;
-            constexpr time::microseconds VanetMeasurements::MEASUREMENTS_LIFETIME;
-
-            VanetMeasurements::VanetMeasurements(MeasurementsAccessor& measurements)
-                    : m_measurements(measurements)
+            void
+            VanetMeasurements::detach(NamespaceInfo& info)
             {
+                BOOST_ASSERT(info.m_owner == this);
+                m_lru.erase(info.m_lruIt);
+                m_memoryUsage -= info.getMemoryUsage();
+                info.m_owner = nullptr;
+
+                // the measurement entry may be erased next, so it must not be visited at the epoch end
+                if (m_dirtyEntries.erase(info.m_entry) > 0 && m_dirtyEntries.empty()) {
+                    m_scoreUpdateTimer.cancel();
+                }
             }
 
-            FaceInfo&
-            VanetMeasurements::getOrCreateFaceInfo(const fib::Entry& fibEntry, ndn::Name namePrefix,
-                                                   FaceId faceId)
+            void
+            VanetMeasurements::evict(time::steady_clock::TimePoint now)
             {
-                NamespaceInfo& info = getOrCreateNamespaceInfo(fibEntry, namePrefix);
-                return info.getOrCreateFaceInfo(fibEntry, faceId);
+                while (!m_lru.empty()) {
+                    NamespaceInfo* info = m_lru.back();
+                    if (m_lru.size() <= m_maxEntries && info->m_lastUsed + m_lifetime > now) {
+                        break;
+                    }
+
+                    CLF_LOG_DEBUG("Evicting " << info->m_entry->getName());
+                    // the destructor of NamespaceInfo calls detach
+                    info->m_entry->eraseStrategyInfo<NamespaceInfo>();
+                }
             }
 
             NamespaceInfo*
@@ -230,63 +265,117 @@ namespace nfd {
                     return nullptr;
                 }
 
-                NamespaceInfo* info = me->insertStrategyInfo<NamespaceInfo>().first;
-                BOOST_ASSERT(info != nullptr);
-                return info;
+                return &insertNamespaceInfo(*me, m_timers.now());
             }
 
             NamespaceInfo&
-            VanetMeasurements::getOrCreateNamespaceInfo(const fib::Entry& fibEntry,
-                                                        const ndn::Name namePrefix) {
-
-                //NFD_LOG_DEBUG("FibEntry: " << fibEntry.getPrefix().toUri());
-                measurements::Entry* me = m_measurements.get(fibEntry);
-
-                // If the FIB entry is not under the strategy's namespace, find a part of the prefix
-                // that falls under the strategy's namespace
-                /*for (size_t prefixLen = fibEntry.getPrefix().size() + 1;
-                     me == nullptr && prefixLen <= namePrefix.size(); ++prefixLen) {
-                  me = m_measurements.get(namePrefix.getPrefix(prefixLen));
-                  NFD_LOG_DEBUG("MeEntry: " << me->getName().toUri());
-                }*/
-
-                me = m_measurements.get(namePrefix);
-
-                //NFD_LOG_DEBUG("Creating namespaceinfo for " << me->getName().toUri());
+            VanetMeasurements::getOrCreateNamespaceInfo(const Name& prefix)
+            {
+                measurements::Entry* me = m_measurements.get(prefix);
 
-                // Either the FIB entry or the Interest's name must be under this strategy's namespace
+                // the prefix must be under this strategy's namespace
                 BOOST_ASSERT(me != nullptr);
 
                 // Set or update entry lifetime
                 extendLifetime(*me);
 
-                NamespaceInfo* info = me->insertStrategyInfo<NamespaceInfo>().first;
-                BOOST_ASSERT(info != nullptr);
-                return *info;
+                return insertNamespaceInfo(*me, m_timers.now());
             }
 
             double
-            VanetMeasurements::getCs(const fib::Entry& fibEntry, FaceId faceId, ndn::Name namePrefix)
+            VanetMeasurements::getCs(const pit::Entry& pitEntry, FaceId faceId) const
             {
-                // also need to update the score of the prefix's parents
-                measurements::Entry* currentMe = m_measurements.get(namePrefix);
-                NamespaceInfo* namespaceInfo = currentMe->getStrategyInfo<NamespaceInfo>();
-                for (size_t prefixLen = namePrefix.size();
-                     namespaceInfo == nullptr && prefixLen > 0; --prefixLen) {
-                    //NFD_LOG_DEBUG(namePrefix.getPrefix(prefixLen));
-                    currentMe = m_measurements.get(namePrefix.getPrefix(prefixLen));
-                    namespaceInfo = currentMe->getStrategyInfo<NamespaceInfo>();
+                // the PIT entry leads to its name tree entry, from which ancestors are visited
+                // without creating measurement entries or prefix names
+                measurements::Entry* me = m_measurements.findLongestPrefixMatch(pitEntry,
+                        measurements::EntryWithStrategyInfo<NamespaceInfo>());
+                if (me == nullptr) {
+                    CLF_LOG_DEBUG("Measurement entry for " << pitEntry.getName() << " not found. Score is 0.");
+                    return 0;
                 }
 
-                if (namespaceInfo != nullptr) {
-                    FaceInfo* faceInfo = namespaceInfo->get(faceId);
-                    NFD_LOG_DEBUG("Longest matching measurement entry for prefix " << namePrefix.toUri() << " is " <<currentMe->getName().toUri() << ". Score is " << faceInfo->getScs());
-                    return faceInfo->getScs();
-                }
-                else {
-                    NFD_LOG_DEBUG("Measurement entry for prefix " << namePrefix.toUri() << " not found. Score is 0.");
+                const NamespaceInfo* namespaceInfo = me->getStrategyInfo<NamespaceInfo>();
+                NamespaceInfo::Slot slot = namespaceInfo->findFace(faceId);
+                if (slot == NamespaceInfo::INVALID_SLOT) {
                     return 0;
                 }
+
+                double scs = namespaceInfo->getScs(slot, m_epoch, m_timers.now(), m_scoreParams);
+                CLF_LOG_DEBUG("Longest matching measurement entry for " << pitEntry.getName() << " is "
+                              << me->getName() << ". Score is " << scs);
+                return scs;
+            }
+
+            optional<double>
+            VanetMeasurements::getCentrality(const Name& name) const
+            {
+                measurements::Entry* me = m_measurements.findLongestPrefixMatch(name,
+                        measurements::EntryWithStrategyInfo<NamespaceInfo>());
+                if (me == nullptr) {
+                    return nullopt;
+                }
+
+                const NamespaceInfo* namespaceInfo = me->getStrategyInfo<NamespaceInfo>();
+                auto now = m_timers.now();
+                double centrality = 0;
+                for (NamespaceInfo::Slot slot = 0; slot < namespaceInfo->size(); ++slot) {
+                    centrality = std::max(centrality, namespaceInfo->getScs(slot, m_epoch, now, m_scoreParams));
+                }
+                return centrality;
+            }
+
+            std::vector<VanetMeasurements::NamespaceRecord>
+            VanetMeasurements::exportScores(time::steady_clock::TimePoint now) const
+            {
+                std::vector<NamespaceRecord> records;
+                records.reserve(m_lru.size());
+                for (auto it = m_lru.rbegin(); it != m_lru.rend(); ++it) {
+                    const NamespaceInfo& info = **it;
+                    NamespaceRecord record;
+                    record.prefix = info.m_entry->getName();
+                    record.idleTime = std::max<time::nanoseconds>(now - info.m_lastUsed, time::nanoseconds::zero());
+                    for (NamespaceInfo::Slot slot = 0; slot < info.size(); ++slot) {
+                        record.scores.emplace_back(info.getFaceId(slot), info.getScs(slot, m_epoch, now, m_scoreParams));
+                    }
+                    records.push_back(std::move(record));
+                }
+                return records;
+            }
+
+            size_t
+            VanetMeasurements::importScores(const std::vector<NamespaceRecord>& records, time::nanoseconds elapsed,
+                                            time::steady_clock::TimePoint now)
+            {
+                BOOST_ASSERT(m_lru.empty());
+
+                size_t nImported = 0;
+                for (const NamespaceRecord& record : records) {
+                    time::nanoseconds idleTime = record.idleTime + elapsed;
+                    if (idleTime >= m_lifetime) {
+                        continue;
+                    }
+
+                    measurements::Entry* me = m_measurements.get(record.prefix);
+                    if (me == nullptr) {
+                        continue;
+                    }
+                    m_measurements.extendLifetime(*me, m_lifetime - idleTime);
+
+                    // records are least recently used first, so the LRU order is rebuilt by insertion
+                    NamespaceInfo& info = insertNamespaceInfo(*me, now - idleTime);
+                    for (const auto& score : record.scores) {
+                        NamespaceInfo::Slot slot = info.getOrCreateFace(score.first);
+                        info.m_scs[slot] = score.second;
+                        info.m_lastEpoch[slot] = m_epoch;
+                        info.m_lastUpdate[slot] = now - elapsed;
+                    }
+                    ++nImported;
+                }
+
+                evict(now);
+                CLF_LOG_DEBUG("Imported " << nImported << " of " << records.size() << " namespaces saved "
+                              << elapsed << " ago");
+                return nImported;
             }
 
 //            ndn::Location
@@ -317,31 +406,17 @@ namespace nfd {
 
 // called when data comes back with a prefix announcement
             void
-            VanetMeasurements::updateScoreAndLocation(const fib::Entry& fibEntry, ndn::Name namePrefix,
-                                                      ndn::Name annPrefix, FaceId faceId)
+            VanetMeasurements::updateScoreAndLocation(const Name& annPrefix, FaceId faceId)
             {
-                FaceInfo& faceInfo = getOrCreateFaceInfo(fibEntry, annPrefix, faceId);
-
                 // also need to update the score of the prefix's parents
                 measurements::Entry* currentMe = m_measurements.get(annPrefix);
 
                 BOOST_ASSERT(currentMe != nullptr);
 
+                auto now = m_timers.now();
                 while(currentMe != nullptr) {
-                    //NFD_LOG_DEBUG("Updating score for: " << currentMe->getName());
-
-                    // get or create face info, which in turn will get or create name space info
-                    FaceInfo& faceInfo = getOrCreateFaceInfo(fibEntry,currentMe->getName(), faceId);
-
-                    // update score for this entry
-                    //faceInfo.updateScore(currentMe->getName());
-                    //faceInfo.rescheduleScoreDecay(faceInfo, faceId, currentMe->getName());
-
-//                    if (currentMe->getName() == annPrefix) {
-//                        // update location info
-//                        NFD_LOG_DEBUG("Updating location info for: " << currentMe->getName());
-//                        faceInfo.updateLocation(annPrefix, destLocation);
-//                    }
+                    // get or create face statistics of the entry itself, without looking it up again by name
+                    insertNamespaceInfo(*currentMe, now).getOrCreateFace(faceId);
 
                     // Set or update entry lifetime
                     extendLifetime(*currentMe);
@@ -349,151 +424,139 @@ namespace nfd {
                     // go to next parent
                     currentMe = m_measurements.getParent(*currentMe);
                 }
-            }
-
-// called when PIT expires; update score for longest matched entry (can be deleted; not used anymore))
-            void
-            VanetMeasurements::updateScoreAndLocationLongestMatched(const fib::Entry& fibEntry, ndn::Name namePrefix,
-                                                                    FaceId faceId)
-            {
-                measurements::Entry* currentMe = m_measurements.get(namePrefix);
-                NamespaceInfo* namespaceInfo = currentMe->getStrategyInfo<NamespaceInfo>();
-                for (size_t prefixLen = namePrefix.size();
-                     namespaceInfo == nullptr && prefixLen > 0; --prefixLen) {
-                    //NFD_LOG_DEBUG(namePrefix.getPrefix(prefixLen));
-
-                    currentMe = m_measurements.get(namePrefix.getPrefix(prefixLen));
-                    namespaceInfo = currentMe->getStrategyInfo<NamespaceInfo>();
-                }
 
-                if (namespaceInfo != nullptr) {
-                    NFD_LOG_DEBUG("Longest matching measurement entry for prefix " << namePrefix.toUri() << " is " << currentMe->getName().toUri());
-
-                    // also need to update the score of the longest-matched prefix's parents
-                    while(currentMe != nullptr) {
-                        NFD_LOG_DEBUG("Updating score for: " << currentMe->getName());
-
-                        namespaceInfo = currentMe->getStrategyInfo<NamespaceInfo>();
-                        FaceInfo* faceInfo = namespaceInfo->get(faceId);
-                        faceInfo->updateScore(currentMe->getName());
-
-                        // Set or update entry lifetime
-                        extendLifetime(*currentMe);
-
-                        currentMe = m_measurements.getParent(*currentMe);
-                    }
-                }
-                else {
-                    NFD_LOG_DEBUG("Measurement entry for prefix " << namePrefix.toUri() << " not found.");
-                }
+                evict(now);
             }
 
 // called when forwarding interest; increment interest count for longest matched entry
             void
-            VanetMeasurements::incrementInterestCount(const fib::Entry& fibEntry, ndn::Name namePrefix,
+            VanetMeasurements::incrementInterestCount(const fib::Entry& fibEntry, const pit::Entry& pitEntry,
                                                       FaceId faceId)
             {
+                measurements::Entry* me = m_measurements.findLongestPrefixMatch(pitEntry,
+                                                measurements::EntryWithStrategyInfo<NamespaceInfo>());
 
-                measurements::Entry* currentMe = m_measurements.get(namePrefix);
-                NamespaceInfo* namespaceInfo = currentMe->getStrategyInfo<NamespaceInfo>();
-                for (size_t prefixLen = namePrefix.size();
-                     namespaceInfo == nullptr && prefixLen > 0; --prefixLen) {
-                    //NFD_LOG_DEBUG(namePrefix.getPrefix(prefixLen));
-
-                    currentMe = m_measurements.get(namePrefix.getPrefix(prefixLen));
-                    namespaceInfo = currentMe->getStrategyInfo<NamespaceInfo>();
-                }
-
-                if (namespaceInfo != nullptr) {
-                    NFD_LOG_DEBUG("Longest matching measurement entry for prefix " << namePrefix.toUri() << " is " << currentMe->getName().toUri());
-
-                    // also need to update the score of the prefix's parents
-                    while(currentMe != nullptr) {
-                        //NFD_LOG_DEBUG("Incrementing Interest count for: " << currentMe->getName());
-
-                        namespaceInfo = currentMe->getStrategyInfo<NamespaceInfo>();
-                        FaceInfo* faceInfo = namespaceInfo->get(faceId);
-                        faceInfo->incrementInterestCount(currentMe->getName());
-
-                        // insert the name to the list
-                        nameList.insert(currentMe->getName());
-
-                        // Set or update entry lifetime
-                        extendLifetime(*currentMe);
-
-                        currentMe = m_measurements.getParent(*currentMe);
-                    }
+                if (me != nullptr) {
+                    CLF_LOG_DEBUG("Longest matching measurement entry for " << pitEntry.getName() << " is " << me->getName());
                 }
                 else {
-                    NFD_LOG_DEBUG("Measurement entry for prefix " << namePrefix.toUri() << " not found. First interest. Create root prefix's measurement entry.");
-                    // create root entry and increment its interest count (hardcoded for now)
-                    FaceInfo& faceInfo = getOrCreateFaceInfo(fibEntry,ndn::Name("/test"), faceId);
-                    faceInfo.incrementInterestCount(ndn::Name("/test"));
-                    //scheduler::schedule(VanetMeasurements::SCORE_DECAY_TIME, [&] { updateScoreBfs(); });
-                    ns3::Simulator::Schedule(ns3::Seconds(6), &VanetMeasurements::updateScoreBfs, this);
+                    // first Interest in this namespace: count it at the FIB entry's prefix, which
+                    // is an ancestor of every prefix announced later
+                    CLF_LOG_DEBUG("Measurement entry for " << pitEntry.getName() << " not found. First interest. Create root prefix's measurement entry.");
+                    me = m_measurements.get(fibEntry);
+                    if (me == nullptr) {
+                        // the FIB entry is outside of this strategy's namespace; this happens once per namespace,
+                        // so the Interest name without its version is computed only here
+                        me = m_measurements.get(pitEntry.getName().getPrefix(-1));
+                    }
+                    BOOST_ASSERT(me != nullptr);
                 }
+
+                // ancestors receive this count when the epoch is closed
+                auto now = m_timers.now();
+                NamespaceInfo& namespaceInfo = insertNamespaceInfo(*me, now);
+                namespaceInfo.incrementInterestCount(namespaceInfo.getOrCreateFace(faceId));
+                extendLifetime(*me);
+                markDirty(*me);
+                evict(now);
             }
 
 // called when forwarding data; increment data count for announced prefix
             void
-            VanetMeasurements::incrementDataCount(const fib::Entry& fibEntry, ndn::Name annPrefix,
-                                                  FaceId faceId)
+            VanetMeasurements::incrementDataCount(const Name& annPrefix, FaceId faceId)
             {
-                FaceInfo& faceInfo = getOrCreateFaceInfo(fibEntry, annPrefix, faceId);
-
-                // also need to update the score of the prefix's parents
-                measurements::Entry* currentMe = m_measurements.get(annPrefix);
+                measurements::Entry* me = m_measurements.get(annPrefix);
+                BOOST_ASSERT(me != nullptr);
+                extendLifetime(*me);
 
-                BOOST_ASSERT(currentMe != nullptr);
+                // ancestors receive this count when the epoch is closed
+                auto now = m_timers.now();
+                NamespaceInfo& namespaceInfo = insertNamespaceInfo(*me, now);
+                namespaceInfo.incrementDataCount(namespaceInfo.getOrCreateFace(faceId));
+                markDirty(*me);
+                evict(now);
+            }
 
-                while(currentMe != nullptr) {
-                    //NFD_LOG_DEBUG("Incrementing Data count for: " << currentMe->getName());
+            void
+            VanetMeasurements::markDirty(measurements::Entry& me)
+            {
+                // the epoch timer runs exactly while the dirty set is not empty
+                if (m_dirtyEntries.empty()) {
+                    m_scoreUpdateTimer = m_timers.schedule(SCORE_UPDATE_INTERVAL, [this] { updateDirtyScores(); });
+                }
+                m_dirtyEntries.insert(&me);
+            }
 
-                    // get or create face info, which in turn will get or create name space info
-                    FaceInfo& faceInfo = getOrCreateFaceInfo(fibEntry,currentMe->getName(), faceId);
-                    //NamespaceInfo* namespaceInfo = currentMe->insertStrategyInfo<NamespaceInfo>().first;
+            void
+            VanetMeasurements::updateDirtyScores()
+            {
+                ++m_epoch;
+                CLF_LOG_DEBUG("Closing epoch " << m_epoch << " with " << m_dirtyEntries.size() << " dirty entries");
+
+                struct Counts
+                {
+                    measurements::Entry* me;
+                    FaceId faceId;
+                    int nInterests;
+                    int nData;
+                };
+
+                // snapshot the counts recorded on dirty entries before any propagation, so that an
+                // entry that is both dirty and an ancestor of another dirty entry is not counted twice
+                std::vector<Counts> ownCounts;
+                for (measurements::Entry* me : m_dirtyEntries) {
+                    NamespaceInfo* namespaceInfo = me->getStrategyInfo<NamespaceInfo>();
+                    if (namespaceInfo == nullptr) {
+                        continue;
+                    }
+                    for (NamespaceInfo::Slot slot = 0; slot < namespaceInfo->size(); ++slot) {
+                        if (namespaceInfo->hasCounts(slot)) {
+                            ownCounts.push_back({me, namespaceInfo->getFaceId(slot),
+                                                 namespaceInfo->getInterestCount(slot),
+                                                 namespaceInfo->getDataCount(slot)});
+                        }
+                    }
+                }
 
-                    // update score for this entry
-                    faceInfo.incrementDataCount(currentMe->getName());
+                std::unordered_set<measurements::Entry*> touched(m_dirtyEntries);
+                m_dirtyEntries.clear();
 
-                    // insert the name to the list
-                    nameList.insert(currentMe->getName());
+                auto now = m_timers.now();
 
-                    // Set or update entry lifetime
-                    extendLifetime(*currentMe);
+                for (const Counts& counts : ownCounts) {
+                    for (measurements::Entry* ancestor = m_measurements.getParent(*counts.me);
+                         ancestor != nullptr; ancestor = m_measurements.getParent(*ancestor)) {
+                        NamespaceInfo& namespaceInfo = insertNamespaceInfo(*ancestor, now);
+                        namespaceInfo.addCounts(namespaceInfo.getOrCreateFace(counts.faceId),
+                                                counts.nInterests, counts.nData);
 
-                    // go to next parent
-                    currentMe = m_measurements.getParent(*currentMe);
+                        // an ancestor that is already touched has been extended by another descendant
+                        if (touched.insert(ancestor).second) {
+                            extendLifetime(*ancestor);
+                        }
+                    }
                 }
-            }
 
-            void
-            VanetMeasurements::updateScoreBfs()
-            {
-                NFD_LOG_DEBUG("");
-                ndn::Name root("/test");
-                fib::Entry fibEntry(ndn::Name("/"));
-                FaceId faceId = 257;
-                FaceInfo& faceInfo = getOrCreateFaceInfo(fibEntry, root, faceId);
-
-                measurements::Entry* rootMe = m_measurements.get(root);
-                std::vector<measurements::Entry*> allNodesMe = m_measurements.getAllNodesMe(*rootMe);
-
-                for (auto node : allNodesMe) {
-                    if (nameList.find(node->getName()) != nameList.end()) {
-                        NFD_LOG_DEBUG("Updating Node: " << node->getName());
-                        FaceInfo& faceInfo = getOrCreateFaceInfo(fibEntry,node->getName(), faceId);
-                        faceInfo.updateScore(node->getName());
+                for (measurements::Entry* me : touched) {
+                    NamespaceInfo* namespaceInfo = me->getStrategyInfo<NamespaceInfo>();
+                    if (namespaceInfo == nullptr) {
+                        continue;
+                    }
+                    for (NamespaceInfo::Slot slot = 0; slot < namespaceInfo->size(); ++slot) {
+                        if (namespaceInfo->hasCounts(slot)) {
+                            namespaceInfo->updateScore(slot, me->getName(), m_epoch, now, m_scoreParams);
+                        }
                     }
                 }
 
-                ns3::Simulator::Schedule(ns3::Seconds(6), &VanetMeasurements::updateScoreBfs, this);
+                evict(now);
+                CLF_LOG_DEBUG("Tracking " << m_lru.size() << " namespaces in " << m_memoryUsage << " bytes");
             }
 
             void
             VanetMeasurements::extendLifetime(measurements::Entry& me)
             {
-                m_measurements.extendLifetime(me, MEASUREMENTS_LIFETIME);
+                m_measurements.extendLifetime(me, m_lifetime);
             }
 
         } // vanet
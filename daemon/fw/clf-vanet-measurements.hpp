@@ -27,56 +27,20 @@
 #define NFD_DAEMON_FW_VANET_MEASUREMENTS_HPP
 
 #include "fw/strategy-info.hpp"
+#include "fw/clf-timer.hpp"
 #include "table/measurements-accessor.hpp"
 
+#include <boost/container/small_vector.hpp>
+
+#include <list>
+
 //#include <ndn-cxx/location.hpp>
 
 namespace nfd {
     namespace fw {
         namespace clf {
 
-            class CsStats {
-            public:
-                typedef double Cscore;
-
-                CsStats();
-
-                Cscore
-                getCs() const {
-                    return m_cs;
-                }
-
-                Cscore
-                getScs() const {
-                    return m_scs;
-                }
-
-                void
-                incrementInterestCount(ndn::Name prefix);
-
-                void
-                incrementDataCount(ndn::Name prefix);
-
-                void
-                updateScore(ndn::Name);
-
-                void
-                decayScore();
-
-//                void
-//                updateLocation(ndn::Name namePrefix, ndn::Location dl);
-
-            private:
-                static Cscore
-                computeScs(Cscore previousCscore, Cscore currentCscore);
-
-                int m_noOfInterest;
-                int m_noOfData;
-                Cscore m_cs;
-                Cscore m_scs;
-
-                static const double ALPHA;
-            };
+            class VanetMeasurements;
 
 //            class DestLocationInfo {
 //            public:
@@ -94,167 +58,276 @@ namespace nfd {
 ////                ndn::Location m_destLocation;
 //            };
 
-            class FaceInfo {
-            public:
-                class Error : public std::runtime_error {
-                public:
-                    explicit
-                    Error(const std::string &what)
-                            : std::runtime_error(what) {
-                    }
-                };
+            /** \brief constants of the centrality scores, which can be set per strategy instance
+             */
+            struct ScoreParameters {
+                double alpha = 0.125; ///< weight of the last epoch's centrality score in the SCS
+                double r = 0.9; ///< factor by which the SCS decays every decayPeriod without update
+                time::nanoseconds decayPeriod = 10_s;
+            };
 
-                FaceInfo();
+            /** \brief centrality scores of a namespace on each face
+             *
+             *  Interest and Data counts are accumulated during a scoring epoch and folded into the
+             *  smoothed centrality score (SCS) when the epoch is closed. An epoch without traffic
+             *  contributes a centrality score of zero; such epochs are not visited one by one, but
+             *  applied in closed form the next time the score is updated or read.
+             *
+             *  In addition, the SCS decays by ScoreParameters::r every ScoreParameters::decayPeriod
+             *  since it was last updated. The decay is also computed when the score is read, so no
+             *  timer is needed per namespace and face.
+             *
+             *  Per-face statistics are stored as a structure of arrays indexed by face slot. Up to
+             *  N_INLINE_FACES faces are stored inline, so a face is found by scanning a few
+             *  contiguous FaceIds, without any other allocation than the StrategyInfo itself.
+             *
+             *  A NamespaceInfo created by VanetMeasurements is tracked by it for eviction, and
+             *  removes itself from the tracking when its measurement entry is erased.
+             */
+            class NamespaceInfo : public StrategyInfo {
+            public:
+                typedef double Cscore;
+                typedef size_t Slot;
 
-                void
-                recordCs(const shared_ptr <pit::Entry> &pitEntry, const Face &inFace);
+                static constexpr Slot INVALID_SLOT = std::numeric_limits<Slot>::max();
+                static constexpr size_t N_INLINE_FACES = 4;
 
-                void
-                updateScore(ndn::Name);
+                NamespaceInfo();
 
-                void
-                incrementInterestCount(ndn::Name prefix);
+                ~NamespaceInfo() override;
 
-                void
-                incrementDataCount(ndn::Name prefix);
+                static constexpr int
+                getTypeId() {
+                    return 1080;
+                }
 
-                void
-                decayScore();
+                /** \return number of faces with statistics in this namespace
+                 */
+                size_t
+                size() const {
+                    return m_faceIds.size();
+                }
 
-//
+                /** \return slot of \p faceId, or INVALID_SLOT if the face has no statistics
+                 */
+                Slot
+                findFace(FaceId faceId) const;
 
-                void
-                rescheduleScoreDecay(FaceInfo &info, FaceId faceId, ndn::Name prefix);
+                Slot
+                getOrCreateFace(FaceId faceId);
 
-                CsStats::Cscore
-                getCs() const {
-                    return m_csStats.getCs();
+                FaceId
+                getFaceId(Slot slot) const {
+                    return m_faceIds[slot];
                 }
 
-                CsStats::Cscore
-                getScs() const {
-                    return m_csStats.getScs();
+                int
+                getInterestCount(Slot slot) const {
+                    return m_nInterests[slot];
                 }
 
-//                ndn::Location
-//                getDestLocation() const {
-//                    return m_destLocationInfo.getDestLocation();
-//                }
-
-                void
-                setScoreDecayEventId(const scheduler::EventId &eId) {
-                    m_scoreDecayEventId = eId;
+                int
+                getDataCount(Slot slot) const {
+                    return m_nData[slot];
                 }
 
-                const scheduler::EventId &
-                getScoreDecayEventId() {
-                    return m_scoreDecayEventId;
+                bool
+                hasCounts(Slot slot) const {
+                    return m_nInterests[slot] != 0 || m_nData[slot] != 0;
                 }
 
-            private:
-                CsStats m_csStats;
-//                DestLocationInfo m_destLocationInfo;
-
-                scheduler::EventId m_scoreDecayEventId;
-            };
-
-            typedef std::unordered_map <FaceId, FaceInfo> FaceInfoTable;
-
-            class NamespaceInfo : public StrategyInfo {
-            public:
-                NamespaceInfo();
-
-                static constexpr int
-                getTypeId() {
-                    return 1080;
+                void
+                incrementInterestCount(Slot slot) {
+                    ++m_nInterests[slot];
                 }
 
-                FaceInfo &
-                getOrCreateFaceInfo(const fib::Entry &fibEntry, FaceId faceId);
-
-                FaceInfo *
-                getFaceInfo(const fib::Entry &fibEntry, FaceId faceId);
-
                 void
-                rescheduleScoreDecay(FaceInfo &, FaceId, ndn::Name);
-
-                FaceInfo *
-                get(FaceId faceId) {
-                    if (m_fit.find(faceId) != m_fit.end()) {
-                        return &m_fit.at(faceId);
-                    } else {
-                        return nullptr;
-                    }
+                incrementDataCount(Slot slot) {
+                    ++m_nData[slot];
                 }
 
-                FaceInfoTable::iterator
-                find(FaceId faceId) {
-                    return m_fit.find(faceId);
+                /** \brief add counts propagated from a descendant namespace
+                 */
+                void
+                addCounts(Slot slot, int nInterests, int nData) {
+                    m_nInterests[slot] += nInterests;
+                    m_nData[slot] += nData;
                 }
 
-                FaceInfoTable::iterator
-                end() {
-                    return m_fit.end();
+                Cscore
+                getCs(Slot slot) const {
+                    return m_cs[slot];
                 }
 
-                const FaceInfoTable::iterator
-                insert(FaceId faceId) {
-                    return m_fit.emplace(faceId, FaceInfo()).first;
-                }
+                /** \return the smoothed centrality score as of the end of \p epoch, decayed to \p now
+                 */
+                Cscore
+                getScs(Slot slot, uint64_t epoch, time::steady_clock::TimePoint now,
+                       const ScoreParameters &params = ScoreParameters()) const;
 
+                /** \brief close \p epoch: fold the counts into the SCS and reset them
+                 */
                 void
-                setDestination(double lat, double longi) {
-                    m_destination = std::make_pair(lat, longi);
-                }
+                updateScore(Slot slot, const Name &prefix, uint64_t epoch, time::steady_clock::TimePoint now,
+                            const ScoreParameters &params = ScoreParameters());
 
-                std::pair<double, double>
-                getDestination() const {
-                    return m_destination;
-                }
+                /** \return approximate number of bytes used by this NamespaceInfo
+                 */
+                size_t
+                getMemoryUsage() const;
+
+            private:
+                static Cscore
+                computeScs(double alpha, Cscore currentCscore, Cscore previousCscore);
 
             private:
-                FaceInfoTable m_fit;
-                std::pair<double, double> m_destination; // lat, long. todo: make it a list of destination
+                template<typename T>
+                using FaceArray = boost::container::small_vector<T, N_INLINE_FACES>;
+
+                FaceArray<FaceId> m_faceIds;
+                FaceArray<int> m_nInterests;
+                FaceArray<int> m_nData;
+                FaceArray<Cscore> m_cs;
+                FaceArray<Cscore> m_scs;
+                FaceArray<uint64_t> m_lastEpoch; // epoch in which m_scs was last updated
+                FaceArray<time::steady_clock::TimePoint> m_lastUpdate; // time at which m_scs was last updated
+
+                // tracking by VanetMeasurements
+                VanetMeasurements *m_owner = nullptr;
+                measurements::Entry *m_entry = nullptr;
+                time::steady_clock::TimePoint m_lastUsed;
+                std::list<NamespaceInfo *>::iterator m_lruIt;
+
+                friend class VanetMeasurements;
             };
 
+            /** \brief per-namespace centrality scores of the CLF strategy
+             *
+             *  A forwarded Interest or Data only touches the measurement entry it matches, and
+             *  marks that entry dirty. Every SCORE_UPDATE_INTERVAL, the counts of the dirty entries
+             *  are propagated to their ancestors and the scores of all touched entries are updated,
+             *  each entry once. Entries without traffic are not visited at all, and the timer is
+             *  stopped while the dirty set is empty.
+             *
+             *  The number of NamespaceInfo is bounded by maxEntries: they are kept in least recently
+             *  used order, and the least recently used ones are erased when the bound is exceeded or
+             *  when they have not been used for the lifetime. Eviction only looks at the tail of the
+             *  LRU list after each update, so no scan of the measurements is ever needed.
+             */
             class VanetMeasurements : noncopyable {
             public:
-                explicit
-                VanetMeasurements(MeasurementsAccessor &measurements);
+                /** \brief the scores of a namespace, keyed by the FaceIds of this process
+                 *
+                 *  StateSnapshot translates the FaceIds to FaceUris when saving, and back when restoring.
+                 */
+                struct NamespaceRecord {
+                    Name prefix;
+                    time::nanoseconds idleTime; ///< time since the namespace was last used
+                    std::vector<std::pair<FaceId, NamespaceInfo::Cscore>> scores; ///< SCS on each face
+                };
 
-                FaceInfo *
-                getFaceInfo(const fib::Entry &fibEntry, FaceId faceId);
+                /** \throw std::invalid_argument \p maxEntries is zero, \p lifetime is not longer
+                 *         than SCORE_UPDATE_INTERVAL, or \p scoreParams are out of range
+                 */
+                VanetMeasurements(MeasurementsAccessor &measurements, TimerBackend &timers,
+                                  size_t maxEntries = DEFAULT_MAX_ENTRIES,
+                                  time::nanoseconds lifetime = MEASUREMENTS_LIFETIME,
+                                  const ScoreParameters &scoreParams = ScoreParameters());
 
-                FaceInfo &
-                getOrCreateFaceInfo(const fib::Entry &fibEntry, ndn::Name name, FaceId faceId);
+                ~VanetMeasurements();
 
                 NamespaceInfo *
                 getNamespaceInfo(const Name &prefix);
 
                 NamespaceInfo &
-                getOrCreateNamespaceInfo(const fib::Entry &fibEntry, const ndn::Name name);
+                getOrCreateNamespaceInfo(const Name &prefix);
 
-//                void
-//                updateScoreAndLocation(const fib::Entry &fibEntry, ndn::Name namePrefix, ndn::Name annPrefix,
-//                                       ndn::Location destLocation, FaceId faceId);
+                /** \brief make sure \p annPrefix and its ancestors have statistics on \p faceId
+                 */
                 void
-                updateScoreAndLocation(const fib::Entry &fibEntry, ndn::Name namePrefix, ndn::Name annPrefix,
-                                       FaceId faceId);
+                updateScoreAndLocation(const Name &annPrefix, FaceId faceId);
 
+                /** \brief count an Interest of \p pitEntry forwarded on \p faceId
+                 *
+                 *  The count goes to the longest namespace with scores matching the Interest, found
+                 *  through the name tree entry of \p pitEntry, so the name is neither copied nor hashed.
+                 */
                 void
-                updateScoreAndLocationLongestMatched(const fib::Entry &fibEntry, ndn::Name namePrefix,
-                                                     FaceId faceId);
-
-                void
-                incrementInterestCount(const fib::Entry &fibEntry, ndn::Name namePrefix,
+                incrementInterestCount(const fib::Entry &fibEntry, const pit::Entry &pitEntry,
                                        FaceId faceId);
 
                 void
-                incrementDataCount(const fib::Entry &fibEntry, ndn::Name namePrefix,
-                                   FaceId faceId);
+                incrementDataCount(const Name &annPrefix, FaceId faceId);
 
+                /** \return smoothed centrality score on \p faceId of the longest namespace with scores
+                 *          matching the Interest of \p pitEntry, or 0 if there is none
+                 */
                 double
-                getCs(const fib::Entry &fibEntry, FaceId faceId, ndn::Name namePrefix);
+                getCs(const pit::Entry &pitEntry, FaceId faceId) const;
+
+                /** \return the highest smoothed centrality score on any face of the longest namespace
+                 *          with scores matching \p name, or nullopt if there is none
+                 */
+                optional<double>
+                getCentrality(const Name &name) const;
+
+                const ScoreParameters &
+                getScoreParameters() const {
+                    return m_scoreParams;
+                }
+
+                /** \return the timers that epochs are scheduled on, whose clock times the scores
+                 */
+                TimerBackend &
+                getTimers() const {
+                    return m_timers;
+                }
+
+                /** \return index of the last closed scoring epoch
+                 */
+                uint64_t
+                getEpoch() const {
+                    return m_epoch;
+                }
+
+                /** \return number of measurement entries with counts pending for the next epoch
+                 */
+                size_t
+                getNDirtyEntries() const {
+                    return m_dirtyEntries.size();
+                }
+
+                /** \return number of NamespaceInfo
+                 */
+                size_t
+                size() const {
+                    return m_lru.size();
+                }
+
+                /** \return approximate number of bytes used by all NamespaceInfo
+                 */
+                size_t
+                getMemoryUsage() const {
+                    return m_memoryUsage;
+                }
+
+                /** \return the scores of every namespace, decayed to \p now, least recently used first
+                 */
+                std::vector<NamespaceRecord>
+                exportScores(time::steady_clock::TimePoint now = time::steady_clock::now()) const;
+
+                /** \brief restore scores exported \p elapsed ago
+                 *
+                 *  Restored scores keep decaying as if they had been updated \p elapsed ago, and a
+                 *  namespace that has been idle for longer than the lifetime is not restored. Prefixes
+                 *  outside of this strategy's namespace are skipped.
+                 *  \param records scores on the FaceIds of existing faces
+                 *  \pre no namespace has scores yet
+                 *  \return number of restored namespaces
+                 */
+                size_t
+                importScores(const std::vector<NamespaceRecord> &records, time::nanoseconds elapsed,
+                             time::steady_clock::TimePoint now = time::steady_clock::now());
 
 //                ndn::Location
 //                getDestLocationInfo(const fib::Entry &fibEntry, ndn::Name namePrefix, FaceId faceId);
@@ -263,19 +336,58 @@ namespace nfd {
                 void
                 extendLifetime(measurements::Entry &me);
 
+                /** \brief get or create the NamespaceInfo of \p me, and mark it most recently used
+                 */
+                NamespaceInfo &
+                insertNamespaceInfo(measurements::Entry &me, time::steady_clock::TimePoint now);
+
+                /** \brief stop tracking \p info, which is being destroyed
+                 */
+                void
+                detach(NamespaceInfo &info);
+
+                /** \brief erase least recently used NamespaceInfo beyond maxEntries or lifetime
+                 */
+                void
+                evict(time::steady_clock::TimePoint now);
+
+                void
+                markDirty(measurements::Entry &me);
+
+                /** \brief close the current epoch
+                 *
+                 *  Counts of dirty entries are added to every ancestor, then every entry that
+                 *  received counts has its score updated once.
+                 */
                 void
-                updateScoreBfs();
+                updateDirtyScores();
 
             public:
                 static constexpr time::microseconds
-                SCORE_DECAY_TIME = 10_s;
-                static constexpr double R = 0.9;
+                MEASUREMENTS_LIFETIME = 600_s;
                 static constexpr time::microseconds
-                MEASUREMENTS_LIFETIME = 3000_s;
+                SCORE_UPDATE_INTERVAL = 6_s;
+                static constexpr size_t DEFAULT_MAX_ENTRIES = 4096;
 
             private:
                 MeasurementsAccessor &m_measurements;
-                std::set <ndn::Name> nameList;
+                TimerBackend &m_timers;
+                TimerId m_scoreUpdateTimer;
+                size_t m_maxEntries;
+                time::nanoseconds m_lifetime;
+                ScoreParameters m_scoreParams;
+
+                // Dirty entries have been extended by m_lifetime, which is longer than
+                // SCORE_UPDATE_INTERVAL, so they are still alive when the epoch is closed.
+                // An entry whose NamespaceInfo is erased is removed from this set.
+                std::unordered_set <measurements::Entry *> m_dirtyEntries;
+                uint64_t m_epoch;
+
+                // front is the most recently used
+                std::list<NamespaceInfo *> m_lru;
+                size_t m_memoryUsage;
+
+                friend class NamespaceInfo;
             };
 
         } // namespace vanet
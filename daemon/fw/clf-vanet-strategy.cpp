@@ -25,14 +25,10 @@
 
 #include "clf-vanet-strategy.hpp"
 #include "algorithm.hpp"
-#include "core/logger.hpp"
+#include "clf-logger.hpp"
 
 #include <ndn-cxx/lp/tags.hpp>
 
-#include "ns3/simulator.h"
-#include "ns3/nstime.h"
-#include "ns3/event-id.h"
-
 #include <random>
 
 namespace nfd {
@@ -43,194 +39,396 @@ namespace nfd {
 
             NFD_LOG_INIT(ClfStrategy);
 
-            const double ClfStrategy::ALPHA = 0.5;
+            std::ostream &
+            operator<<(std::ostream &os, ForwardingMode mode) {
+                switch (mode) {
+                    case ForwardingMode::BROADCAST:
+                        return os << "broadcast";
+                    case ForwardingMode::VNDN:
+                        return os << "vndn";
+                    case ForwardingMode::NAVIGO:
+                        return os << "navigo";
+                    case ForwardingMode::CLF:
+                        return os << "clf";
+                }
+                return os << static_cast<int>(mode);
+            }
+
+            ForwardingMode
+            parseForwardingMode(const std::string &mode) {
+                if (mode == "broadcast") {
+                    return ForwardingMode::BROADCAST;
+                }
+                if (mode == "vndn") {
+                    return ForwardingMode::VNDN;
+                }
+                if (mode == "navigo") {
+                    return ForwardingMode::NAVIGO;
+                }
+                if (mode == "clf") {
+                    return ForwardingMode::CLF;
+                }
+                BOOST_THROW_EXCEPTION(std::invalid_argument("Unknown forwarding mode '" + mode + "'"));
+            }
+
+            constexpr time::nanoseconds ClfStrategy::DEFAULT_SNAPSHOT_INTERVAL;
 
             ClfStrategy::ClfStrategy(Forwarder &forwarder, const Name &name)
-                    : Strategy(forwarder), m_measurements(getMeasurements())
-            //, m_scheduler(m_ioService)
+                    : Strategy(forwarder)
+                    , m_params(parseParameters(parseInstanceName(name).parameters))
+                    , m_cs(forwarder.getCs())
+                    , m_timers(makeTimerBackend(m_params.timerBackend))
+                    , m_measurements(getMeasurements(), *m_timers, m_params.maxEntries, m_params.lifetime,
+                                     m_params.scoreParams)
+                    , m_deferredInterests(*m_timers)
+                    , m_prefixLocation(PrefixLocationTree::DEFAULT_CELL_SIZE, m_params.maxEntries, m_params.lifetime)
+                    , m_contention(m_neighbors, m_params.contentionMode, &getFaceTable())
             {
                 ParsedInstanceName parsed = parseInstanceName(name);
-                if (!parsed.parameters.empty()) {
-                    BOOST_THROW_EXCEPTION(std::invalid_argument("ClfStrategy does not accept parameters"));
-                }
                 if (parsed.version && *parsed.version != getStrategyName()[-1].toVersion()) {
                     BOOST_THROW_EXCEPTION(std::invalid_argument(
                             "ClfStrategy does not support version " + to_string(*parsed.version)));
                 }
                 this->setInstanceName(makeInstanceName(name, getStrategyName()));
+
+                m_deferredInterests.setCoalescingWindow(m_params.coalescingWindow);
+                m_deferredInterests.setActionCallback([this] (const DeferredAction &action, time::nanoseconds delay) {
+                    onDeferredForwarding(action, delay);
+                });
+
+                if (!m_params.snapshotPath.empty()) {
+                    m_snapshotTimer = m_timers->schedule(time::nanoseconds::zero(), [this] { restoreSnapshot(); });
+                }
+
+                for (const Face &face : getFaceTable()) {
+                    overhearFace(face);
+                }
+                m_afterAddFaceConn = afterAddFace.connect([this] (const Face &face) { overhearFace(face); });
+                m_beforeRemoveFaceConn = beforeRemoveFace.connect([this] (const Face &face) {
+                    m_overhearConns.erase(face.getId());
+                    m_deferredInterests.cancelBatch(face.getId());
+                    m_neighbors.eraseFace(face.getId());
+                    m_contention.eraseFace(face.getId());
+                });
+
+                // the centrality scores drive the admission of the centrality CS policy
+                m_cs.setCentralitySource(this, [this] (const Name &dataName) {
+                    return m_measurements.getCentrality(dataName);
+                });
+
+                NFD_LOG_INFO("Forwarding mode " << m_params.mode << " for " << getInstanceName());
+                CLF_LOG_DEBUG("timer=" << m_timers->getName() << " alpha=" << m_params.alpha
+                                       << " smoothing=" << m_params.scoreParams.alpha
+                                       << " r=" << m_params.scoreParams.r
+                                       << " decay=" << m_params.scoreParams.decayPeriod
+                                       << " timer-scale=" << m_params.timerScale
+                                       << " distance=" << m_params.distanceMode
+                                       << " contention=" << m_params.contentionMode
+                                       << " limit=" << m_params.maxEntries << " lifetime=" << m_params.lifetime
+                                       << " coalesce=" << m_params.coalescingWindow
+                                       << " snapshot=" << m_params.snapshotPath);
             }
 
-            const Name &
-            ClfStrategy::getStrategyName() {
-                static Name strategyName("/localhost/nfd/strategy/clf/%FD%03");
-                return strategyName;
+            ClfStrategy::~ClfStrategy() {
+                m_cs.setCentralitySource(this, nullptr);
+
+                m_snapshotTimer.cancel();
+                if (m_hasRestoredSnapshot) {
+                    saveSnapshot();
+                }
+            }
+
+            ClfStrategy::Parameters
+            ClfStrategy::parseParameters(const PartialName &parsed) {
+                Parameters params;
+                for (const auto &component : parsed) {
+                    std::string parsedStr(reinterpret_cast<const char *>(component.value()), component.value_size());
+                    auto n = parsedStr.find("~");
+                    if (n == std::string::npos) {
+                        BOOST_THROW_EXCEPTION(std::invalid_argument("Format is <parameter>~<value>"));
+                    }
+
+                    auto f = parsedStr.substr(0, n);
+                    auto s = parsedStr.substr(n + 1);
+                    if (f == "mode") {
+                        params.mode = parseForwardingMode(s);
+                    } else if (f == "alpha") {
+                        params.alpha = parseFraction(f, s, true);
+                    } else if (f == "smoothing") {
+                        params.scoreParams.alpha = parseFraction(f, s, false);
+                    } else if (f == "r") {
+                        params.scoreParams.r = parseFraction(f, s, false);
+                    } else if (f == "decay") {
+                        params.scoreParams.decayPeriod = time::seconds(parsePositiveInteger(f, s));
+                    } else if (f == "timer-scale") {
+                        double scale = 0;
+                        if (!boost::conversion::try_lexical_convert(s, scale) || !(scale > 0) || std::isinf(scale)) {
+                            BOOST_THROW_EXCEPTION(std::invalid_argument("Value of timer-scale must be a positive number"));
+                        }
+                        params.timerScale = scale;
+                    } else if (f == "timer") {
+                        params.timerBackend = s;
+                    } else if (f == "distance") {
+                        params.distanceMode = parseDistanceMode(s);
+                    } else if (f == "contention") {
+                        params.contentionMode = parseContentionMode(s);
+                    } else if (f == "limit") {
+                        params.maxEntries = parsePositiveInteger(f, s);
+                    } else if (f == "lifetime") {
+                        params.lifetime = time::seconds(parsePositiveInteger(f, s));
+                    } else if (f == "coalesce") {
+                        params.coalescingWindow = time::microseconds(parsePositiveInteger(f, s));
+                    } else if (f == "snapshot") {
+                        if (s.empty()) {
+                            BOOST_THROW_EXCEPTION(std::invalid_argument("Value of snapshot must be a file path"));
+                        }
+                        params.snapshotPath = s;
+                    } else if (f == "snapshot-interval") {
+                        params.snapshotInterval = time::seconds(parsePositiveInteger(f, s));
+                    } else {
+                        BOOST_THROW_EXCEPTION(std::invalid_argument(
+                                "Parameter should be mode, alpha, smoothing, r, decay, timer-scale, timer, distance, "
+                                "contention, limit, lifetime, coalesce, snapshot or snapshot-interval"));
+                    }
+                }
+                return params;
+            }
+
+            uint64_t
+            ClfStrategy::parsePositiveInteger(const std::string &parameter, const std::string &value) {
+                uint64_t n = 0;
+                if (value.empty() || value.find_first_not_of("0123456789") != std::string::npos ||
+                    !boost::conversion::try_lexical_convert(value, n) || n == 0) {
+                    BOOST_THROW_EXCEPTION(std::invalid_argument(
+                            "Value of " + parameter + " must be a positive integer"));
+                }
+                return n;
+            }
+
+            double
+            ClfStrategy::parseFraction(const std::string &parameter, const std::string &value, bool allowZero) {
+                double x = 0;
+                if (!boost::conversion::try_lexical_convert(value, x) || !(x >= 0 && x <= 1) ||
+                    (x == 0 && !allowZero)) {
+                    BOOST_THROW_EXCEPTION(std::invalid_argument(
+                            "Value of " + parameter + " must be a number in " + (allowZero ? "[0, 1]" : "(0, 1]")));
+                }
+                return x;
+            }
+
+            size_t
+            ClfStrategy::getMemoryUsage() const {
+                return m_measurements.getMemoryUsage() + m_prefixLocation.getMemoryUsage();
             }
 
             void
-            ClfStrategy::afterReceiveInterest(const Face &inFace, const Interest &interest,
-                                              const shared_ptr <pit::Entry> &pitEntry) {
-                //afterReceiveInterestBroadcast(inFace, interest, pitEntry);
-                //afterReceiveInterestVndn(inFace, interest, pitEntry);
-                //afterReceiveInterestNavigo(inFace, interest, pitEntry);
-                afterReceiveInterestClf(inFace, interest, pitEntry);
+            ClfStrategy::restoreSnapshot() {
+                try {
+                    StateSnapshot::load(m_params.snapshotPath).restore(m_measurements, m_prefixLocation, getFaceTable());
+                }
+                catch (const StateSnapshot::Error &e) {
+                    NFD_LOG_INFO("Starting without learned state: " << e.what());
+                }
+                m_hasRestoredSnapshot = true;
+                scheduleSnapshot();
             }
 
             void
-            ClfStrategy::afterReceiveData(const shared_ptr <pit::Entry> &pitEntry,
-                                          const Face &inFace, const Data &data) {
-                afterReceiveDataClf(pitEntry, inFace, data);
-                //afterReceiveDataNormal(pitEntry, inFace, data);
+            ClfStrategy::scheduleSnapshot() {
+                m_snapshotTimer = m_timers->schedule(m_params.snapshotInterval, [this] {
+                    saveSnapshot();
+                    scheduleSnapshot();
+                });
             }
 
             void
-            ClfStrategy::onLoopedInterest(const shared_ptr <pit::Entry> &pitEntry, const Face &inFace,
-                                          const Interest &interest) {
-                NFD_LOG_DEBUG(
-                        "onLoopedInterest inFace=" << inFace.getId() << " name=" << interest.getName() << " :Drop.");
+            ClfStrategy::saveSnapshot() {
+                try {
+                    StateSnapshot::capture(m_measurements, m_prefixLocation, getFaceTable()).save(m_params.snapshotPath);
+                }
+                catch (const StateSnapshot::Error &e) {
+                    NFD_LOG_WARN("Cannot save learned state: " << e.what());
+                }
+            }
 
-                // if we already received this interest and put it in the pool
-                if (m_scheduledInterstPool.find(interest.getName()) != m_scheduledInterstPool.end()) {
-                    // cancel scheduled interest
-                    ns3::Simulator::Cancel(m_scheduledInterstPool[interest.getName()]);
-                    // delete interest from m_scheduledInterstPool
-                    m_scheduledInterstPool.erase(m_scheduledInterstPool.find(interest.getName()));
+            void
+            ClfStrategy::overhearFace(const Face &face) {
+                if (face.getLinkType() != ndn::nfd::LINK_TYPE_AD_HOC) {
+                    return;
+                }
 
-                    // delete the corresponding PIT entry
-                    this->rejectPendingInterest(pitEntry);
+                FaceId faceId = face.getId();
+                OverhearConnections &conns = m_overhearConns[faceId];
+                conns.afterReceiveInterest = face.afterReceiveInterest.connect(
+                        [this, faceId] (const Interest &interest, const EndpointId &endpointId) {
+                            onOverheard(faceId, interest, endpointId);
+                            suppressOverheard(faceId, interest);
+                        });
+                conns.afterReceiveData = face.afterReceiveData.connect(
+                        [this, faceId] (const Data &data, const EndpointId &endpointId) {
+                            onOverheard(faceId, data, endpointId);
+                        });
+            }
 
-                    NFD_LOG_DEBUG(interest << ", cancel scheduled interest.");
+            template<typename Packet>
+            void
+            ClfStrategy::onOverheard(FaceId faceId, const Packet &packet, EndpointId endpointId) {
+                auto locationTag = face::getLocationTag(packet);
+                if (locationTag == nullptr) {
+                    return;
+                }
 
-                    // drop the current interest
+                // MyLocation of a received packet is the location of this node
+                const ndn::Location &myLocation = locationTag->get().getMyLocation();
+                if (myLocation.getLatitude() != 0 || myLocation.getLongitude() != 0) {
+                    m_myLocation = myLocation;
+                }
+
+                // the previous hop of a received packet is the neighbor that sent it
+                const ndn::Location &position = locationTag->get().getPrevLocation();
+                if (position.getLatitude() == 0 && position.getLongitude() == 0) {
                     return;
                 }
+                m_neighbors.update(faceId, endpointId, position);
             }
 
             void
-            ClfStrategy::onPitExpiration(const shared_ptr <pit::Entry> &pitEntry) {
-                const Interest &interest = pitEntry->getInterest();
-                NFD_LOG_DEBUG(interest.getName().toUri());
+            ClfStrategy::suppressOverheard(FaceId faceId, const Interest &interest) {
+                if (&interest == m_dispatchedInterest) {
+                    // the forwarder has passed this Interest to afterReceiveInterest, which counted it
+                    m_dispatchedInterest = nullptr;
+                    return;
+                }
 
-                FaceId faceId = 257; // hardcoded for now
-                const fib::Entry &fibEntry = this->lookupFib(*pitEntry);
-                ndn::Name namePrefix = interest.getName().getPrefix(interest.getName().size() - 1);
+                // the forwarder dropped this Interest without the strategy, e.g., a neighbor rebroadcast
+                // an Interest whose Nonce is in the PIT; the neighbor's transmission suppresses ours
+                if (m_deferredInterests.cancel(interest.getName(), getNameHash(interest))) {
+                    m_contention.recordInterest(faceId, true);
+                    m_contention.recordSuppressed(faceId);
+                    CLF_LOG_DEBUG(interest.getName() << " overheard on face " << faceId << ", cancel scheduled interest.");
+                }
+            }
 
-                //m_measurements.updateScoreAndLocationLongestMatched(fibEntry, namePrefix, faceId);
+            const Name &
+            ClfStrategy::getStrategyName() {
+                static Name strategyName("/localhost/nfd/strategy/clf/%FD%03");
+                return strategyName;
             }
 
             void
-            ClfStrategy::afterReceiveDataNormal(const shared_ptr <pit::Entry> &pitEntry,
-                                                const Face &inFace, const Data &data) {
-                NFD_LOG_DEBUG("afterReceiveData pitEntry=" << pitEntry->getName() <<
-                                                           " inFace=" << inFace.getId() << " data=" << data.getName());
-
-                // someone already responded with the data, cancel our scheduled interest
-                if (m_scheduledInterstPool.find(data.getName()) != m_scheduledInterstPool.end()) {
-                    // cancel scheduled interest
-                    ns3::Simulator::Cancel(m_scheduledInterstPool[data.getName()]);
-                    // delete interest from m_scheduledInterstPool
-                    m_scheduledInterstPool.erase(m_scheduledInterstPool.find(data.getName()));
+            ClfStrategy::afterReceiveInterest(const Interest &interest, const FaceEndpoint &ingress,
+                                              const shared_ptr <pit::Entry> &pitEntry) {
+                if (ingress.face.getLinkType() == ndn::nfd::LINK_TYPE_AD_HOC) {
+                    m_dispatchedInterest = &interest;
+                }
+                recordReceivedInterest(ingress.face, pitEntry);
+                switch (m_params.mode) {
+                    case ForwardingMode::BROADCAST:
+                        afterReceiveInterestBroadcast(interest, ingress, pitEntry);
+                        break;
+                    case ForwardingMode::VNDN:
+                        afterReceiveInterestVndn(interest, ingress, pitEntry);
+                        break;
+                    case ForwardingMode::NAVIGO:
+                        afterReceiveInterestNavigo(interest, ingress, pitEntry);
+                        break;
+                    case ForwardingMode::CLF:
+                        afterReceiveInterestClf(interest, ingress, pitEntry);
+                        break;
+                }
+            }
 
-                    NFD_LOG_DEBUG(data.getName() << ", cancel scheduled interest.");
+            void
+            ClfStrategy::afterReceiveData(const Data &data, const FaceEndpoint &ingress,
+                                          const shared_ptr <pit::Entry> &pitEntry) {
+                // only CLF learns prefix locations and centrality from the Data
+                if (m_params.mode == ForwardingMode::CLF) {
+                    afterReceiveDataClf(data, ingress, pitEntry);
+                } else {
+                    afterReceiveDataNormal(data, ingress, pitEntry);
                 }
+            }
 
-                ndn::Location myLocation(0, 0);
-                ndn::Location prevLocation(0, 0);
-                // if there is destination location in prefix to location table
-                //    destLocation =
-                // else
-                ndn::Location destLocation(0, 0);
+            void
+            ClfStrategy::afterReceiveDataNormal(const Data &data, const FaceEndpoint &ingress,
+                                                const shared_ptr <pit::Entry> &pitEntry) {
+                CLF_LOG_DEBUG("afterReceiveData pitEntry=" << pitEntry->getName() <<
+                                                           " inFace=" << ingress.face.getId() << " data=" << data.getName());
 
-                lp::LocationHeader lh;
-                lh.setMyLocation(myLocation);
-                lh.setPrevLocation(prevLocation);
-                lh.setDestLocation(destLocation);
+                // someone already responded with the data, cancel our scheduled interest
+                if (m_deferredInterests.cancel(pitEntry->getName(), getNameHash(*pitEntry))) {
+                    m_contention.recordSuppressed(ingress.face.getId());
+                    CLF_LOG_DEBUG(data.getName() << ", cancel scheduled interest.");
+                }
 
-                data.setTag(make_shared<lp::LocationTag>(lp::LocationHeader(lh)));
+                // TODO: set the destination location if it is in the prefix location table
+                data.setTag(m_unknownLocationTag);
 
-                this->beforeSatisfyInterest(pitEntry, inFace, data);
+                this->beforeSatisfyInterest(data, ingress, pitEntry);
 
-                this->sendDataToAll(pitEntry, inFace, data);
+                this->sendDataToAll(data, pitEntry, ingress.face);
             }
 
             void
-            ClfStrategy::afterReceiveDataClf(const shared_ptr <pit::Entry> &pitEntry,
-                                             const Face &inFace, const Data &data) {
+            ClfStrategy::afterReceiveDataClf(const Data &data, const FaceEndpoint &ingress,
+                                             const shared_ptr <pit::Entry> &pitEntry) {
                 /* Cancellation of scehduled interest and updating of score should be done in Strategy::sendData() or Strategy::sendDataToAll() instead of here
                  * */
 
-                NFD_LOG_DEBUG("afterReceiveData pitEntry=" << pitEntry->getName() <<
-                                                           " inFace=" << inFace.getId() << " data=" << data.getName());
-
-                const fib::Entry &fibEntry = this->lookupFib(*pitEntry);
-                const fib::NextHopList &nexthops = fibEntry.getNextHops();
-                const Interest &interest = pitEntry->getInterest();
-
-                // get the name of interest without the last part, version number
-                ndn::Name namePrefix = interest.getName();
+                CLF_LOG_DEBUG("afterReceiveData pitEntry=" << pitEntry->getName() <<
+                                                           " inFace=" << ingress.face.getId() << " data=" << data.getName());
 
                 // someone already responded with the data, cancel our scheduled interest
-                if (m_scheduledInterstPool.find(data.getName()) != m_scheduledInterstPool.end()) {
-                    // cancel scheduled interest
-                    ns3::Simulator::Cancel(m_scheduledInterstPool[data.getName()]);
-                    // delete interest from m_scheduledInterstPool
-                    m_scheduledInterstPool.erase(m_scheduledInterstPool.find(data.getName()));
-
-                    NFD_LOG_DEBUG(data.getName() << ", cancel scheduled interest.");
+                if (m_deferredInterests.cancel(pitEntry->getName(), getNameHash(*pitEntry))) {
+                    m_contention.recordSuppressed(ingress.face.getId());
+                    CLF_LOG_DEBUG(data.getName() << ", cancel scheduled interest.");
                 }
 
 
                 // get prefix announcement tag
                 auto paTag = data.getTag<lp::PrefixAnnouncementTag>();
-                const ndn::PrefixAnnouncement &pa = *paTag->get().getPrefixAnn();
-                NFD_LOG_DEBUG("Data has prefix announcement: " << pa.getAnnouncedName().toUri());
+                const ndn::PrefixAnnouncement *pa = nullptr;
+                if (paTag != nullptr && paTag->get().getPrefixAnn()) {
+                    pa = &*paTag->get().getPrefixAnn();
+                    CLF_LOG_DEBUG("Data has prefix announcement: " << pa->getAnnouncedName());
+                }
 
                 // get location tag
-                auto locationTag = data.getTag<lp::LocationTag>();
+                auto locationTag = face::getLocationTag(data);
 
                 if (locationTag == nullptr) {
-                    NFD_LOG_DEBUG("Data packet does not contain Location tag.");
-                    ndn::Location myLocation(0, 0);
-                    ndn::Location prevLocation(0, 0);
-                    // if there is destination location in prefix to location table
-                    //    destLocation =
-                    // else
-                    ndn::Location destLocation(0, 0);
-
-                    lp::LocationHeader lh;
-                    lh.setMyLocation(myLocation);
-                    lh.setPrevLocation(prevLocation);
-                    lh.setDestLocation(destLocation);
-
-                    data.setTag(make_shared<lp::LocationTag>(lp::LocationHeader(lh)));
+                    CLF_LOG_DEBUG("Data packet does not contain Location tag.");
+                    // TODO: set the destination location if it is in the prefix location table
+                    data.setTag(m_unknownLocationTag);
                 } else {
-                    if (paTag != nullptr) {
-                        NFD_LOG_DEBUG("Data packet contains Location tag and PA tag.");
-                        ndn::Name annPrefix = pa.getAnnouncedName();
+                    if (pa != nullptr) {
+                        CLF_LOG_DEBUG("Data packet contains Location tag and PA tag.");
+                        const Name &annPrefix = pa->getAnnouncedName();
                         ndn::Location dl = locationTag->get().getDestLocation();
-                        shared_ptr <PrefixLocationEntry> plEntry = make_shared<PrefixLocationEntry>(
-                                PrefixLocationEntry(annPrefix, dl));
-                        //m_prefixLocation.insert(annPrefix, plEntry);
-                        //m_measurements.updateLocationInfo(fibEntry, namePrefix, annPrefix, dl, 257); // use hardcoded faceid
+                        if (dl.getLatitude() != 0 || dl.getLongitude() != 0) {
+                            // another producer or cache of the prefix is a new replica, the same one is refreshed
+                            m_prefixLocation.addReplica(annPrefix, dl);
+                        }
                     }
                 }
 
-                if (m_scheduledInterstPool.find(data.getName()) ==
-                    m_scheduledInterstPool.end()) { // only update score for forwarded interest, don't update score for interest yet to be forwarded
-                    m_measurements.incrementDataCount(fibEntry, pa.getAnnouncedName(), 257);
-                    m_measurements.updateScoreAndLocation(fibEntry, namePrefix, pa.getAnnouncedName(),
-                                                          locationTag->get().getDestLocation(), 257);
+                // only update score for forwarded interest, don't update score for interest yet to be forwarded;
+                // the scores are kept per ad-hoc face, which is the face the Data arrived on
+                if (pa != nullptr && !m_deferredInterests.contains(pitEntry->getName(), getNameHash(*pitEntry))) {
+                    m_measurements.incrementDataCount(pa->getAnnouncedName(), ingress.face.getId());
+                    m_measurements.updateScoreAndLocation(pa->getAnnouncedName(), ingress.face.getId());
                 }
 
-                this->beforeSatisfyInterest(pitEntry, inFace, data);
+                this->beforeSatisfyInterest(data, ingress, pitEntry);
 
-                this->sendDataToAll(pitEntry, inFace, data);
+                this->sendDataToAll(data, pitEntry, ingress.face);
             }
 
             void
-            ClfStrategy::afterReceiveInterestBroadcast(const Face &inFace, const Interest &interest,
+            ClfStrategy::afterReceiveInterestBroadcast(const Interest &interest, const FaceEndpoint &ingress,
                                                        const shared_ptr <pit::Entry> &pitEntry) {
 
-                auto locationTag = interest.getTag<lp::LocationTag>();
+                auto locationTag = face::getLocationTag(interest);
                 ndn::Location ml;
                 ndn::Location pl;
 
@@ -238,8 +436,8 @@ namespace nfd {
                     ml = locationTag->get().getMyLocation();
                     pl = locationTag->get().getPrevLocation();
 
-                    NFD_LOG_DEBUG("MyLocation: " << ml.getLatitude() << ", " << ml.getLongitude());
-                    NFD_LOG_DEBUG("PrevLocation: " << pl.getLatitude() << ", " << pl.getLongitude());
+                    CLF_LOG_DEBUG("MyLocation: " << ml.getLatitude() << ", " << ml.getLongitude());
+                    CLF_LOG_DEBUG("PrevLocation: " << pl.getLatitude() << ", " << pl.getLongitude());
                 }
 
                 // get forwarding information
@@ -258,51 +456,95 @@ namespace nfd {
                 for (const auto &nexthop: nexthops) {
                     Face &outFace = nexthop.getFace();
                     if (isProducer && outFace.getLinkType() == ndn::nfd::LINK_TYPE_POINT_TO_POINT) {
-                        NFD_LOG_DEBUG(interest << " from=" << inFace.getId()
+                        CLF_LOG_DEBUG(interest << " from=" << ingress.face.getId()
                                                << " pitEntry-to=" << outFace.getId() << ", outface link type: "
                                                << outFace.getLinkType());
-                        this->sendInterest(pitEntry, outFace, interest);
+                        this->sendInterest(interest, outFace, pitEntry);
                         break;
                     }
 
                     if (!isProducer && outFace.getLinkType() == ndn::nfd::LINK_TYPE_AD_HOC) {
-                        NFD_LOG_DEBUG(interest << " from=" << inFace.getId()
+                        CLF_LOG_DEBUG(interest << " from=" << ingress.face.getId()
                                                << " pitEntry-to=" << outFace.getId() << ", outface link type: "
                                                << outFace.getLinkType());
                         forwardInterest(interest, pitEntry, &outFace);
-                        //this->sendInterest(pitEntry, outFace, interest);
+                        //this->sendInterest(interest, outFace, pitEntry);
                         break;
                     }
                 }
             }
 
+            void
+            ClfStrategy::recordReceivedInterest(const Face &inFace, const shared_ptr <pit::Entry> &pitEntry) {
+                // a neighbor sent an Interest that we have deferred, or that we have already sent on the same face
+                bool isDeferred = m_deferredInterests.contains(pitEntry->getName(), getNameHash(*pitEntry));
+                bool isRebroadcast = pitEntry->getOutRecord(inFace) != pitEntry->out_end();
+                m_contention.recordInterest(inFace.getId(), isDeferred || isRebroadcast);
+                if (isRebroadcast) {
+                    m_contention.recordRedundantRebroadcast(inFace.getId());
+                }
+            }
+
+            void
+            ClfStrategy::scheduleForwarding(const Interest &interest, const shared_ptr <pit::Entry> &pitEntry,
+                                            Face *outFace, time::nanoseconds baseDelay) {
+                if (m_params.timerScale != 1.0) {
+                    baseDelay = time::duration_cast<time::nanoseconds>(baseDelay * m_params.timerScale);
+                }
+                time::nanoseconds delay = m_contention.computeDelay(outFace->getId(), baseDelay);
+                CLF_LOG_DEBUG("Contention delay " << baseDelay << " -> " << delay << " on face " << outFace->getId());
+
+                // with a coalescing window, rebroadcasts on the same face fire back to back
+                m_deferredInterests.schedule(pitEntry->getName(), getNameHash(*pitEntry), delay,
+                                             DeferredAction(interest, pitEntry, *outFace), outFace->getId());
+            }
+
+            void
+            ClfStrategy::onDeferredForwarding(const DeferredAction &action, time::nanoseconds delay) {
+                auto resolved = resolveDeferredAction(action);
+                if (!resolved) {
+                    CLF_LOG_DEBUG("Deferred interest on face " << action.getEgressId() << " is no longer needed");
+                    return;
+                }
+
+                m_contention.recordRebroadcast(resolved.egress->getId(), delay);
+                forwardInterest(*resolved.interest, resolved.pitEntry, resolved.egress);
+            }
+
             void
             ClfStrategy::forwardInterest(const Interest &interest,
                                          const shared_ptr <pit::Entry> &pitEntry,
                     //TODO: FaceInfo* info,
                                          Face *outFace) {
                 //std::cout << "Forwarding scheduled interest: " << interest;
-                NFD_LOG_DEBUG("Forwarding scheduled interest: " << interest);
+                CLF_LOG_DEBUG("Forwarding scheduled interest: " << interest);
 
                 const fib::Entry &fibEntry = this->lookupFib(*pitEntry);
+                m_measurements.incrementInterestCount(fibEntry, *pitEntry, outFace->getId());
 
-                // get the name of interest without the last part, version number
-                ndn::Name namePrefix = interest.getName().getPrefix(interest.getName().size() - 1);
-
-                m_measurements.incrementInterestCount(fibEntry, namePrefix, outFace->getId());
+                // this node is the previous hop of the rebroadcast, at the MyLocation that arrived with
+                // this Interest; the tag is the Interest's own, so its coordinates are rewritten in place
+                // rather than building another header
+                auto locationTag = face::getLocationTag(interest);
+                if (locationTag != nullptr) {
+                    ndn::Location ml = locationTag->get().getMyLocation();
+                    if (ml.getLatitude() != 0 || ml.getLongitude() != 0) {
+                        locationTag->setPrevLocation(ml);
+                    }
+                }
 
                 // send the interest
-                this->sendInterest(pitEntry, *outFace, interest);
+                this->sendInterest(interest, *outFace, pitEntry);
 
                 // remove the interest from the pool, because it has been sent.
-                m_scheduledInterstPool.erase(interest.getName());
+                m_deferredInterests.erase(pitEntry->getName(), getNameHash(*pitEntry));
 
                 // TODO: update the score of this prefix
                 //info->incrementInterest();
             }
 
             void
-            ClfStrategy::afterReceiveInterestVndn(const Face &inFace, const Interest &interest,
+            ClfStrategy::afterReceiveInterestVndn(const Interest &interest, const FaceEndpoint &ingress,
                                                   const shared_ptr <pit::Entry> &pitEntry) {
                 // if interest hop count > 5 drop it
                 auto hopCountTag = interest.getTag<lp::HopCountTag>();
@@ -310,25 +552,21 @@ namespace nfd {
                     int hopCount = *hopCountTag;
 
                     if (hopCount > 5) {
-                        NFD_LOG_DEBUG("Hopcount greater than 5, dropping interest.");
+                        CLF_LOG_DEBUG("Hopcount greater than 5, dropping interest.");
                         return;
                     }
                 }
 
                 // if we already received this interest and put it in the pool
-                if (m_scheduledInterstPool.find(interest.getName()) != m_scheduledInterstPool.end()) {
-                    // cancel scheduled interest
-                    ns3::Simulator::Cancel(m_scheduledInterstPool[interest.getName()]);
-                    // delete interest from m_scheduledInterstPool
-                    m_scheduledInterstPool.erase(m_scheduledInterstPool.find(interest.getName()));
-
-                    NFD_LOG_DEBUG(interest.getName() << ", cancel scheduled interest.");
+                if (m_deferredInterests.cancel(pitEntry->getName(), getNameHash(*pitEntry))) {
+                    m_contention.recordSuppressed(ingress.face.getId());
+                    CLF_LOG_DEBUG(interest.getName() << ", cancel scheduled interest.");
 
                     return;
                 }
 
                 // get location information
-                auto locationTag = interest.getTag<lp::LocationTag>();
+                auto locationTag = face::getLocationTag(interest);
                 ndn::Location ml;
                 ndn::Location pl;
                 ndn::Location dl;
@@ -337,32 +575,21 @@ namespace nfd {
                     ml = locationTag->get().getMyLocation();
                     pl = locationTag->get().getPrevLocation();
                     dl = locationTag->get().getDestLocation();
-                    NFD_LOG_DEBUG("MyLocation: " << ml.getLatitude() << ", " << ml.getLongitude());
-                    NFD_LOG_DEBUG("PrevLocation: " << pl.getLatitude() << ", " << pl.getLongitude());
-                    NFD_LOG_DEBUG("DestLocation: " << dl.getLatitude() << ", " << dl.getLongitude());
+                    CLF_LOG_DEBUG("MyLocation: " << ml.getLatitude() << ", " << ml.getLongitude());
+                    CLF_LOG_DEBUG("PrevLocation: " << pl.getLatitude() << ", " << pl.getLongitude());
+                    CLF_LOG_DEBUG("DestLocation: " << dl.getLatitude() << ", " << dl.getLongitude());
                 } else {
-                    NFD_LOG_DEBUG(interest.getName() << ", Consumer node: LocationHeader not found in the interest");
+                    CLF_LOG_DEBUG(interest.getName() << ", Consumer node: LocationHeader not found in the interest");
                     // if it is the consumer node, only then it is not going to have location header
                     // need to tag the interest with destLocaton if available
-                    ndn::Location myLocation(0, 0);
-                    ndn::Location prevLocation(0, 0);
-                    // if there is destination location in prefix to location table
-                    //    destLocation =
-                    // else
-                    ndn::Location destLocation(0, 0);
-
-                    lp::LocationHeader lh;
-                    lh.setMyLocation(myLocation);
-                    lh.setPrevLocation(prevLocation);
-                    lh.setDestLocation(destLocation);
+                    // TODO: set the destination location if it is in the prefix location table
+                    CLF_LOG_DEBUG("Adding Location Header to the interst: " << interest.getName());
 
-                    NFD_LOG_DEBUG("Adding Location Header to the interst: " << interest.getName());
-
-                    interest.setTag(make_shared<lp::LocationTag>(lh));
+                    interest.setTag(make_shared<face::LocationTag>());
 
                     /* setting the tag is not needed for vndn algorithm, but had to add, so that same transport service can be used by all the strategies.*/
 
-                    afterReceiveInterestBroadcast(inFace, interest, pitEntry);
+                    afterReceiveInterestBroadcast(interest, ingress, pitEntry);
                     return;
                 }
 
@@ -374,8 +601,7 @@ namespace nfd {
                     //distanceFromMetoPrev = calculateDistance(pl.getLatitude(), pl.getLongitude(),
                     //                                         ml.getLatitude(), ml.getLongitude());
 
-                    distanceFromMetoPrev = calculateDistanceEuclid(pl.getLongitude(), pl.getLatitude(),
-                                                                   ml.getLongitude(), ml.getLatitude());
+                    distanceFromMetoPrev = computeDistance(m_params.distanceMode, pl, ml);
 
                     // shorter the distance longer the wait
                     timer = 1 / distanceFromMetoPrev;
@@ -385,8 +611,8 @@ namespace nfd {
                     timer = timer + (double) (rand() % 10 + 1);
                 } else {
                     // Don't have location info, just broadcast
-                    NFD_LOG_DEBUG("Location info is not available. Broadcast interest: " << interest);
-                    afterReceiveInterestBroadcast(inFace, interest, pitEntry);
+                    CLF_LOG_DEBUG("Location info is not available. Broadcast interest: " << interest);
+                    afterReceiveInterestBroadcast(interest, ingress, pitEntry);
                     return;
                 }
 
@@ -403,33 +629,29 @@ namespace nfd {
                     }
                 }
 
-                NFD_LOG_DEBUG("DistanceFromMeToPrev = " << distanceFromMetoPrev << ", Timer = " << timer << "us.");
+                CLF_LOG_DEBUG("DistanceFromMeToPrev = " << distanceFromMetoPrev << ", Timer = " << timer << "us.");
 
                 // forward interest
                 for (const auto &nexthop: nexthops) {
                     Face *outFace = &nexthop.getFace();
                     if (isProducer && outFace->getLinkType() == ndn::nfd::LINK_TYPE_POINT_TO_POINT) {
-                        NFD_LOG_DEBUG(interest << ", Producer Node: from=" << inFace.getId()
+                        CLF_LOG_DEBUG(interest << ", Producer Node: from=" << ingress.face.getId()
                                                << " pitEntry-to=" << outFace->getId() << ", outface link type: "
                                                << outFace->getLinkType());
 
-                        this->sendInterest(pitEntry, *outFace, interest);
+                        this->sendInterest(interest, *outFace, pitEntry);
                         break;
                     }
 
                     if (!isProducer && outFace->getLinkType() == ndn::nfd::LINK_TYPE_AD_HOC) {
-                        NFD_LOG_DEBUG(interest << ", Intermediate Node: from=" << inFace.getId()
+                        CLF_LOG_DEBUG(interest << ", Intermediate Node: from=" << ingress.face.getId()
                                                << " pitEntry-to=" << outFace->getId() << ", outface link type: "
                                                << outFace->getLinkType() << ", scheduled after " << timer << "ms.");
 
-                        //ndn::EventId eventId = scheduler::schedule(waitingTime,
-                        //                          [this, &interest, pitEntry, &outFace] {forwardInterest(interest, pitEntry,
-                        /*info,*/ //outFace);});
-                        ns3::EventId eventId = ns3::Simulator::Schedule(ns3::MicroSeconds(timer),
-                                                                        &ClfStrategy::forwardInterest, this, interest,
-                                                                        pitEntry, outFace);
-                        //this->sendInterest(pitEntry, outFace, interest);
-                        m_scheduledInterstPool[interest.getName()] = eventId;
+                        scheduleForwarding(interest, pitEntry, outFace,
+                                           time::duration_cast<time::nanoseconds>(
+                                                   time::duration<double, std::micro>(timer)));
+                        //this->sendInterest(interest, outFace, pitEntry);
 
                         break;
                     }
@@ -437,26 +659,22 @@ namespace nfd {
             }
 
             void
-            ClfStrategy::afterReceiveInterestNavigo(const Face &inFace, const Interest &interest,
+            ClfStrategy::afterReceiveInterestNavigo(const Interest &interest, const FaceEndpoint &ingress,
                                                     const shared_ptr <pit::Entry> &pitEntry) {
                 // if we already received this interest and put it in the pool
-                if (m_scheduledInterstPool.find(interest.getName()) != m_scheduledInterstPool.end()) {
-                    // cancel scheduled interest
-                    ns3::Simulator::Cancel(m_scheduledInterstPool[interest.getName()]);
-                    // delete interest from m_scheduledInterstPool
-                    m_scheduledInterstPool.erase(m_scheduledInterstPool.find(interest.getName()));
-
-                    NFD_LOG_DEBUG(interest << ", cancel scheduled interest.");
+                if (m_deferredInterests.cancel(pitEntry->getName(), getNameHash(*pitEntry))) {
+                    m_contention.recordSuppressed(ingress.face.getId());
+                    CLF_LOG_DEBUG(interest << ", cancel scheduled interest.");
 
                     // drop the current interest
                     return;
                 }
 
                 // detect duplicate Nonce in PIT entry
-                int dnw = findDuplicateNonce(*pitEntry, interest.getNonce(), inFace);
+                int dnw = findDuplicateNonce(*pitEntry, interest.getNonce(), ingress.face);
                 bool hasDuplicateNonceInPit = dnw != DUPLICATE_NONCE_NONE;
-                NFD_LOG_DEBUG(dnw << ", " << hasDuplicateNonceInPit);
-                if (inFace.getLinkType() == ndn::nfd::LINK_TYPE_POINT_TO_POINT) {
+                CLF_LOG_DEBUG(dnw << ", " << hasDuplicateNonceInPit);
+                if (ingress.face.getLinkType() == ndn::nfd::LINK_TYPE_POINT_TO_POINT) {
                     // for p2p face: duplicate Nonce from same incoming face is not loop
                     hasDuplicateNonceInPit = hasDuplicateNonceInPit && !(dnw & fw::DUPLICATE_NONCE_IN_SAME);
                 }
@@ -464,12 +682,12 @@ namespace nfd {
                 // handle unscheduled looped interest
                 if (hasDuplicateNonceInPit) {
                     // drop the interest if it is looping
-                    NFD_LOG_DEBUG("Looped interest: " << interest);
+                    CLF_LOG_DEBUG("Looped interest: " << interest);
                     //return; // TODO: It is dropping all the packet. Need to fix it.
                 }
 
                 // get location information
-                auto locationTag = interest.getTag<lp::LocationTag>();
+                auto locationTag = face::getLocationTag(interest);
                 ndn::Location ml;
                 ndn::Location pl;
                 ndn::Location dl;
@@ -479,29 +697,23 @@ namespace nfd {
                     pl = locationTag->get().getPrevLocation();
                     dl = locationTag->get().getDestLocation();
 
-                    NFD_LOG_DEBUG("MyLocation: " << ml.getLatitude() << "," << ml.getLongitude() << "; PrevLocation: "
+                    CLF_LOG_DEBUG("MyLocation: " << ml.getLatitude() << "," << ml.getLongitude() << "; PrevLocation: "
                                                  << pl.getLatitude() << "," << pl.getLongitude() << "; DestLocation: "
                                                  << dl.getLatitude() << "," << dl.getLongitude());
                 } else {
-                    NFD_LOG_DEBUG("Consumer node: LocationHeader not found in the interest");
+                    CLF_LOG_DEBUG("Consumer node: LocationHeader not found in the interest");
                     // if it is the consumer node, only then it is not going to have location header
                     // need to tag the interest with destLocaton if available
-                    ndn::Location myLocation(0, 0);
-                    ndn::Location prevLocation(0, 0);
                     // if there is destination location in prefix to location table
                     //    destLocation =
                     // else
-                    ndn::Location destLocation(350, 0); // hardcode for testing
-
-                    lp::LocationHeader lh;
-                    lh.setMyLocation(myLocation);
-                    lh.setPrevLocation(prevLocation);
-                    lh.setDestLocation(destLocation);
+                    auto newTag = make_shared<face::LocationTag>();
+                    newTag->setDestLocation(ndn::Location(350, 0)); // hardcode for testing
 
-                    NFD_LOG_DEBUG("Adding Location Header to the interst: " << interest.getName());
+                    CLF_LOG_DEBUG("Adding Location Header to the interst: " << interest.getName());
 
-                    interest.setTag(make_shared<lp::LocationTag>(lh));
-                    afterReceiveInterestBroadcast(inFace, interest, pitEntry);
+                    interest.setTag(std::move(newTag));
+                    afterReceiveInterestBroadcast(interest, ingress, pitEntry);
                     return;
                 }
 
@@ -513,19 +725,17 @@ namespace nfd {
                 if ((dl.getLongitude() != 0 or dl.getLatitude() != 0) and
                     (ml.getLongitude() != 0 or ml.getLatitude() != 0) and
                     (pl.getLatitude() != 0 or pl.getLongitude() != 0)) {
-                    distanceFromMeToDest = calculateDistanceEuclid(dl.getLatitude(), dl.getLongitude(),
-                                                                   ml.getLatitude(), ml.getLongitude());
-                    distanceFromPrevToDest = calculateDistanceEuclid(pl.getLatitude(), pl.getLongitude(),
-                                                                     dl.getLatitude(), dl.getLongitude());
+                    distanceFromMeToDest = computeDistance(m_params.distanceMode, dl, ml);
+                    distanceFromPrevToDest = computeDistance(m_params.distanceMode, pl, dl);
                     if (distanceFromMeToDest < distanceFromPrevToDest) {
-                        NFD_LOG_DEBUG("DistanceFromMeToDest = " << distanceFromMeToDest
+                        CLF_LOG_DEBUG("DistanceFromMeToDest = " << distanceFromMeToDest
                                                                 << " is smaller than DistanceFromPrevToDest = "
                                                                 << distanceFromPrevToDest << ". Calculating timer.");
 
                         // calculate timer based on ml, pl and dl
                         timer = distanceFromMeToDest;
                     } else {
-                        NFD_LOG_DEBUG("DistanceFromMeToDest = " << distanceFromMeToDest
+                        CLF_LOG_DEBUG("DistanceFromMeToDest = " << distanceFromMeToDest
                                                                 << " is greater than DistanceFromPrevToDest = "
                                                                 << distanceFromPrevToDest
                                                                 << ". Stop processing interest.");
@@ -535,16 +745,14 @@ namespace nfd {
                     if (true) { /* TODO: if prefix location table has destination location*/
                         //Location destLocation = getLocation(interest.getName());
                         //ndn::Location dl(250, 0); // hardcode for testing, need to do the above
-                        distanceFromMeToDest = calculateDistanceEuclid(dl.getLatitude(), dl.getLongitude(),
-                                                                       ml.getLatitude(), ml.getLongitude());
-                        distanceFromPrevToDest = calculateDistanceEuclid(pl.getLatitude(), pl.getLongitude(),
-                                                                         dl.getLatitude(), dl.getLongitude());
+                        distanceFromMeToDest = computeDistance(m_params.distanceMode, dl, ml);
+                        distanceFromPrevToDest = computeDistance(m_params.distanceMode, pl, dl);
 
                         if (distanceFromMeToDest < distanceFromPrevToDest) {
                             // calculate timer based on ml, pl and dl
                             timer = distanceFromMeToDest;
                         } else {
-                            NFD_LOG_DEBUG("DistanceFromMeToDest = " << distanceFromMeToDest
+                            CLF_LOG_DEBUG("DistanceFromMeToDest = " << distanceFromMeToDest
                                                                     << " is greater than DistanceFromPrevToDest = "
                                                                     << distanceFromPrevToDest
                                                                     << ". Stop processing interest.");
@@ -552,8 +760,8 @@ namespace nfd {
                         }
                     } else {
                         // Don't have location info, just broadcast
-                        NFD_LOG_DEBUG("Location info is not available. Broadcast interest: " << interest);
-                        afterReceiveInterestBroadcast(inFace, interest, pitEntry);
+                        CLF_LOG_DEBUG("Location info is not available. Broadcast interest: " << interest);
+                        afterReceiveInterestBroadcast(interest, ingress, pitEntry);
                         return;
                     }
                 }
@@ -561,7 +769,7 @@ namespace nfd {
                 // to make timer smaller
                 timer /= 10;
 
-                NFD_LOG_DEBUG("DistanceFromMeToDest = " << distanceFromMeToDest << ", DistanceFromPrevToDest = "
+                CLF_LOG_DEBUG("DistanceFromMeToDest = " << distanceFromMeToDest << ", DistanceFromPrevToDest = "
                                                         << distanceFromPrevToDest << ", Timer = " << timer);
 
                 // get forwarding information
@@ -581,27 +789,23 @@ namespace nfd {
                 for (const auto &nexthop: nexthops) {
                     Face *outFace = &nexthop.getFace();
                     if (isProducer && outFace->getLinkType() == ndn::nfd::LINK_TYPE_POINT_TO_POINT) {
-                        NFD_LOG_DEBUG(interest << "Produces Node: from=" << inFace.getId()
+                        CLF_LOG_DEBUG(interest << "Produces Node: from=" << ingress.face.getId()
                                                << " pitEntry-to=" << outFace->getId() << ", outface link type: "
                                                << outFace->getLinkType());
 
-                        this->sendInterest(pitEntry, *outFace, interest);
+                        this->sendInterest(interest, *outFace, pitEntry);
                         break;
                     }
 
                     if (!isProducer && outFace->getLinkType() == ndn::nfd::LINK_TYPE_AD_HOC) {
-                        NFD_LOG_DEBUG(interest << "Intermediate Node: from=" << inFace.getId()
+                        CLF_LOG_DEBUG(interest << "Intermediate Node: from=" << ingress.face.getId()
                                                << " pitEntry-to=" << outFace->getId() << ", outface link type: "
                                                << outFace->getLinkType() << ", scheduled after " << timer << " ms.");
 
-                        //ndn::EventId eventId = scheduler::schedule(waitingTime,
-                        //                          [this, &interest, pitEntry, &outFace] {forwardInterest(interest, pitEntry,
-                        /*info,*/ //outFace);});
-                        ns3::EventId eventId = ns3::Simulator::Schedule(ns3::MilliSeconds(timer),
-                                                                        &ClfStrategy::forwardInterest, this, interest,
-                                                                        pitEntry, outFace);
-                        m_scheduledInterstPool[interest.getName()] = eventId;
-                        //this->sendInterest(pitEntry, outFace, interest);
+                        scheduleForwarding(interest, pitEntry, outFace,
+                                           time::duration_cast<time::nanoseconds>(
+                                                   time::duration<double, std::milli>(timer)));
+                        //this->sendInterest(interest, outFace, pitEntry);
 
                         break;
                     }
@@ -609,21 +813,17 @@ namespace nfd {
             }
 
             void
-            ClfStrategy::afterReceiveInterestClf(const Face &inFace, const Interest &interest,
+            ClfStrategy::afterReceiveInterestClf(const Interest &interest, const FaceEndpoint &ingress,
                                                  const shared_ptr <pit::Entry> &pitEntry) {
-                NFD_LOG_DEBUG(interest.getName().toUri());
+                CLF_LOG_DEBUG(interest.getName());
 
                 // if we already received this interest and put it in the pool (don't think this codeblock is necessary since we are handling looped interest, same interest should always go to looped interest path))
-                if (m_scheduledInterstPool.find(interest.getName()) != m_scheduledInterstPool.end()) {
-                    // cancel scheduled interest
-                    ns3::Simulator::Cancel(m_scheduledInterstPool[interest.getName()]);
-                    // delete interest from m_scheduledInterstPool
-                    m_scheduledInterstPool.erase(m_scheduledInterstPool.find(interest.getName()));
-
+                if (m_deferredInterests.cancel(pitEntry->getName(), getNameHash(*pitEntry))) {
+                    m_contention.recordSuppressed(ingress.face.getId());
                     // delete the corresponding PIT entry
                     this->rejectPendingInterest(pitEntry);
 
-                    NFD_LOG_DEBUG(interest << ", cancel scheduled interest. Drop current interest.");
+                    CLF_LOG_DEBUG(interest << ", cancel scheduled interest. Drop current interest.");
 
                     // drop the current interest
                     return;
@@ -633,6 +833,21 @@ namespace nfd {
                 const fib::Entry &fibEntry = this->lookupFib(*pitEntry);
                 const fib::NextHopList &nexthops = fibEntry.getNextHops();
 
+                // get location information
+                auto locationTag = face::getLocationTag(interest);
+                ndn::Location ml;
+                ndn::Location pl;
+                ndn::Location dl;
+                if (locationTag != nullptr) {
+                    ml = locationTag->get().getMyLocation();
+                    pl = locationTag->get().getPrevLocation();
+                    dl = locationTag->get().getDestLocation();
+
+                    CLF_LOG_DEBUG("MyLocation: " << ml.getLatitude() << "," << ml.getLongitude() << "; PrevLocation: "
+                                                 << pl.getLatitude() << "," << pl.getLongitude() << "; DestLocation: "
+                                                 << dl.getLatitude() << "," << dl.getLongitude());
+                }
+
                 // is this node producer?
                 bool isProducer = false;
                 double centralityScore = 0;
@@ -647,49 +862,27 @@ namespace nfd {
                     if (outFace.getLinkType() == ndn::nfd::LINK_TYPE_AD_HOC) {
                         // get centrality score for the interest name and outface
                         centralityScore = getCentralityScore(pitEntry, outFace.getId());
-                        dlFromTable = getDestLocation(pitEntry, outFace.getId());
+                        dlFromTable = getDestLocation(pitEntry, ml, pl);
                     }
                 }
 
-                // get location information
-                auto locationTag = interest.getTag<lp::LocationTag>();
-                ndn::Location ml;
-                ndn::Location pl;
-                ndn::Location dl;
-                if (locationTag != nullptr) {
-                    ml = locationTag->get().getMyLocation();
-                    pl = locationTag->get().getPrevLocation();
-                    dl = locationTag->get().getDestLocation();
-
-                    NFD_LOG_DEBUG("MyLocation: " << ml.getLatitude() << "," << ml.getLongitude() << "; PrevLocation: "
-                                                 << pl.getLatitude() << "," << pl.getLongitude() << "; DestLocation: "
-                                                 << dl.getLatitude() << "," << dl.getLongitude());
-                } else {  // if it is the consumer node, only then it is not going to have location header
-                    ndn::Location myLocation(0, 0);
-                    ndn::Location prevLocation(0, 0);
-                    ndn::Location destLocation;
+                if (locationTag == nullptr) {  // if it is the consumer node, only then it is not going to have location header
+                    auto newTag = make_shared<face::LocationTag>();
                     if ((dlFromTable.getLongitude() != 0) or (dlFromTable.getLatitude() != 0)) {
-                        destLocation = dlFromTable;
-                        NFD_LOG_DEBUG("Consumer node: LocationHeader not found in the interest. But DestLocation for "
-                                              << interest.getName().toUri() << " is found in prefix location tree: "
-                                              << destLocation.getLongitude() << ", " << destLocation.getLatitude());
+                        newTag->setDestLocation(dlFromTable);
+                        CLF_LOG_DEBUG("Consumer node: LocationHeader not found in the interest. But DestLocation for "
+                                              << interest.getName() << " is found in prefix location tree: "
+                                              << dlFromTable.getLongitude() << ", " << dlFromTable.getLatitude());
                     } else {
-                        NFD_LOG_DEBUG(
+                        CLF_LOG_DEBUG(
                                 "Consumer node: LocationHeader not found in the interest. And also not found in prefix location tree.");
-                        destLocation.setLongitude(0);
-                        destLocation.setLatitude(0);
                     }
 
-                    lp::LocationHeader lh;
-                    lh.setMyLocation(myLocation);
-                    lh.setPrevLocation(prevLocation);
-                    lh.setDestLocation(destLocation);
-
-                    NFD_LOG_DEBUG("Consumer node. Added Location Header to the interst: " << interest.getName()
+                    CLF_LOG_DEBUG("Consumer node. Added Location Header to the interst: " << interest.getName()
                                                                                           << ". Now broadcasting.");
 
-                    interest.setTag(make_shared<lp::LocationTag>(lh));
-                    afterReceiveInterestBroadcast(inFace, interest, pitEntry);
+                    interest.setTag(std::move(newTag));
+                    afterReceiveInterestBroadcast(interest, ingress, pitEntry);
                     return;
                 }
 
@@ -704,14 +897,12 @@ namespace nfd {
                 {
                     locationScore = getLocationScore(pl, dl, ml);
 
-                    weight = ALPHA * (1 - locationScore) + (1 - ALPHA) * centralityScore;
+                    weight = m_params.alpha * (1 - locationScore) + (1 - m_params.alpha) * centralityScore;
 
-                    distanceFromMeToDest = calculateDistanceEuclid(dl.getLatitude(), dl.getLongitude(),
-                                                                   ml.getLatitude(), ml.getLongitude());
-                    distanceFromPrevToDest = calculateDistanceEuclid(pl.getLatitude(), pl.getLongitude(),
-                                                                     dl.getLatitude(), dl.getLongitude());
+                    distanceFromMeToDest = computeDistance(m_params.distanceMode, dl, ml);
+                    distanceFromPrevToDest = computeDistance(m_params.distanceMode, pl, dl);
 
-                    NFD_LOG_DEBUG(
+                    CLF_LOG_DEBUG(
                             "DestLocation information available in Interest. Calculating weight using both location and centrality score. ");
                 } else {
                     if ((dlFromTable.getLongitude() != 0) or
@@ -719,16 +910,16 @@ namespace nfd {
                         ndn::Location dl = dlFromTable;
                         locationScore = getLocationScore(pl, dl, ml);
 
-                        NFD_LOG_DEBUG(
+                        CLF_LOG_DEBUG(
                                 "DestLocation information is not available in Interest, but available in prefix-location table: ("
                                         << dlFromTable.getLatitude() << "," << dlFromTable.getLongitude()
                                         << "). Calculating score using both location and centrality score.");
 
-                        weight = ALPHA * (1 - locationScore) + (1 - ALPHA) * centralityScore;
+                        weight = m_params.alpha * (1 - locationScore) + (1 - m_params.alpha) * centralityScore;
                     } else { // just use centality to calculate the wegiht
-                        NFD_LOG_DEBUG(
+                        CLF_LOG_DEBUG(
                                 "DestLocation information is neither available in Interest nor in prefix-location table. Calculating weight only with centrality score.");
-                        weight = (1 - ALPHA) * centralityScore;
+                        weight = (1 - m_params.alpha) * centralityScore;
                     }
                 }
 
@@ -763,13 +954,13 @@ namespace nfd {
                     // set final timer to randomTimer and convert it to us.
                     finalTimer = round(randomTimer * 1000);
 
-                    NFD_LOG_DEBUG("Calculating timer. Timer = " << timer << " ms, lower_bound = " << lower_bound
+                    CLF_LOG_DEBUG("Calculating timer. Timer = " << timer << " ms, lower_bound = " << lower_bound
                                                                 << ", upper_bound = " << upper_bound
                                                                 << ", randomTimer = " << randomTimer
                                                                 << ", finalTimer = " << finalTimer << " us.");
                 }
 
-                NFD_LOG_DEBUG("Calculated values: DistanceFromMeToDest = " << distanceFromMeToDest
+                CLF_LOG_DEBUG("Calculated values: DistanceFromMeToDest = " << distanceFromMeToDest
                                                                            << "; DistanceFromPrevToDest = "
                                                                            << distanceFromPrevToDest
                                                                            << ". LocationScore = " << locationScore
@@ -784,103 +975,108 @@ namespace nfd {
                 for (const auto &nexthop: nexthops) {
                     Face *outFace = &nexthop.getFace();
                     if (isProducer && outFace->getLinkType() == ndn::nfd::LINK_TYPE_POINT_TO_POINT) {
-                        NFD_LOG_DEBUG(interest << "Producer Node: from=" << inFace.getId()
+                        CLF_LOG_DEBUG(interest << "Producer Node: from=" << ingress.face.getId()
                                                << " pitEntry-to=" << outFace->getId() << ", outface link type: "
                                                << outFace->getLinkType());
 
-                        // get the name of interest without the last part, version number
-                        ndn::Name namePrefix = interest.getName().getPrefix(interest.getName().size() - 1);
-
                         // increment interest count for incoming face becuase that is the ad-hoc face
-                        m_measurements.incrementInterestCount(fibEntry, namePrefix, inFace.getId());
+                        m_measurements.incrementInterestCount(fibEntry, *pitEntry, ingress.face.getId());
 
-                        this->sendInterest(pitEntry, *outFace, interest);
+                        this->sendInterest(interest, *outFace, pitEntry);
                         break;
                     }
 
                     if (!isProducer && outFace->getLinkType() == ndn::nfd::LINK_TYPE_AD_HOC) {
-                        NFD_LOG_DEBUG("Intermediate Node: Interest= " << interest.getName().toUri() << " received from="
-                                                                      << inFace.getId()
+                        CLF_LOG_DEBUG("Intermediate Node: Interest= " << interest.getName() << " received from="
+                                                                      << ingress.face.getId()
                                                                       << " pitEntry-to=" << outFace->getId()
                                                                       << ", outface link type: "
                                                                       << outFace->getLinkType() << ", scheduled after "
                                                                       << finalTimer << " us.");
 
-                        //ndn::EventId eventId = scheduler::schedule(waitingTime,
-                        //                          [this, &interest, pitEntry, &outFace] {forwardInterest(interest, pitEntry,
-                        /*info,*/ //outFace);});
-                        ns3::EventId eid = ns3::Simulator::Schedule(ns3::MicroSeconds(finalTimer),
-                                                                    &ClfStrategy::forwardInterest, this, interest,
-                                                                    pitEntry, outFace);
+                        scheduleForwarding(interest, pitEntry, outFace, time::microseconds(finalTimer));
 
-                        //this->sendInterest(pitEntry, outFace, interest);
-                        m_scheduledInterstPool[interest.getName()] = eid;
+                        //this->sendInterest(interest, outFace, pitEntry);
                         break;
                     }
                 }
             }
 
             void
-            ClfStrategy::afterReceiveNack(const Face &inFace, const lp::Nack &nack,
+            ClfStrategy::afterReceiveNack(const lp::Nack &nack, const FaceEndpoint &ingress,
                                           const shared_ptr <pit::Entry> &pitEntry) {
                 //this->processNack(inFace, nack, pitEntry);
             }
 
             double
             ClfStrategy::getCentralityScore(const shared_ptr <pit::Entry> &pitEntry, FaceId faceId) {
-                NFD_LOG_DEBUG("Getting centrality score for face " << faceId << ", name prefix: "
-                                                                   << pitEntry->getInterest().getName().toUri());
+                CLF_LOG_DEBUG("Getting centrality score for face " << faceId << ", name: " << pitEntry->getName());
 
-                const Interest &interest = pitEntry->getInterest();
-                const fib::Entry &fibEntry = this->lookupFib(*pitEntry);
-
-                // get the name of interest without the last part, version number
-                ndn::Name namePrefix = interest.getName().getPrefix(interest.getName().size() - 1);
-
-                return m_measurements.getCs(fibEntry, faceId, namePrefix);
+                return m_measurements.getCs(*pitEntry, faceId);
             }
 
             ndn::Location
-            ClfStrategy::getDestLocation(const shared_ptr <pit::Entry> &pitEntry, FaceId faceId) {
-                const Interest &interest = pitEntry->getInterest();
-                const fib::Entry &fibEntry = this->lookupFib(*pitEntry);
-
-                // get the name of interest without the last part, version number
-                ndn::Name namePrefix = interest.getName().getPrefix(interest.getName().size() - 1);
+            ClfStrategy::getDestLocation(const shared_ptr <pit::Entry> &pitEntry, const ndn::Location &ml,
+                                         const ndn::Location &pl) {
+                const Name &name = pitEntry->getName();
+
+                // the consumer has no location in the Interest, use the last location overheard
+                bool isMyLocationKnown = ml.getLatitude() != 0 || ml.getLongitude() != 0;
+                const ndn::Location &from = isMyLocationKnown ? ml : m_myLocation;
+
+                // any announced prefix of the name can serve it: aim at the nearest of their replicas,
+                // or without a location to measure from, at the longest prefix match
+                shared_ptr <PrefixLocationEntry> entry;
+                if (from.getLatitude() != 0 || from.getLongitude() != 0) {
+                    entry = m_prefixLocation.findNearest(name, from);
+                }
+                else {
+                    entry = m_prefixLocation.findLongestPrefix(name);
+                }
+                if (entry == nullptr) {
+                    CLF_LOG_DEBUG("DestLocation for " << name << " not found in prefix location tree.");
+                    return ndn::Location(0, 0);
+                }
 
-                return m_measurements.getDestLocationInfo(fibEntry, namePrefix, faceId);
+                m_prefixLocation.touch(*entry);
+                return selectReplica(*entry, from, pl);
             }
 
-            double
-            ClfStrategy::calculateDistanceEuclid(double x1, double y1, double x2, double y2) {
-                double x = x1 - x2; //calculating number to square in next step
-                double y = y1 - y2;
-                double dist;
-
-                dist = pow(x, 2) + pow(y, 2);       //calculating Euclidean distance
-                dist = sqrt(dist);
-
-                return dist;
-            }
+            ndn::Location
+            ClfStrategy::selectReplica(const PrefixLocationEntry &entry, const ndn::Location &ml,
+                                       const ndn::Location &pl) {
+                const auto &replicas = entry.getReplicas();
+                if (replicas.size() <= 1 || (ml.getLatitude() == 0 && ml.getLongitude() == 0)) {
+                    // without a location to compare with, the most recently seen replica is the best guess
+                    return entry.getLocation();
+                }
 
-/*
- * https://stackoverflow.com/questions/10198985/calculating-the-distance-between-2-latitudes-and-longitudes-that-are-saved-in-a
- */
+                m_replicaLocations.clear();
+                for (const auto &replica : replicas) {
+                    m_replicaLocations.push_back(replica.location);
+                }
 
-            double
-            ClfStrategy::calculateDistance(double lat1d, double lon1d,
-                                           double lat2d, double lon2d) {
-                double lat1r, lon1r, lat2r, lon2r, u, v;
+                double distances[PrefixLocationEntry::MAX_REPLICAS];
+                computeDistances(m_params.distanceMode, ml, m_replicaLocations, distances);
 
-                lat1r = deg2rad(lat1d);
-                lon1r = deg2rad(lon1d);
-                lat2r = deg2rad(lat2d);
-                lon2r = deg2rad(lon2d);
+                // with a previous hop, prefer the replica this hop makes the most progress to,
+                // then the nearest one; otherwise the nearest one
+                double scores[PrefixLocationEntry::MAX_REPLICAS] = {};
+                if (pl.getLatitude() != 0 || pl.getLongitude() != 0) {
+                    computeLocationScores(m_params.distanceMode, pl, ml, m_replicaLocations, scores);
+                }
 
-                u = sin((lat2r - lat1r) / 2);
-                v = sin((lon2r - lon1r) / 2);
+                size_t best = 0;
+                for (size_t i = 1; i < replicas.size(); ++i) {
+                    if (scores[i] > scores[best] || (scores[i] == scores[best] && distances[i] < distances[best])) {
+                        best = i;
+                    }
+                }
 
-                return 2.0 * earthRadiusKm * asin(sqrt(u * u + cos(lat1r) * cos(lat2r) * v * v));
+                CLF_LOG_DEBUG("Selected replica " << best << " of " << replicas.size() << " for " << entry.getName()
+                                                  << ": " << replicas[best].location.getLatitude() << ","
+                                                  << replicas[best].location.getLongitude());
+                return replicas[best].location;
             }
 
         } // namespace clf
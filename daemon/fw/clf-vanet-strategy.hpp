@@ -29,6 +29,13 @@
 #include "clf-vanet-measurements.hpp"
 #include "strategy.hpp"
 #include "clf-prefix-location-tree.hpp"
+#include "clf-timer.hpp"
+#include "clf-deferred-interest-pool.hpp"
+#include "clf-geo-distance.hpp"
+#include "clf-neighbor-table.hpp"
+#include "clf-contention.hpp"
+#include "clf-snapshot.hpp"
+#include "face/lp-location.hpp"
 
 #include <ndn-cxx/lp/location-header.hpp>
 #include <ndn-cxx/util/scheduler.hpp>
@@ -42,97 +49,186 @@ namespace nfd {
     namespace fw {
         namespace clf {
 
+            /** \brief which forwarding algorithm a ClfStrategy instance runs
+             */
+            enum class ForwardingMode {
+                /** \brief rebroadcast every Interest without delay
+                 */
+                BROADCAST,
+                /** \brief defer rebroadcasts by the distance from the previous hop
+                 */
+                VNDN,
+                /** \brief defer rebroadcasts by the distance to the prefix location
+                 */
+                NAVIGO,
+                /** \brief defer rebroadcasts by the location score weighted with the centrality score
+                 */
+                CLF
+            };
+
+            std::ostream &
+            operator<<(std::ostream &os, ForwardingMode mode);
+
+            /** \brief parse "broadcast", "vndn", "navigo" or "clf"
+             *  \throw std::invalid_argument the mode is unknown
+             */
+            ForwardingMode
+            parseForwardingMode(const std::string &mode);
+
 /** \brief a forwarding strategy that forwards Interest to all FIB nexthops
+ *
+ *  The algorithm and its constants are chosen by the instance parameters, e.g.
+ *  /localhost/nfd/strategy/clf/%FD%03/mode~navigo/timer-scale~0.5, so that different
+ *  namespaces can run different algorithms side by side.
  */
             class ClfStrategy : public Strategy {
             public:
                 explicit
                 ClfStrategy(Forwarder &forwarder, const Name &name = getStrategyName());
 
+                ~ClfStrategy() override;
+
                 static const Name &
                 getStrategyName();
 
                 void
-                afterReceiveInterest(const Face &inFace, const Interest &interest,
+                afterReceiveInterest(const Interest &interest, const FaceEndpoint &ingress,
                                      const shared_ptr <pit::Entry> &pitEntry) override;
 
                 void
-                afterReceiveNack(const Face &inFace, const lp::Nack &nack,
+                afterReceiveNack(const lp::Nack &nack, const FaceEndpoint &ingress,
                                  const shared_ptr <pit::Entry> &pitEntry) override;
 
                 void
-                afterReceiveData(const shared_ptr <pit::Entry> &pitEntry,
-                                 const Face &inFace, const Data &data) override;
+                afterReceiveData(const Data &data, const FaceEndpoint &ingress,
+                                 const shared_ptr <pit::Entry> &pitEntry) override;
 
-                void
-                onLoopedInterest(const shared_ptr <pit::Entry> &pitEntry, const Face &outFace,
-                                 const Interest &interest) override;
+                /** \return approximate number of bytes used by the measurements and prefix locations
+                 */
+                size_t
+                getMemoryUsage() const;
 
-                void
-                onPitExpiration(const shared_ptr <pit::Entry> &pitEntry) override;
+                const DeferredInterestPool &
+                getDeferredInterests() const {
+                    return m_deferredInterests;
+                }
+
+                const ContentionController &
+                getContentionController() const {
+                    return m_contention;
+                }
+
+            public:
+                static constexpr time::nanoseconds DEFAULT_SNAPSHOT_INTERVAL = 60_s;
 
             private:
+                /** \brief strategy instance parameters, given as <parameter>~<value> name components
+                 */
+                struct Parameters {
+                    ForwardingMode mode = ForwardingMode::CLF; ///< forwarding algorithm
+                    /// weight of the location score against the centrality score in CLF mode
+                    double alpha = 0.5;
+                    ScoreParameters scoreParams; ///< smoothing and decay of the centrality scores
+                    /// factor applied to the rebroadcast delay computed by the forwarding algorithm
+                    double timerScale = 1.0;
+                    std::string timerBackend; ///< name of the TimerBackend, empty selects the scheduler
+                    DistanceMode distanceMode = DistanceMode::PLANAR; ///< how location scores measure distances
+                    ContentionMode contentionMode = ContentionMode::FIXED; ///< how deferred rebroadcasts are delayed
+                    /// maximum number of namespaces with scores, and of prefix locations
+                    size_t maxEntries = VanetMeasurements::DEFAULT_MAX_ENTRIES;
+                    /// how long unused scores and prefix locations are kept
+                    time::nanoseconds lifetime = VanetMeasurements::MEASUREMENTS_LIFETIME;
+                    /// deferred rebroadcasts due within this window go out together per face, zero disables
+                    time::nanoseconds coalescingWindow = time::nanoseconds::zero();
+                    /// file from which learned state is restored and to which it is saved, empty disables it
+                    std::string snapshotPath;
+                    /// how often learned state is saved to snapshotPath, in addition to when the strategy is destroyed
+                    time::nanoseconds snapshotInterval = DEFAULT_SNAPSHOT_INTERVAL;
+                };
+
+                static Parameters
+                parseParameters(const PartialName &parsed);
+
+                /** \throw std::invalid_argument \p value is not a positive decimal integer
+                 */
+                static uint64_t
+                parsePositiveInteger(const std::string &parameter, const std::string &value);
+
+                /** \throw std::invalid_argument \p value is not a number in [0, 1], or is zero
+                 *         and \p allowZero is false
+                 */
+                static double
+                parseFraction(const std::string &parameter, const std::string &value, bool allowZero);
+
+                /** \brief listen to the packets received on \p face, if it is an ad-hoc face,
+                 *         to keep m_neighbors up to date
+                 */
                 void
-                afterReceiveInterestBroadcast(const Face &inFace, const Interest &interest,
-                                              const shared_ptr <pit::Entry> &pitEntry);
+                overhearFace(const Face &face);
 
+                /** \brief warm-start from the snapshot file, and start saving snapshots periodically
+                 *
+                 *  This is deferred until the strategy is in effect for its namespace, because
+                 *  measurement entries cannot be created before.
+                 */
                 void
-                afterReceiveInterestVndn(const Face &inFace, const Interest &interest,
-                                         const shared_ptr <pit::Entry> &pitEntry);
+                restoreSnapshot();
 
+                /** \brief save the learned state in snapshotInterval, and then periodically
+                 */
                 void
-                afterReceiveInterestNavigo(const Face &inFace, const Interest &interest,
-                                           const shared_ptr <pit::Entry> &pitEntry);
+                scheduleSnapshot();
 
                 void
-                afterReceiveInterestClf(const Face &inFace, const Interest &interest,
-                                        const shared_ptr <pit::Entry> &pitEntry);
+                saveSnapshot();
 
+                template<typename Packet>
+                void
+                onOverheard(FaceId faceId, const Packet &packet, EndpointId endpointId);
+
+                /** \brief cancel the deferred transmission of an Interest overheard on \p faceId
+                 *
+                 *  The forwarder drops a neighbor's rebroadcast of an Interest that is already pending,
+                 *  because its Nonce is a duplicate, without triggering the strategy. Overhearing it is
+                 *  what suppresses the transmission deferred here.
+                 */
                 void
-                afterReceiveDataNormal(const shared_ptr <pit::Entry> &pitEntry,
-                                       const Face &inFace, const Data &data);
+                suppressOverheard(FaceId faceId, const Interest &interest);
 
                 void
-                afterReceiveDataClf(const shared_ptr <pit::Entry> &pitEntry,
-                                    const Face &inFace, const Data &data);
+                afterReceiveInterestBroadcast(const Interest &interest, const FaceEndpoint &ingress,
+                                              const shared_ptr <pit::Entry> &pitEntry);
 
+                void
+                afterReceiveInterestVndn(const Interest &interest, const FaceEndpoint &ingress,
+                                         const shared_ptr <pit::Entry> &pitEntry);
 
-                // This function converts decimal degrees to radians
-                double deg2rad(double deg) {
-                    return (deg * M_PI / 180);
-                }
+                void
+                afterReceiveInterestNavigo(const Interest &interest, const FaceEndpoint &ingress,
+                                           const shared_ptr <pit::Entry> &pitEntry);
 
-                //  This function converts radians to decimal degrees
-                double rad2deg(double rad) {
-                    return (rad * 180 / M_PI);
-                }
+                void
+                afterReceiveInterestClf(const Interest &interest, const FaceEndpoint &ingress,
+                                        const shared_ptr <pit::Entry> &pitEntry);
 
-                double
-                calculateDistanceEuclid(double x1, double y1, double x2, double y2);
+                void
+                afterReceiveDataNormal(const Data &data, const FaceEndpoint &ingress,
+                                       const shared_ptr <pit::Entry> &pitEntry);
 
-                double
-                calculateDistance(double lat1d, double lon1d,
-                                  double lat2d, double lon2d);
+                void
+                afterReceiveDataClf(const Data &data, const FaceEndpoint &ingress,
+                                    const shared_ptr <pit::Entry> &pitEntry);
 
 
                 double
-                getLocationScore(ndn::Location pl, ndn::Location dl,
-                                 ndn::Location ml) {
-                    double distanceFromMeToDest = calculateDistanceEuclid(dl.getLatitude(), dl.getLongitude(),
-                                                                          ml.getLatitude(), ml.getLongitude());
-                    double distanceFromPrevToDest = calculateDistanceEuclid(pl.getLatitude(), pl.getLongitude(),
-                                                                            dl.getLatitude(), dl.getLongitude());
-
-                    return (1 - (distanceFromMeToDest / std::max(distanceFromMeToDest, distanceFromPrevToDest)));
+                getLocationScore(const ndn::Location &pl, const ndn::Location &dl,
+                                 const ndn::Location &ml) {
+                    return computeLocationScore(m_params.distanceMode, pl, ml, dl);
                 }
 
                 double
-                getLocationScoreVndn(ndn::Location pl, ndn::Location ml) {
-                    double distanceFromMe = calculateDistance(pl.getLatitude(), pl.getLongitude(),
-                                                              ml.getLatitude(), ml.getLongitude());
-
-                    std::cout << "distanceFromMeToPrev: " << distanceFromMe << std::endl;
-
+                getLocationScoreVndn(const ndn::Location &pl, const ndn::Location &ml) {
+                    //double distanceFromMe = computeDistance(DistanceMode::HAVERSINE, pl, ml);
                     //return distanceFromMe/std::max(distanceFromMe, distanceFromPrev);
                     return 0.0;
                 }
@@ -140,13 +236,52 @@ namespace nfd {
                 double
                 getCentralityScore(const shared_ptr <pit::Entry> &pitEntry, FaceId faceId);
 
+                /** \brief find the location of a replica of the Interest's prefix to aim at
+                 *
+                 *  The entry is the announced prefix of the Interest name with the replica nearest to
+                 *  this node, found with PrefixLocationTree::findNearest; the replica is then chosen
+                 *  among those of that entry by selectReplica.
+                 *  \param ml location of this node carried by the Interest, (0, 0) if unknown
+                 *  \param pl location of the previous hop carried by the Interest, (0, 0) if unknown
+                 *  \return the selected replica location, or (0, 0) if the prefix location is unknown
+                 */
                 ndn::Location
-                getDestLocation(const shared_ptr <pit::Entry> &pitEntry, FaceId faceId);
+                getDestLocation(const shared_ptr <pit::Entry> &pitEntry, const ndn::Location &ml,
+                                const ndn::Location &pl);
+
+                /** \brief select the replica of \p entry with the best location score from \p pl to \p ml,
+                 *         or the nearest to \p ml
+                 */
+                ndn::Location
+                selectReplica(const PrefixLocationEntry &entry, const ndn::Location &ml, const ndn::Location &pl);
 
                 double
                 calculateTimer(double lat1d, double lon1d,
                                double lat2d, double lon2d);
 
+                /** \brief count \p inFace's Interest in m_contention, as a duplicate if it is
+                 *         already deferred or was already sent on \p inFace
+                 */
+                void
+                recordReceivedInterest(const Face &inFace, const shared_ptr <pit::Entry> &pitEntry);
+
+                /** \brief defer the forwarding of \p interest to \p outFace
+                 *  \param baseDelay delay computed by the forwarding algorithm, adjusted by m_contention
+                 */
+                void
+                scheduleForwarding(const Interest &interest, const shared_ptr <pit::Entry> &pitEntry,
+                                   Face *outFace, time::nanoseconds baseDelay);
+
+                /** \brief send a deferred Interest when it is due, unless its PIT entry has been
+                 *         erased or satisfied, or its face removed meanwhile
+                 *
+                 *  Strategies are not notified when a PIT entry expires, so a deferred Interest stays
+                 *  in m_deferredInterests until it is due and is discarded here. DeferredAction only
+                 *  holds weak references, so the pool does not keep the PIT entry alive meanwhile.
+                 */
+                void
+                onDeferredForwarding(const DeferredAction &action, time::nanoseconds delay);
+
                 void
                 forwardInterest(const Interest &interest,
                                 const shared_ptr <pit::Entry> &pitEntry,
@@ -154,16 +289,33 @@ namespace nfd {
                                 Face *outFace);
 
             private:
+                Parameters m_params;
+                Cs &m_cs;
+                unique_ptr <TimerBackend> m_timers;
                 VanetMeasurements m_measurements;
 
-                const double earthRadiusKm = 6371;
-                //ndn::DummyIoService m_ioService;
-                //ndn::Scheduler m_scheduler;
-                std::unordered_map <ndn::Name, ns3::EventId> m_scheduledInterstPool;
+                DeferredInterestPool m_deferredInterests;
 
                 PrefixLocationTree m_prefixLocation;
-
-                static const double ALPHA;
+                LocationBatch m_replicaLocations; // scratch space of selectReplica
+                ndn::Location m_myLocation; // location of this node, as last overheard
+                // attached to Data without locations; shared by all of them, so it is never patched
+                const shared_ptr <face::LocationTag> m_unknownLocationTag = make_shared<face::LocationTag>();
+
+                NeighborTable m_neighbors;
+                ContentionController m_contention;
+                // the Interest being passed to afterReceiveInterest, so that overhearing it does not suppress it
+                const Interest *m_dispatchedInterest = nullptr;
+                struct OverhearConnections {
+                    signal::ScopedConnection afterReceiveInterest;
+                    signal::ScopedConnection afterReceiveData;
+                };
+                std::unordered_map <FaceId, OverhearConnections> m_overhearConns;
+                signal::ScopedConnection m_afterAddFaceConn;
+                signal::ScopedConnection m_beforeRemoveFaceConn;
+
+                TimerId m_snapshotTimer;
+                bool m_hasRestoredSnapshot = false; // learned state is not saved before it is restored
             };
 
         } // namespace clf
@@ -0,0 +1,79 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "deferred-action.hpp"
+#include "face-table.hpp"
+
+namespace nfd {
+namespace fw {
+
+DeferredAction::DeferredAction(const Interest& interest, const shared_ptr<pit::Entry>& pitEntry,
+                               const Face& egress)
+  : m_pitEntry(pitEntry)
+  , m_interest(interest.shared_from_this())
+  , m_egress(egress.getId())
+{
+}
+
+void
+DeferredAction::reset() noexcept
+{
+  m_pitEntry.reset();
+  m_interest.reset();
+  m_egress = face::INVALID_FACEID;
+}
+
+bool
+DeferredAction::hasName(const Name& name) const
+{
+  auto pitEntry = m_pitEntry.lock();
+  return pitEntry != nullptr && pitEntry->getName() == name;
+}
+
+DeferredAction::Resolved
+DeferredAction::resolve(const FaceTable& faceTable) const
+{
+  Resolved resolved;
+  auto pitEntry = m_pitEntry.lock();
+  if (pitEntry == nullptr || pitEntry->isSatisfied) {
+    return resolved;
+  }
+
+  Face* egress = faceTable.get(m_egress);
+  if (egress == nullptr) {
+    return resolved;
+  }
+
+  resolved.interest = m_interest.lock();
+  if (resolved.interest == nullptr) {
+    resolved.interest = pitEntry->getInterest().shared_from_this();
+  }
+  resolved.pitEntry = std::move(pitEntry);
+  resolved.egress = egress;
+  return resolved;
+}
+
+} // namespace fw
+} // namespace nfd
@@ -0,0 +1,109 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_FW_DEFERRED_ACTION_HPP
+#define NFD_DAEMON_FW_DEFERRED_ACTION_HPP
+
+#include "face/face-common.hpp"
+#include "table/pit-entry.hpp"
+
+namespace nfd {
+
+class FaceTable;
+
+namespace fw {
+
+/** \brief Weak references to an Interest that a strategy sends on a face after a delay
+ *
+ *  A strategy that defers forwarding keeps a DeferredAction instead of a shared_ptr to the PIT
+ *  entry, a copy of the Interest and a Face pointer. A pending action therefore neither keeps
+ *  the PIT entry alive past its expiry nor dangles if the face is removed. When the action is
+ *  due, resolve() tells whether it is still needed.
+ *
+ *  A DeferredAction does not allocate, so a pool of them can be reused for many timers.
+ */
+class DeferredAction
+{
+public:
+  /** \brief Strong references to a deferred action that is still needed
+   */
+  struct Resolved
+  {
+    explicit
+    operator bool() const noexcept
+    {
+      return pitEntry != nullptr;
+    }
+
+    shared_ptr<pit::Entry> pitEntry;
+    shared_ptr<const Interest> interest;
+    Face* egress = nullptr;
+  };
+
+  DeferredAction() = default;
+
+  /** \param interest the Interest to send; if it is released before the action is due,
+   *                  the Interest of \p pitEntry is sent instead
+   *  \pre \p interest is owned by a shared_ptr, as are Interests received by the forwarder
+   */
+  DeferredAction(const Interest& interest, const shared_ptr<pit::Entry>& pitEntry, const Face& egress);
+
+  FaceId
+  getEgressId() const noexcept
+  {
+    return m_egress;
+  }
+
+  bool
+  empty() const noexcept
+  {
+    return m_egress == face::INVALID_FACEID;
+  }
+
+  void
+  reset() noexcept;
+
+  /** \brief Tell whether the action is for the Interest \p name, as named by its PIT entry
+   *  \return false if the PIT entry has been erased
+   */
+  bool
+  hasName(const Name& name) const;
+
+  /** \brief Take strong references to the action's PIT entry, Interest and face
+   *  \return empty Resolved if the PIT entry has been erased or satisfied, or the face removed
+   */
+  Resolved
+  resolve(const FaceTable& faceTable) const;
+
+private:
+  weak_ptr<pit::Entry> m_pitEntry;
+  weak_ptr<const Interest> m_interest;
+  FaceId m_egress = face::INVALID_FACEID;
+};
+
+} // namespace fw
+} // namespace nfd
+
+#endif // NFD_DAEMON_FW_DEFERRED_ACTION_HPP
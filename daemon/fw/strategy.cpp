@@ -315,5 +315,22 @@ Strategy::lookupFib(const pit::Entry& pitEntry) const
   return *fibEntry; // only occurs if no delegation finds a FIB nexthop
 }
 
+name_tree::HashValue
+Strategy::getNameHash(const pit::Entry& pitEntry) const
+{
+  const name_tree::Entry* nte = m_forwarder.getNameTree().getEntry(pitEntry);
+  if (nte == nullptr) { // PIT entry has been erased
+    return getNameHash(pitEntry.getInterest());
+  }
+  return name_tree::getNode(*nte)->hash;
+}
+
+name_tree::HashValue
+Strategy::getNameHash(const Interest& interest) const
+{
+  size_t depth = pit::Pit::getNameTreeDepth(interest.getName());
+  return name_tree::getHashes(interest, depth)[depth];
+}
+
 } // namespace fw
 } // namespace nfd
@@ -26,6 +26,7 @@
 #ifndef NFD_DAEMON_FW_STRATEGY_HPP
 #define NFD_DAEMON_FW_STRATEGY_HPP
 
+#include "deferred-action.hpp"
 #include "forwarder.hpp"
 #include "table/measurements-accessor.hpp"
 
@@ -353,6 +354,23 @@ protected: // accessors
   const fib::Entry&
   lookupFib(const pit::Entry& pitEntry) const;
 
+  /** \brief Returns the name tree hash of \p pitEntry's name
+   *
+   *  The hash is computed when the PIT entry is inserted, so that a strategy can key
+   *  per-Interest state on it without hashing the name again.
+   *  If the name is longer than NameTree::getMaxDepth(), the hash covers only that prefix.
+   */
+  name_tree::HashValue
+  getNameHash(const pit::Entry& pitEntry) const;
+
+  /** \brief Returns the name tree hash that a PIT entry for \p interest has
+   *
+   *  This follows the same depth rule as the PIT, i.e., an implicit digest component is not
+   *  hashed. The hashes are cached on \p interest, so the PIT lookup of the same packet reuses them.
+   */
+  name_tree::HashValue
+  getNameHash(const Interest& interest) const;
+
   MeasurementsAccessor&
   getMeasurements()
   {
@@ -371,6 +389,17 @@ protected: // accessors
     return m_forwarder.m_faceTable;
   }
 
+  /** \brief Takes strong references to a deferred action when it is due
+   *  \return empty if the action is no longer needed, because its PIT entry has been erased
+   *          or satisfied, or its face has been removed
+   *  \sa DeferredAction
+   */
+  DeferredAction::Resolved
+  resolveDeferredAction(const DeferredAction& action) const
+  {
+    return action.resolve(getFaceTable());
+  }
+
 protected: // instance name
   struct ParsedInstanceName
   {
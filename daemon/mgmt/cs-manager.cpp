@@ -24,8 +24,11 @@
  */
 
 #include "cs-manager.hpp"
+#include "core/cs-byte-info.hpp"
+#include "core/cs-wtinylfu-info.hpp"
 #include "fw/forwarder-counters.hpp"
 #include "table/cs.hpp"
+#include "table/cs-policy-wtinylfu.hpp"
 
 #include <ndn-cxx/mgmt/nfd/cs-info.hpp>
 
@@ -112,7 +115,27 @@ CsManager::serveInfo(const Name& topPrefix, const Interest& interest,
   info.setNHits(m_fwCounters.nCsHits);
   info.setNMisses(m_fwCounters.nCsMisses);
 
-  context.append(info.wireEncode());
+  CsByteInfo byteInfo;
+  if (m_cs.getByteLimit() != std::numeric_limits<size_t>::max()) {
+    byteInfo.byteCapacity = m_cs.getByteLimit();
+  }
+  byteInfo.nBytes = m_cs.getNBytes();
+
+  Block wire = appendCsByteInfo(info.wireEncode(), byteInfo);
+
+  if (auto policy = dynamic_cast<const cs::WTinyLfuPolicy*>(m_cs.getPolicy())) {
+    const auto& counters = policy->getCounters();
+    CsWTinyLfuInfo policyInfo;
+    policyInfo.nWindowHits = counters.nHits[cs::wtinylfu::SEGMENT_WINDOW];
+    policyInfo.nProbationHits = counters.nHits[cs::wtinylfu::SEGMENT_PROBATION];
+    policyInfo.nProtectedHits = counters.nHits[cs::wtinylfu::SEGMENT_PROTECTED];
+    policyInfo.nInserted = counters.nInserted;
+    policyInfo.nAdmitted = counters.nAdmitted;
+    policyInfo.nRejected = counters.nRejected;
+    wire = appendCsWTinyLfuInfo(wire, policyInfo);
+  }
+
+  context.append(wire);
   context.end();
 }
 
@@ -26,6 +26,7 @@
 #include "face-manager.hpp"
 
 #include "common/logger.hpp"
+#include "core/face-contention-info.hpp"
 #include "face/generic-link-service.hpp"
 #include "face/protocol-factory.hpp"
 #include "fw/face-table.hpp"
@@ -395,13 +396,32 @@ makeFaceStatus(const Face& face, const time::steady_clock::time_point& now)
   return status;
 }
 
+/** \return the FaceStatus of \p face, with the contention counters appended for an ad-hoc face
+ */
+static Block
+encodeFaceStatus(const Face& face, const time::steady_clock::time_point& now)
+{
+  Block wire = makeFaceStatus(face, now).wireEncode();
+  if (face.getLinkType() != ndn::nfd::LINK_TYPE_AD_HOC) {
+    return wire;
+  }
+
+  const auto& counters = face.getCounters();
+  FaceContentionInfo info;
+  info.nDuplicateInterests = counters.nDuplicateInterests;
+  info.nDeferredInterests = counters.nDeferredInterests;
+  info.nSuppressedInterests = counters.nSuppressedInterests;
+  info.nRebroadcastInterests = counters.nRebroadcastInterests;
+  info.nRedundantRebroadcasts = counters.nRedundantRebroadcasts;
+  return appendFaceContentionInfo(wire, info);
+}
+
 void
 FaceManager::listFaces(ndn::mgmt::StatusDatasetContext& context)
 {
   auto now = time::steady_clock::now();
   for (const auto& face : m_faceTable) {
-    ndn::nfd::FaceStatus status = makeFaceStatus(face, now);
-    context.append(status.wireEncode());
+    context.append(encodeFaceStatus(face, now));
   }
   context.end();
 }
@@ -478,8 +498,7 @@ FaceManager::queryFaces(const Interest& interest,
   auto now = time::steady_clock::now();
   for (const auto& face : m_faceTable) {
     if (matchFilter(faceFilter, face)) {
-      ndn::nfd::FaceStatus status = makeFaceStatus(face, now);
-      context.append(status.wireEncode());
+      context.append(encodeFaceStatus(face, now));
     }
   }
   context.end();
@@ -29,6 +29,7 @@
 namespace nfd {
 
 const size_t DEFAULT_CS_MAX_PACKETS = 65536;
+const size_t DEFAULT_CS_MAX_BYTES = std::numeric_limits<size_t>::max();
 
 TablesConfigSection::TablesConfigSection(Forwarder& forwarder)
   : m_forwarder(forwarder)
@@ -52,6 +53,7 @@ TablesConfigSection::ensureConfigured()
   }
 
   m_forwarder.getCs().setLimit(DEFAULT_CS_MAX_PACKETS);
+  m_forwarder.getCs().setByteLimit(DEFAULT_CS_MAX_BYTES);
   // Don't set default cs_policy because it's already created by CS itself.
   m_forwarder.setUnsolicitedDataPolicy(make_unique<fw::DefaultUnsolicitedDataPolicy>());
 
@@ -67,6 +69,12 @@ TablesConfigSection::processConfig(const ConfigSection& section, bool isDryRun,
     nCsMaxPackets = ConfigFile::parseNumber<size_t>(*csMaxPacketsNode, "cs_max_packets", "tables");
   }
 
+  size_t nCsMaxBytes = DEFAULT_CS_MAX_BYTES;
+  OptionalConfigSection csMaxBytesNode = section.get_child_optional("cs_max_bytes");
+  if (csMaxBytesNode) {
+    nCsMaxBytes = ConfigFile::parseNumber<size_t>(*csMaxBytesNode, "cs_max_bytes", "tables");
+  }
+
   unique_ptr<cs::Policy> csPolicy;
   OptionalConfigSection csPolicyNode = section.get_child_optional("cs_policy");
   if (csPolicyNode) {
@@ -90,6 +98,18 @@ TablesConfigSection::processConfig(const ConfigSection& section, bool isDryRun,
     unsolicitedDataPolicy = make_unique<fw::DefaultUnsolicitedDataPolicy>();
   }
 
+  auto nameTreeLayout = name_tree::HashtableLayout::CHAINED;
+  OptionalConfigSection nameTreeLayoutNode = section.get_child_optional("name_tree_layout");
+  if (nameTreeLayoutNode) {
+    std::string layoutName = nameTreeLayoutNode->get_value<std::string>();
+    if (layoutName == "open_addressing") {
+      nameTreeLayout = name_tree::HashtableLayout::OPEN_ADDRESSING;
+    }
+    else if (layoutName != "chained") {
+      NDN_THROW(ConfigFile::Error("Unknown name_tree_layout '" + layoutName + "' in section 'tables'"));
+    }
+  }
+
   OptionalConfigSection strategyChoiceSection = section.get_child_optional("strategy_choice");
   if (strategyChoiceSection) {
     processStrategyChoiceSection(*strategyChoiceSection, isDryRun);
@@ -106,12 +126,15 @@ TablesConfigSection::processConfig(const ConfigSection& section, bool isDryRun,
 
   Cs& cs = m_forwarder.getCs();
   cs.setLimit(nCsMaxPackets);
+  cs.setByteLimit(nCsMaxBytes);
   if (cs.size() == 0 && csPolicy != nullptr) {
     cs.setPolicy(std::move(csPolicy));
   }
 
   m_forwarder.setUnsolicitedDataPolicy(std::move(unsolicitedDataPolicy));
 
+  m_forwarder.getNameTree().setHashtableLayout(nameTreeLayout);
+
   m_isConfigured = true;
 }
 
@@ -28,6 +28,8 @@
 namespace nfd {
 namespace cs {
 
+const size_t Entry::OVERHEAD = sizeof(Entry) + sizeof(Data) + 16 * sizeof(void*);
+
 Entry::Entry(shared_ptr<const Data> data, bool isUnsolicited)
   : m_data(std::move(data))
   , m_isUnsolicited(isUnsolicited)
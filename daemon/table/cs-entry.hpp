@@ -78,6 +78,23 @@ public: // exposed through ContentStore enumeration
   bool
   canSatisfy(const Interest& interest) const;
 
+  /** \brief return the number of bytes charged to this entry against the byte limit
+   *
+   *  This is the wire size of the stored Data plus \p OVERHEAD.
+   */
+  size_t
+  getNBytes() const
+  {
+    return m_data->wireEncode().size() + OVERHEAD;
+  }
+
+  /** \brief approximate memory used by an entry besides the Data wire encoding
+   *
+   *  It covers the Entry, the decoded Data, and the nodes of the Table, the name index,
+   *  and a policy's cleanup index.
+   */
+  static const size_t OVERHEAD;
+
 public: // used by ContentStore implementation
   Entry(shared_ptr<const Data> data, bool isUnsolicited);
 
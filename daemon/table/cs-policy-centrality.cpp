@@ -0,0 +1,148 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "cs-policy-centrality.hpp"
+#include "cs.hpp"
+
+namespace nfd {
+namespace cs {
+namespace centrality {
+
+const std::string CentralityPolicy::POLICY_NAME = "centrality";
+NFD_REGISTER_CS_POLICY(CentralityPolicy);
+
+constexpr double CentralityPolicy::HIGH_CENTRALITY;
+constexpr double CentralityPolicy::LOW_CENTRALITY;
+
+CentralityPolicy::CentralityPolicy()
+  : Policy(POLICY_NAME)
+{
+}
+
+void
+CentralityPolicy::doAfterInsert(EntryRef i)
+{
+  Priority priority = this->computePriority(i);
+
+  if (priority == PRIORITY_LOW && m_queues[PRIORITY_LOW].empty() && this->isOverLimit()) {
+    // admitting the entry would evict an entry of higher priority
+    ++m_counters.nRejected;
+    this->emitSignal(beforeEvict, i);
+    return;
+  }
+
+  ++m_counters.nAdmitted[priority];
+  this->attachQueue(i, priority);
+  this->evictEntries();
+}
+
+void
+CentralityPolicy::doAfterRefresh(EntryRef i)
+{
+  // centrality may have changed since the entry was inserted
+  this->detachQueue(i);
+  this->attachQueue(i, this->computePriority(i));
+}
+
+void
+CentralityPolicy::doBeforeErase(EntryRef i)
+{
+  this->detachQueue(i);
+}
+
+void
+CentralityPolicy::doBeforeUse(EntryRef i)
+{
+  this->attachQueue(i, this->detachQueue(i));
+}
+
+void
+CentralityPolicy::evictEntries()
+{
+  BOOST_ASSERT(this->getCs() != nullptr);
+
+  while (this->isOverLimit()) {
+    this->evictOne();
+  }
+}
+
+Priority
+CentralityPolicy::computePriority(EntryRef i) const
+{
+  if (i->isUnsolicited()) {
+    return PRIORITY_LOW;
+  }
+
+  optional<double> centrality = this->getCs()->getCentrality(i->getName());
+  if (!centrality) {
+    return PRIORITY_NORMAL;
+  }
+  if (*centrality >= HIGH_CENTRALITY) {
+    return PRIORITY_HIGH;
+  }
+  if (*centrality < LOW_CENTRALITY) {
+    return PRIORITY_LOW;
+  }
+  return PRIORITY_NORMAL;
+}
+
+void
+CentralityPolicy::evictOne()
+{
+  for (Queue& queue : m_queues) {
+    if (!queue.empty()) {
+      EntryRef i = queue.front();
+      this->detachQueue(i);
+      this->emitSignal(beforeEvict, i);
+      return;
+    }
+  }
+  BOOST_ASSERT(false);
+}
+
+void
+CentralityPolicy::attachQueue(EntryRef i, Priority priority)
+{
+  BOOST_ASSERT(m_entryInfoMap.find(i) == m_entryInfoMap.end());
+
+  Queue& queue = m_queues[priority];
+  m_entryInfoMap[i] = {priority, queue.insert(queue.end(), i)};
+}
+
+Priority
+CentralityPolicy::detachQueue(EntryRef i)
+{
+  auto it = m_entryInfoMap.find(i);
+  BOOST_ASSERT(it != m_entryInfoMap.end());
+
+  Priority priority = it->second.priority;
+  m_queues[priority].erase(it->second.queueIt);
+  m_entryInfoMap.erase(it);
+  return priority;
+}
+
+} // namespace centrality
+} // namespace cs
+} // namespace nfd
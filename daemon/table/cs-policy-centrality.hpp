@@ -0,0 +1,143 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_TABLE_CS_POLICY_CENTRALITY_HPP
+#define NFD_DAEMON_TABLE_CS_POLICY_CENTRALITY_HPP
+
+#include "cs-policy.hpp"
+#include "common/counter.hpp"
+
+#include <list>
+
+namespace nfd {
+namespace cs {
+namespace centrality {
+
+using Queue = std::list<Policy::EntryRef>;
+
+enum Priority {
+  PRIORITY_LOW,
+  PRIORITY_NORMAL,
+  PRIORITY_HIGH,
+  PRIORITY_MAX
+};
+
+struct EntryInfo
+{
+  Priority priority;
+  Queue::iterator queueIt;
+};
+
+/** \brief counters of admission decisions
+ */
+struct AdmissionCounters
+{
+  PacketCounter nAdmitted[PRIORITY_MAX]; ///< admitted Data, by priority
+  PacketCounter nRejected;               ///< Data not admitted
+};
+
+/** \brief centrality-driven admission and replacement policy
+ *
+ *  Each Data is given a priority from the centrality of this node for its name, as reported by
+ *  Cs::getCentrality: a node that is central for a namespace keeps its Data at high priority,
+ *  a node on the periphery keeps it at low priority. Unsolicited Data has low priority, and
+ *  Data for which no centrality is known has normal priority.
+ *
+ *  Each priority has a queue in least-recently-used order. Eviction exhausts the low priority
+ *  queue before moving onto the normal, then the high priority queue. A low priority Data is
+ *  not admitted at all if it could only be stored by evicting a Data of higher priority.
+ */
+class CentralityPolicy final : public Policy
+{
+public:
+  CentralityPolicy();
+
+  const AdmissionCounters&
+  getCounters() const
+  {
+    return m_counters;
+  }
+
+public:
+  static const std::string POLICY_NAME;
+
+  /// centrality from which Data is kept at high priority
+  static constexpr double HIGH_CENTRALITY = 0.5;
+  /// centrality below which Data is kept at low priority
+  static constexpr double LOW_CENTRALITY = 0.1;
+
+private:
+  void
+  doAfterInsert(EntryRef i) final;
+
+  void
+  doAfterRefresh(EntryRef i) final;
+
+  void
+  doBeforeErase(EntryRef i) final;
+
+  void
+  doBeforeUse(EntryRef i) final;
+
+  void
+  evictEntries() final;
+
+private:
+  Priority
+  computePriority(EntryRef i) const;
+
+  /** \brief evicts one entry
+   *  \pre CS is not empty
+   */
+  void
+  evictOne();
+
+  /** \brief attaches the entry to the end of the queue of \p priority
+   *  \pre the entry is not in any queue
+   */
+  void
+  attachQueue(EntryRef i, Priority priority);
+
+  /** \brief detaches the entry from its current queue
+   *  \return the priority of the entry
+   *  \post the entry is not in any queue
+   */
+  Priority
+  detachQueue(EntryRef i);
+
+private:
+  Queue m_queues[PRIORITY_MAX];
+  std::map<EntryRef, EntryInfo> m_entryInfoMap;
+  AdmissionCounters m_counters;
+};
+
+} // namespace centrality
+
+using centrality::CentralityPolicy;
+
+} // namespace cs
+} // namespace nfd
+
+#endif // NFD_DAEMON_TABLE_CS_POLICY_CENTRALITY_HPP
@@ -0,0 +1,282 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "cs-policy-wtinylfu.hpp"
+#include "cs.hpp"
+#include "common/wy-hash.hpp"
+
+namespace nfd {
+namespace cs {
+namespace wtinylfu {
+
+constexpr unsigned FrequencySketch::MAX_COUNT;
+constexpr size_t FrequencySketch::N_ROWS;
+constexpr size_t FrequencySketch::MAX_WIDTH;
+
+void
+FrequencySketch::resize(size_t nEntries)
+{
+  // four counters per entry in each row keep collisions rare
+  m_widthBits = 4;
+  while ((size_t(1) << m_widthBits) < std::min(nEntries, MAX_WIDTH / 4) * 4) {
+    ++m_widthBits;
+  }
+  size_t width = size_t(1) << m_widthBits;
+
+  m_table.assign(N_ROWS * width / 16, 0);
+  m_nIncrements = 0;
+  m_sampleSize = 10 * std::max<size_t>(std::min(nEntries, MAX_WIDTH / 4), 1);
+}
+
+size_t
+FrequencySketch::getOffset(uint64_t key, size_t row) const
+{
+  // an odd multiplier per row picks a different counter in each row
+  static const uint64_t MULTIPLIERS[N_ROWS] = {
+    0x9e3779b97f4a7c15, 0xc2b2ae3d27d4eb4f, 0x165667b19e3779f9, 0xd6e8feb86659fd93};
+
+  size_t column = static_cast<size_t>((key * MULTIPLIERS[row]) >> (64 - m_widthBits));
+  return ((row << m_widthBits) + column) * 4;
+}
+
+void
+FrequencySketch::increment(uint64_t key)
+{
+  if (m_table.empty()) {
+    return;
+  }
+
+  bool isIncremented = false;
+  for (size_t row = 0; row < N_ROWS; ++row) {
+    size_t offset = this->getOffset(key, row);
+    if (this->getCounter(offset) < MAX_COUNT) {
+      m_table[offset >> 6] += uint64_t(1) << (offset & 63);
+      isIncremented = true;
+    }
+  }
+
+  if (isIncremented && ++m_nIncrements >= m_sampleSize) {
+    this->age();
+  }
+}
+
+unsigned
+FrequencySketch::estimate(uint64_t key) const
+{
+  if (m_table.empty()) {
+    return 0;
+  }
+
+  unsigned count = MAX_COUNT;
+  for (size_t row = 0; row < N_ROWS; ++row) {
+    count = std::min(count, this->getCounter(this->getOffset(key, row)));
+  }
+  return count;
+}
+
+void
+FrequencySketch::age()
+{
+  for (uint64_t& word : m_table) {
+    word = (word >> 1) & 0x7777777777777777;
+  }
+  m_nIncrements /= 2;
+}
+
+const std::string WTinyLfuPolicy::POLICY_NAME = "wtinylfu";
+NFD_REGISTER_CS_POLICY(WTinyLfuPolicy);
+
+constexpr double WTinyLfuPolicy::WINDOW_SHARE;
+constexpr double WTinyLfuPolicy::PROTECTED_SHARE;
+
+WTinyLfuPolicy::WTinyLfuPolicy()
+  : Policy(POLICY_NAME)
+{
+}
+
+void
+WTinyLfuPolicy::doAfterInsert(EntryRef i)
+{
+  ++m_counters.nInserted;
+  this->recordAccess(i);
+  this->attachQueue(i, SEGMENT_WINDOW);
+  this->evictEntries();
+}
+
+void
+WTinyLfuPolicy::doAfterRefresh(EntryRef i)
+{
+  this->recordAccess(i);
+  this->touch(i);
+}
+
+void
+WTinyLfuPolicy::doBeforeErase(EntryRef i)
+{
+  this->detachQueue(i);
+}
+
+void
+WTinyLfuPolicy::doBeforeUse(EntryRef i)
+{
+  ++m_counters.nHits[m_entryInfoMap.at(&*i).segment];
+  this->recordAccess(i);
+  this->touch(i);
+}
+
+void
+WTinyLfuPolicy::evictEntries()
+{
+  BOOST_ASSERT(this->getCs() != nullptr);
+
+  while (this->isOverLimit()) {
+    this->evictOne();
+  }
+
+  // while the Content Store is not full, entries leave the window without competing for admission
+  while (this->exceedsShare(SEGMENT_WINDOW, WINDOW_SHARE)) {
+    EntryRef i = m_queues[SEGMENT_WINDOW].front();
+    this->detachQueue(i);
+    this->attachQueue(i, SEGMENT_PROBATION);
+  }
+}
+
+void
+WTinyLfuPolicy::recordAccess(EntryRef i)
+{
+  if (m_sketchLimit != this->getLimit()) {
+    m_sketch.resize(this->getLimit());
+    m_sketchLimit = this->getLimit();
+  }
+  const Block& nameWire = i->getName().wireEncode();
+  m_sketch.increment(WyHash64(nameWire.value(), nameWire.value_size(), 0));
+}
+
+unsigned
+WTinyLfuPolicy::estimateFrequency(EntryRef i) const
+{
+  const Block& nameWire = i->getName().wireEncode();
+  return m_sketch.estimate(WyHash64(nameWire.value(), nameWire.value_size(), 0));
+}
+
+void
+WTinyLfuPolicy::touch(EntryRef i)
+{
+  Segment segment = this->detachQueue(i);
+  if (segment == SEGMENT_WINDOW) {
+    this->attachQueue(i, SEGMENT_WINDOW);
+    return;
+  }
+
+  this->attachQueue(i, SEGMENT_PROTECTED);
+  while (this->exceedsShare(SEGMENT_PROTECTED, PROTECTED_SHARE)) {
+    EntryRef demoted = m_queues[SEGMENT_PROTECTED].front();
+    this->detachQueue(demoted);
+    this->attachQueue(demoted, SEGMENT_PROBATION);
+  }
+}
+
+bool
+WTinyLfuPolicy::exceedsShare(Segment segment, double share) const
+{
+  // a segment always has room for one entry
+  if (m_queues[segment].size() <= 1) {
+    return false;
+  }
+
+  if (m_queues[segment].size() > static_cast<double>(this->getLimit()) * share) {
+    return true;
+  }
+  return this->getByteLimit() != std::numeric_limits<size_t>::max() &&
+         m_nBytes[segment] > static_cast<double>(this->getByteLimit()) * share;
+}
+
+void
+WTinyLfuPolicy::evictOne()
+{
+  const Queue& window = m_queues[SEGMENT_WINDOW];
+  const Queue& probation = m_queues[SEGMENT_PROBATION];
+  const Queue& protectedQueue = m_queues[SEGMENT_PROTECTED];
+
+  if (probation.empty() && protectedQueue.empty()) {
+    BOOST_ASSERT(!window.empty());
+    this->evict(window.front());
+    return;
+  }
+
+  EntryRef victim = probation.empty() ? protectedQueue.front() : probation.front();
+  if (window.empty() || !this->exceedsShare(SEGMENT_WINDOW, WINDOW_SHARE)) {
+    this->evict(victim);
+    return;
+  }
+
+  // the entry leaving the window competes with the victim of the main cache
+  EntryRef candidate = window.front();
+  if (this->estimateFrequency(candidate) > this->estimateFrequency(victim)) {
+    ++m_counters.nAdmitted;
+    this->evict(victim);
+    this->detachQueue(candidate);
+    this->attachQueue(candidate, SEGMENT_PROBATION);
+  }
+  else {
+    ++m_counters.nRejected;
+    this->evict(candidate);
+  }
+}
+
+void
+WTinyLfuPolicy::evict(EntryRef i)
+{
+  this->detachQueue(i);
+  this->emitSignal(beforeEvict, i);
+}
+
+void
+WTinyLfuPolicy::attachQueue(EntryRef i, Segment segment)
+{
+  BOOST_ASSERT(m_entryInfoMap.find(&*i) == m_entryInfoMap.end());
+
+  Queue& queue = m_queues[segment];
+  size_t nBytes = i->getNBytes();
+  m_nBytes[segment] += nBytes;
+  m_entryInfoMap.emplace(&*i, EntryInfo{segment, queue.insert(queue.end(), i), nBytes});
+}
+
+Segment
+WTinyLfuPolicy::detachQueue(EntryRef i)
+{
+  auto it = m_entryInfoMap.find(&*i);
+  BOOST_ASSERT(it != m_entryInfoMap.end());
+
+  Segment segment = it->second.segment;
+  m_queues[segment].erase(it->second.queueIt);
+  m_nBytes[segment] -= it->second.nBytes;
+  m_entryInfoMap.erase(it);
+  return segment;
+}
+
+} // namespace wtinylfu
+} // namespace cs
+} // namespace nfd
@@ -0,0 +1,229 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_TABLE_CS_POLICY_WTINYLFU_HPP
+#define NFD_DAEMON_TABLE_CS_POLICY_WTINYLFU_HPP
+
+#include "cs-policy.hpp"
+#include "common/counter.hpp"
+
+#include <list>
+
+namespace nfd {
+namespace cs {
+namespace wtinylfu {
+
+/** \brief a count-min sketch of 4-bit access frequencies
+ *
+ *  Each key increments one counter in each of four rows. The estimated frequency of a key is
+ *  the smallest of its counters. All counters are halved after a sample of accesses ten times
+ *  the number of entries, so that the sketch follows changes in popularity.
+ */
+class FrequencySketch
+{
+public:
+  /** \brief clear the sketch, and size it for about \p nEntries distinct keys
+   */
+  void
+  resize(size_t nEntries);
+
+  /** \brief record an access to \p key
+   */
+  void
+  increment(uint64_t key);
+
+  /** \return estimated number of recent accesses to \p key, at most MAX_COUNT
+   */
+  unsigned
+  estimate(uint64_t key) const;
+
+public:
+  static constexpr unsigned MAX_COUNT = 15;
+  static constexpr size_t N_ROWS = 4;
+  /// counters per row are capped, so that a large limit does not allocate a huge sketch
+  static constexpr size_t MAX_WIDTH = size_t(1) << 22;
+
+private:
+  /** \return bit offset of the counter of \p key in \p row
+   */
+  size_t
+  getOffset(uint64_t key, size_t row) const;
+
+  unsigned
+  getCounter(size_t offset) const
+  {
+    return (m_table[offset >> 6] >> (offset & 63)) & MAX_COUNT;
+  }
+
+  /** \brief halve all counters
+   */
+  void
+  age();
+
+private:
+  std::vector<uint64_t> m_table; // 16 counters per word
+  unsigned m_widthBits = 0;
+  size_t m_nIncrements = 0;
+  size_t m_sampleSize = 0;
+};
+
+enum Segment {
+  SEGMENT_WINDOW,    ///< recently inserted entries, in least-recently-used order
+  SEGMENT_PROBATION, ///< main cache entries not used since entering it
+  SEGMENT_PROTECTED, ///< main cache entries used since entering it
+  SEGMENT_MAX
+};
+
+using Queue = std::list<Policy::EntryRef>;
+
+struct EntryInfo
+{
+  Segment segment;
+  Queue::iterator queueIt;
+  size_t nBytes;
+};
+
+/** \brief counters of lookups and admission decisions
+ *
+ *  Policy does not see lookups that miss. When each miss is followed by the insertion of the
+ *  retrieved Data, the hit ratio is nHits / (nHits + nInserted).
+ */
+struct HitCounters
+{
+  PacketCounter nHits[SEGMENT_MAX]; ///< lookups matched by an entry, by segment of the entry
+  PacketCounter nInserted;          ///< new entries
+  PacketCounter nAdmitted;          ///< window entries admitted into the main cache over a victim
+  PacketCounter nRejected;          ///< window entries evicted in favor of a main cache entry
+};
+
+/** \brief Window TinyLFU replacement policy
+ *
+ *  New entries are kept in a small window queue in least-recently-used order. An entry leaving
+ *  the window enters the main cache, which is a segmented LRU: entries start on probation and
+ *  are protected once used. When the Content Store is full, the entry leaving the window is
+ *  admitted only if its estimated access frequency is higher than the frequency of the entry
+ *  that the main cache would evict; otherwise the entry leaving the window is evicted.
+ *
+ *  Frequencies are estimated by a FrequencySketch of Data names, updated on every insertion,
+ *  refresh, and use. A sequential scan of Data accessed once cannot displace frequently used
+ *  Data, because the scanned Data never win admission into the main cache.
+ *
+ *  The window and the protected segment are sized as shares of both the packet and the byte
+ *  limit.
+ */
+class WTinyLfuPolicy final : public Policy
+{
+public:
+  WTinyLfuPolicy();
+
+  const HitCounters&
+  getCounters() const
+  {
+    return m_counters;
+  }
+
+public:
+  static const std::string POLICY_NAME;
+
+  /// share of the limits given to the window
+  static constexpr double WINDOW_SHARE = 0.01;
+  /// share of the limits given to the protected segment
+  static constexpr double PROTECTED_SHARE = (1.0 - WINDOW_SHARE) * 0.8;
+
+private:
+  void
+  doAfterInsert(EntryRef i) final;
+
+  void
+  doAfterRefresh(EntryRef i) final;
+
+  void
+  doBeforeErase(EntryRef i) final;
+
+  void
+  doBeforeUse(EntryRef i) final;
+
+  void
+  evictEntries() final;
+
+private:
+  /** \brief record an access to the entry in the sketch
+   */
+  void
+  recordAccess(EntryRef i);
+
+  unsigned
+  estimateFrequency(EntryRef i) const;
+
+  /** \brief move a used or refreshed entry to the end of its queue,
+   *         promoting it from probation to protected
+   */
+  void
+  touch(EntryRef i);
+
+  /** \return whether \p segment has more entries or bytes than \p share of the limits
+   */
+  bool
+  exceedsShare(Segment segment, double share) const;
+
+  /** \brief evicts one entry
+   *  \pre CS is not empty
+   */
+  void
+  evictOne();
+
+  void
+  evict(EntryRef i);
+
+  /** \brief attaches the entry to the end of the queue of \p segment
+   *  \pre the entry is not in any queue
+   */
+  void
+  attachQueue(EntryRef i, Segment segment);
+
+  /** \brief detaches the entry from its current queue
+   *  \return the segment of the entry
+   *  \post the entry is not in any queue
+   */
+  Segment
+  detachQueue(EntryRef i);
+
+private:
+  Queue m_queues[SEGMENT_MAX];
+  size_t m_nBytes[SEGMENT_MAX] = {};
+  std::unordered_map<const Entry*, EntryInfo> m_entryInfoMap;
+  FrequencySketch m_sketch;
+  size_t m_sketchLimit = 0; // packet limit for which m_sketch is sized
+  HitCounters m_counters;
+};
+
+} // namespace wtinylfu
+
+using wtinylfu::WTinyLfuPolicy;
+
+} // namespace cs
+} // namespace nfd
+
+#endif // NFD_DAEMON_TABLE_CS_POLICY_WTINYLFU_HPP
@@ -72,6 +72,21 @@ Policy::setLimit(size_t nMaxEntries)
   this->evictEntries();
 }
 
+void
+Policy::setByteLimit(size_t nMaxBytes)
+{
+  NFD_LOG_INFO("setByteLimit " << nMaxBytes);
+  m_byteLimit = nMaxBytes;
+  this->evictEntries();
+}
+
+bool
+Policy::isOverLimit() const
+{
+  BOOST_ASSERT(m_cs != nullptr);
+  return m_cs->size() > m_limit || m_cs->getNBytes() > m_byteLimit;
+}
+
 void
 Policy::afterInsert(EntryRef i)
 {
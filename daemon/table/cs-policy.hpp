@@ -104,6 +104,23 @@ public:
   void
   setLimit(size_t nMaxEntries);
 
+  /** \brief gets hard limit (in number of bytes, as counted by Entry::getNBytes)
+   */
+  size_t
+  getByteLimit() const
+  {
+    return m_byteLimit;
+  }
+
+  /** \brief sets hard limit (in number of bytes, as counted by Entry::getNBytes)
+   *  \post getByteLimit() == nMaxBytes
+   *  \post cs.getNBytes() <= getByteLimit()
+   *
+   *  The policy may evict entries if necessary.
+   */
+  void
+  setByteLimit(size_t nMaxBytes);
+
 public:
   /** \brief a reference to an CS entry
    *  \note operator< of EntryRef compares the Data name enclosed in the Entry.
@@ -119,6 +136,7 @@ public:
 
   /** \brief invoked by CS after a new entry is inserted
    *  \post cs.size() <= getLimit()
+   *  \post cs.getNBytes() <= getByteLimit()
    *
    *  The policy may evict entries if necessary.
    *  During this process, \p i might be evicted.
@@ -185,10 +203,17 @@ protected:
 
   /** \brief evicts zero or more entries
    *  \post CS size does not exceed hard limit
+   *
+   *  A policy implementation should evict entries while \p isOverLimit() returns true.
    */
   virtual void
   evictEntries() = 0;
 
+  /** \return whether CS exceeds either the packet limit or the byte limit
+   */
+  bool
+  isOverLimit() const;
+
 protected:
   DECLARE_SIGNAL_EMIT(beforeEvict)
 
@@ -202,6 +227,7 @@ private: // registry
 private:
   std::string m_policyName;
   size_t m_limit;
+  size_t m_byteLimit = std::numeric_limits<size_t>::max();
   Cs* m_cs;
 };
 
@@ -24,7 +24,9 @@
  */
 
 #include "cs.hpp"
+#include "name-tree-hashtable.hpp"
 #include "common/logger.hpp"
+#include "common/wy-hash.hpp"
 #include "core/algorithm.hpp"
 
 #include <ndn-cxx/lp/tags.hpp>
@@ -50,7 +52,7 @@ Cs::Cs(size_t nMaxPackets)
 void
 Cs::insert(const Data& data, bool isUnsolicited)
 {
-  if (!m_shouldAdmit || m_policy->getLimit() == 0) {
+  if (!m_shouldAdmit || m_policy->getLimit() == 0 || m_policy->getByteLimit() == 0) {
     return;
   }
   NFD_LOG_DEBUG("insert " << data.getName());
@@ -64,6 +66,10 @@ Cs::insert(const Data& data, bool isUnsolicited)
     }
   }
 
+  // the hashes cached by the PIT lookup are not needed once the Data is stored,
+  // and they are not accounted in Entry::getNBytes()
+  data.removeTag<name_tree::HashesTag>();
+
   const_iterator it;
   bool isNewEntry = false;
   std::tie(it, isNewEntry) = m_table.emplace(data.shared_from_this(), isUnsolicited);
@@ -80,6 +86,8 @@ Cs::insert(const Data& data, bool isUnsolicited)
     m_policy->afterRefresh(it);
   }
   else {
+    m_nameIndex.emplace(hashName(data.getName(), data.getName().size()), it);
+    m_nBytes += entry.getNBytes();
     m_policy->afterInsert(it);
   }
 }
@@ -104,12 +112,35 @@ Cs::eraseImpl(const Name& prefix, size_t limit)
   size_t nErased = 0;
   while (i != last && nErased < limit) {
     m_policy->beforeErase(i);
-    i = m_table.erase(i);
+    i = this->eraseEntry(i);
     ++nErased;
   }
   return nErased;
 }
 
+Cs::const_iterator
+Cs::eraseEntry(const_iterator i)
+{
+  auto range = m_nameIndex.equal_range(hashName(i->getName(), i->getName().size()));
+  for (auto it = range.first; it != range.second; ++it) {
+    if (it->second == i) {
+      m_nameIndex.erase(it);
+      break;
+    }
+  }
+  m_nBytes -= i->getNBytes();
+  return m_table.erase(i);
+}
+
+uint64_t
+Cs::hashName(const Name& name, size_t prefixLen)
+{
+  const Block& wire = name.wireEncode();
+  const uint8_t* begin = wire.value();
+  const uint8_t* end = prefixLen < name.size() ? name[prefixLen].data() : begin + wire.value_size();
+  return WyHash64(begin, static_cast<size_t>(end - begin), 0);
+}
+
 Cs::const_iterator
 Cs::findImpl(const Interest& interest) const
 {
@@ -118,11 +149,20 @@ Cs::findImpl(const Interest& interest) const
   }
 
   const Name& prefix = interest.getName();
-  auto range = findPrefixRange(prefix);
-  auto match = std::find_if(range.first, range.second,
-                            [&interest] (const auto& entry) { return entry.canSatisfy(interest); });
+  const_iterator match = m_table.end();
+  if (interest.getCanBePrefix()) {
+    auto range = findPrefixRange(prefix);
+    match = std::find_if(range.first, range.second,
+                         [&interest] (const auto& entry) { return entry.canSatisfy(interest); });
+    if (match == range.second) {
+      match = m_table.end();
+    }
+  }
+  else {
+    match = findExactImpl(interest);
+  }
 
-  if (match == range.second) {
+  if (match == m_table.end()) {
     NFD_LOG_DEBUG("find " << prefix << " no-match");
     return m_table.end();
   }
@@ -131,6 +171,25 @@ Cs::findImpl(const Interest& interest) const
   return match;
 }
 
+Cs::const_iterator
+Cs::findExactImpl(const Interest& interest) const
+{
+  const Name& name = interest.getName();
+  bool isFullName = !name.empty() && name[-1].isImplicitSha256Digest();
+  auto range = m_nameIndex.equal_range(hashName(name, name.size() - static_cast<size_t>(isFullName)));
+
+  // Several Data may share a name; pick the first satisfying one in Table order,
+  // as a search of the Table would.
+  const_iterator match = m_table.end();
+  for (auto it = range.first; it != range.second; ++it) {
+    const_iterator candidate = it->second;
+    if (candidate->canSatisfy(interest) && (match == m_table.end() || *candidate < *match)) {
+      match = candidate;
+    }
+  }
+  return match;
+}
+
 void
 Cs::dump()
 {
@@ -146,8 +205,10 @@ Cs::setPolicy(unique_ptr<Policy> policy)
   BOOST_ASSERT(policy != nullptr);
   BOOST_ASSERT(m_policy != nullptr);
   size_t limit = m_policy->getLimit();
+  size_t byteLimit = m_policy->getByteLimit();
   this->setPolicyImpl(std::move(policy));
   m_policy->setLimit(limit);
+  m_policy->setByteLimit(byteLimit);
 }
 
 void
@@ -155,7 +216,7 @@ Cs::setPolicyImpl(unique_ptr<Policy> policy)
 {
   NFD_LOG_DEBUG("set-policy " << policy->getName());
   m_policy = std::move(policy);
-  m_beforeEvictConnection = m_policy->beforeEvict.connect([this] (auto it) { m_table.erase(it); });
+  m_beforeEvictConnection = m_policy->beforeEvict.connect([this] (auto it) { this->eraseEntry(it); });
 
   m_policy->setCs(this);
   BOOST_ASSERT(m_policy->getCs() == this);
@@ -181,5 +242,29 @@ Cs::enableServe(bool shouldServe)
   NFD_LOG_INFO((shouldServe ? "Enabling" : "Disabling") << " Data serving");
 }
 
+void
+Cs::setCentralitySource(const void* owner, CentralityFunction func)
+{
+  if (func == nullptr) {
+    m_centralitySources.erase(owner);
+  }
+  else {
+    m_centralitySources[owner] = std::move(func);
+  }
+}
+
+optional<double>
+Cs::getCentrality(const Name& name) const
+{
+  optional<double> centrality;
+  for (const auto& source : m_centralitySources) {
+    optional<double> c = source.second(name);
+    if (c && (!centrality || *c > *centrality)) {
+      centrality = c;
+    }
+  }
+  return centrality;
+}
+
 } // namespace cs
 } // namespace nfd
@@ -39,6 +39,10 @@ namespace cs {
  *  Data packets are wrapped in Entry objects. Each Entry contains the Data packet itself,
  *  and a few additional attributes such as when the Data becomes non-fresh.
  *
+ *  A hash index of the Table by Data name answers lookups of Interests without CanBePrefix,
+ *  including full names with implicit digest, in constant time. The ordered Table is searched
+ *  only for Interests with CanBePrefix, and for erasing by prefix.
+ *
  *  The replacement policy is implemented in a subclass of \c Policy.
  */
 class Cs : noncopyable
@@ -96,6 +100,14 @@ public:
     return m_table.size();
   }
 
+  /** \brief get number of bytes used by stored packets, as counted by Entry::getNBytes
+   */
+  size_t
+  getNBytes() const
+  {
+    return m_nBytes;
+  }
+
 public: // configuration
   /** \brief get capacity (in number of packets)
    */
@@ -113,6 +125,24 @@ public: // configuration
     return m_policy->setLimit(nMaxPackets);
   }
 
+  /** \brief get capacity (in number of bytes)
+   */
+  size_t
+  getByteLimit() const
+  {
+    return m_policy->getByteLimit();
+  }
+
+  /** \brief change capacity (in number of bytes)
+   *
+   *  Both the packet and the byte capacity are enforced; by default the byte capacity is unlimited.
+   */
+  void
+  setByteLimit(size_t nMaxBytes)
+  {
+    return m_policy->setByteLimit(nMaxBytes);
+  }
+
   /** \brief get replacement policy
    */
   Policy*
@@ -157,6 +187,26 @@ public: // configuration
   void
   enableServe(bool shouldServe);
 
+public: // centrality
+  /** \brief a function that returns the centrality of this node for a Data name,
+   *         between 0 and 1, or nullopt if it is unknown
+   */
+  using CentralityFunction = std::function<optional<double>(const Name&)>;
+
+  /** \brief set the centrality source of \p owner, or remove it if \p func is empty
+   *
+   *  Forwarding strategies that measure centrality provide it to the replacement policy
+   *  through a source. Sources are kept when the policy is changed.
+   */
+  void
+  setCentralitySource(const void* owner, CentralityFunction func);
+
+  /** \return the highest centrality for \p name among all sources,
+   *          or nullopt if no source knows it
+   */
+  optional<double>
+  getCentrality(const Name& name) const;
+
 public: // enumeration
   using const_iterator = Table::const_iterator;
 
@@ -182,6 +232,25 @@ private:
   const_iterator
   findImpl(const Interest& interest) const;
 
+  /** \brief find the best matching Data for an Interest without CanBePrefix, using m_nameIndex
+   */
+  const_iterator
+  findExactImpl(const Interest& interest) const;
+
+  /** \brief erase an entry from m_table and m_nameIndex, and release its bytes
+   *  \return iterator to the entry following the erased entry in m_table
+   */
+  const_iterator
+  eraseEntry(const_iterator i);
+
+  /** \return hash value of the first \p prefixLen components of \p name
+   *
+   *  Components are hashed together from the name's wire encoding, so a Data name and the full
+   *  name without its implicit digest component have the same hash value.
+   */
+  static uint64_t
+  hashName(const Name& name, size_t prefixLen);
+
   void
   setPolicyImpl(unique_ptr<Policy> policy);
 
@@ -191,9 +260,14 @@ NFD_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
 
 private:
   Table m_table;
+  /// entries of m_table by hash value of the Data name; entries with the same name share a key
+  std::unordered_multimap<uint64_t, const_iterator> m_nameIndex;
+  size_t m_nBytes = 0;
   unique_ptr<Policy> m_policy;
   signal::ScopedConnection m_beforeEvictConnection;
 
+  std::map<const void*, CentralityFunction> m_centralitySources;
+
   bool m_shouldAdmit = true; ///< if false, no Data will be admitted
   bool m_shouldServe = true; ///< if false, all lookups will miss
 };
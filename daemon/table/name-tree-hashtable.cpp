@@ -24,49 +24,31 @@
  */
 
 #include "name-tree-hashtable.hpp"
-#include "common/city-hash.hpp"
+#include "common/wy-hash.hpp"
 #include "common/logger.hpp"
 
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
 namespace nfd {
 namespace name_tree {
 
 NFD_LOG_INIT(NameTreeHashtable);
 
-class Hash32
-{
-public:
-  static HashValue
-  compute(const void* buffer, size_t length)
-  {
-    return static_cast<HashValue>(CityHash32(reinterpret_cast<const char*>(buffer), length));
-  }
-};
-
-class Hash64
-{
-public:
-  static HashValue
-  compute(const void* buffer, size_t length)
-  {
-    return static_cast<HashValue>(CityHash64(reinterpret_cast<const char*>(buffer), length));
-  }
-};
-
-/** \brief a type with compute static method to compute hash value from a raw buffer
- */
-using HashFunc = std::conditional<(sizeof(HashValue) > 4), Hash64, Hash32>::type;
-
 HashValue
 computeHash(const Name& name, size_t prefixLen)
 {
   name.wireEncode(); // ensure wire buffer exists
 
-  HashValue h = 0;
+  uint64_t h = 0;
   for (size_t i = 0, last = std::min(prefixLen, name.size()); i < last; ++i) {
     const name::Component& comp = name[i];
-    h ^= HashFunc::compute(comp.data(), comp.size());
+    h = WyHash64(comp.data(), comp.size(), h);
   }
-  return h;
+  return static_cast<HashValue>(h);
 }
 
 HashSequence
@@ -78,17 +60,41 @@ computeHashes(const Name& name, size_t prefixLen)
   HashSequence seq;
   seq.reserve(last + 1);
 
-  HashValue h = 0;
-  seq.push_back(h);
+  // each prefix hash seeds the hash of the next component, so all prefixes are hashed in one pass
+  uint64_t h = 0;
+  seq.push_back(static_cast<HashValue>(h));
 
   for (size_t i = 0; i < last; ++i) {
     const name::Component& comp = name[i];
-    h ^= HashFunc::compute(comp.data(), comp.size());
-    seq.push_back(h);
+    h = WyHash64(comp.data(), comp.size(), h);
+    seq.push_back(static_cast<HashValue>(h));
   }
   return seq;
 }
 
+HashesTag::HashesTag(const Block& nameWire, HashSequence hashes)
+  : m_buffer(nameWire.getBuffer())
+  , m_nameWire(nameWire.data())
+  , m_nameSize(nameWire.size())
+  , m_hashes(std::move(hashes))
+{
+}
+
+const HashSequence&
+getHashes(const ndn::TagHost& packet, const Name& name, size_t prefixLen)
+{
+  const Block& nameWire = name.wireEncode();
+  size_t nHashes = std::min(prefixLen, name.size()) + 1;
+
+  auto tag = packet.getTag<HashesTag>();
+  if (tag == nullptr || !tag->isFor(nameWire) || tag->get().size() < nHashes) {
+    tag = make_shared<HashesTag>(nameWire, computeHashes(name, prefixLen));
+    packet.setTag(tag);
+  }
+  // the packet keeps the tag alive
+  return tag->get();
+}
+
 Node::Node(HashValue h, const Name& name)
   : hash(h)
   , prev(nullptr)
@@ -109,15 +115,218 @@ getNode(const Entry& entry)
   return entry.m_node;
 }
 
+std::ostream&
+operator<<(std::ostream& os, HashtableLayout layout)
+{
+  switch (layout) {
+    case HashtableLayout::CHAINED:
+      return os << "chained";
+    case HashtableLayout::OPEN_ADDRESSING:
+      return os << "open-addressing";
+  }
+  return os << static_cast<int>(layout);
+}
+
 HashtableOptions::HashtableOptions(size_t size)
   : initialSize(size)
   , minSize(size)
 {
 }
 
+constexpr size_t HashtableResizeStats::N_HISTOGRAM_BINS;
+constexpr uint64_t HashtableResizeStats::STEP_TIMING_INTERVAL;
+
+void
+HashtableResizeStats::recordTimedStep(time::nanoseconds duration)
+{
+  ++nTimedSteps;
+  totalTime += duration;
+
+  auto us = time::duration_cast<time::microseconds>(duration).count();
+  size_t bin = 0;
+  while (us > 0 && bin < N_HISTOGRAM_BINS - 1) {
+    us >>= 1;
+    ++bin;
+  }
+  ++histogram[bin];
+}
+
+namespace {
+
+// Control bytes of open addressing: a full bucket holds the low 7 bits of its node's hash value,
+// so that only empty and deleted buckets have the high bit set.
+const uint8_t CTRL_EMPTY = 0x80;
+const uint8_t CTRL_DELETED = 0xFE;
+
+const float MAX_OPEN_LOAD_FACTOR = 0.875;
+
+/** \brief a bitmask with bit i set if the i-th control byte of a group matches
+ */
+using GroupMask = uint32_t;
+
+#if defined(__AVX2__)
+
+const size_t GROUP_WIDTH = 32;
+
+GroupMask
+matchByte(const uint8_t* group, uint8_t b)
+{
+  __m256i ctrl = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(group));
+  __m256i eq = _mm256_cmpeq_epi8(ctrl, _mm256_set1_epi8(static_cast<char>(b)));
+  return static_cast<GroupMask>(_mm256_movemask_epi8(eq));
+}
+
+GroupMask
+matchEmptyOrDeleted(const uint8_t* group)
+{
+  __m256i ctrl = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(group));
+  return static_cast<GroupMask>(_mm256_movemask_epi8(ctrl));
+}
+
+#elif defined(__SSE2__)
+
+const size_t GROUP_WIDTH = 16;
+
+GroupMask
+matchByte(const uint8_t* group, uint8_t b)
+{
+  __m128i ctrl = _mm_loadu_si128(reinterpret_cast<const __m128i*>(group));
+  __m128i eq = _mm_cmpeq_epi8(ctrl, _mm_set1_epi8(static_cast<char>(b)));
+  return static_cast<GroupMask>(_mm_movemask_epi8(eq));
+}
+
+GroupMask
+matchEmptyOrDeleted(const uint8_t* group)
+{
+  __m128i ctrl = _mm_loadu_si128(reinterpret_cast<const __m128i*>(group));
+  return static_cast<GroupMask>(_mm_movemask_epi8(ctrl));
+}
+
+#else
+
+const size_t GROUP_WIDTH = 16;
+
+GroupMask
+matchByte(const uint8_t* group, uint8_t b)
+{
+  GroupMask mask = 0;
+  for (size_t i = 0; i < GROUP_WIDTH; ++i) {
+    mask |= static_cast<GroupMask>(group[i] == b) << i;
+  }
+  return mask;
+}
+
+GroupMask
+matchEmptyOrDeleted(const uint8_t* group)
+{
+  GroupMask mask = 0;
+  for (size_t i = 0; i < GROUP_WIDTH; ++i) {
+    mask |= static_cast<GroupMask>((group[i] & 0x80) != 0) << i;
+  }
+  return mask;
+}
+
+#endif
+
+/** \return index of the lowest set bit
+ *  \pre mask != 0
+ */
+size_t
+lowestBit(GroupMask mask)
+{
+  return static_cast<size_t>(__builtin_ctz(mask));
+}
+
+uint8_t
+computeTag(HashValue h)
+{
+  return static_cast<uint8_t>(h & 0x7F);
+}
+
+/** \return index of the first group probed for hash value h
+ *  \pre nGroups is a power of two
+ */
+size_t
+computeHomeGroup(HashValue h, size_t nGroups)
+{
+  return static_cast<size_t>(h >> 7) & (nGroups - 1);
+}
+
+/** \return smallest power of two that is a multiple of GROUP_WIDTH and not less than n
+ */
+size_t
+roundToGroups(size_t n)
+{
+  size_t nBuckets = GROUP_WIDTH;
+  while (nBuckets < n) {
+    nBuckets <<= 1;
+  }
+  return nBuckets;
+}
+
+} // namespace
+
+/** \brief allocates storage for nodes in chunks, and recycles the storage of destroyed nodes
+ */
+class Hashtable::NodePool : noncopyable
+{
+public:
+  void*
+  allocate()
+  {
+    if (m_free.empty()) {
+      this->grow();
+    }
+    void* storage = m_free.back();
+    m_free.pop_back();
+    return storage;
+  }
+
+  void
+  deallocate(void* storage)
+  {
+    m_free.push_back(storage);
+  }
+
+private:
+  void
+  grow()
+  {
+    // chunks double in size, so that small tables stay small and large tables need few chunks
+    size_t nSlots = m_chunks.size() < MAX_CHUNK_SHIFT ? MIN_CHUNK_SIZE << m_chunks.size() : MAX_CHUNK_SIZE;
+    m_chunks.emplace_back(new Storage[nSlots]);
+    Storage* chunk = m_chunks.back().get();
+    // hand out slots in address order
+    for (size_t i = nSlots; i > 0; --i) {
+      m_free.push_back(&chunk[i - 1]);
+    }
+  }
+
+private:
+  using Storage = std::aligned_storage_t<sizeof(Node), alignof(Node)>;
+
+  static constexpr size_t MIN_CHUNK_SIZE = 16;
+  static constexpr size_t MAX_CHUNK_SHIFT = 6;
+  static constexpr size_t MAX_CHUNK_SIZE = MIN_CHUNK_SIZE << MAX_CHUNK_SHIFT;
+
+  std::vector<unique_ptr<Storage[]>> m_chunks;
+  std::vector<void*> m_free;
+};
+
+Hashtable::BucketArray::BucketArray(HashtableLayout layout, size_t nBuckets)
+  : buckets(nBuckets)
+{
+  if (layout == HashtableLayout::OPEN_ADDRESSING) {
+    BOOST_ASSERT(nBuckets == roundToGroups(nBuckets));
+    ctrl.assign(nBuckets, CTRL_EMPTY);
+  }
+}
+
 Hashtable::Hashtable(const Options& options)
-  : m_options(options)
+  : m_migrationCursor(0)
+  , m_options(options)
   , m_size(0)
+  , m_pool(make_unique<NodePool>())
 {
   BOOST_ASSERT(m_options.minSize > 0);
   BOOST_ASSERT(m_options.initialSize >= m_options.minSize);
@@ -129,44 +338,91 @@ Hashtable::Hashtable(const Options& options)
   BOOST_ASSERT(m_options.shrinkFactor > 0.0);
   BOOST_ASSERT(m_options.shrinkFactor < 1.0);
 
-  m_buckets.resize(options.initialSize);
+  size_t nBuckets = options.initialSize;
+  if (m_options.layout == HashtableLayout::OPEN_ADDRESSING) {
+    nBuckets = roundToGroups(nBuckets);
+  }
+  m_table = BucketArray(m_options.layout, nBuckets);
   this->computeThresholds();
 }
 
 Hashtable::~Hashtable()
 {
-  for (size_t i = 0; i < m_buckets.size(); ++i) {
-    foreachNode(m_buckets[i], [] (Node* node) {
-      node->prev = node->next = nullptr;
-      delete node;
-    });
+  for (BucketArray* table : {&m_table, &m_oldTable}) {
+    for (Node* head : table->buckets) {
+      foreachNode(head, [this] (Node* node) {
+        node->prev = node->next = nullptr;
+        this->destroyNode(node);
+      });
+    }
+  }
+}
+
+Node*
+Hashtable::createNode(HashValue h, const Name& name)
+{
+  return new (m_pool->allocate()) Node(h, name);
+}
+
+void
+Hashtable::destroyNode(Node* node)
+{
+  node->~Node();
+  m_pool->deallocate(node);
+}
+
+size_t
+Hashtable::computeBucketIndex(HashValue h) const
+{
+  if (m_options.layout == HashtableLayout::OPEN_ADDRESSING) {
+    return computeHomeGroup(h, this->getNBuckets() / GROUP_WIDTH) * GROUP_WIDTH;
   }
+  return h % this->getNBuckets();
+}
+
+size_t
+Hashtable::getBucketIndex(const Node* node) const
+{
+  if (m_options.layout == HashtableLayout::OPEN_ADDRESSING) {
+    size_t bucket = findBucketOpen(m_table, node);
+    if (bucket == m_table.buckets.size() && this->isResizing()) {
+      bucket += findBucketOpen(m_oldTable, node);
+    }
+    BOOST_ASSERT_MSG(bucket < this->getNBucketIndices(), "node does not exist in this hashtable");
+    return bucket;
+  }
+
+  auto tableAndBucket = const_cast<Hashtable*>(this)->selectChainedBucket(node->hash);
+  if (tableAndBucket.first == &m_oldTable) {
+    return m_table.buckets.size() + tableAndBucket.second;
+  }
+  return tableAndBucket.second;
 }
 
 void
-Hashtable::attach(size_t bucket, Node* node)
+Hashtable::attach(BucketArray& table, size_t bucket, Node* node)
 {
   node->prev = nullptr;
-  node->next = m_buckets[bucket];
+  node->next = table.buckets[bucket];
 
   if (node->next != nullptr) {
     BOOST_ASSERT(node->next->prev == nullptr);
     node->next->prev = node;
   }
 
-  m_buckets[bucket] = node;
+  table.buckets[bucket] = node;
 }
 
 void
-Hashtable::detach(size_t bucket, Node* node)
+Hashtable::detach(BucketArray& table, size_t bucket, Node* node)
 {
   if (node->prev != nullptr) {
     BOOST_ASSERT(node->prev->next == node);
     node->prev->next = node->next;
   }
   else {
-    BOOST_ASSERT(m_buckets[bucket] == node);
-    m_buckets[bucket] = node->next;
+    BOOST_ASSERT(table.buckets[bucket] == node);
+    table.buckets[bucket] = node->next;
   }
 
   if (node->next != nullptr) {
@@ -177,12 +433,37 @@ Hashtable::detach(size_t bucket, Node* node)
   node->prev = node->next = nullptr;
 }
 
+std::pair<Hashtable::BucketArray*, size_t>
+Hashtable::selectChainedBucket(HashValue h)
+{
+  // Old buckets are migrated in index order, so nodes of an old bucket at or above the cursor
+  // are all still in the old bucket array, and new nodes join them there.
+  if (this->isResizing()) {
+    size_t oldBucket = h % m_oldTable.buckets.size();
+    if (oldBucket >= m_migrationCursor) {
+      return {&m_oldTable, oldBucket};
+    }
+  }
+  return {&m_table, h % m_table.buckets.size()};
+}
+
 std::pair<const Node*, bool>
 Hashtable::findOrInsert(const Name& name, size_t prefixLen, HashValue h, bool allowInsert)
 {
-  size_t bucket = this->computeBucketIndex(h);
+  // a lookup leaves the buckets alone, see find()
+  if (allowInsert) {
+    this->migrate(m_options.migrationStep);
+  }
+
+  if (m_options.layout == HashtableLayout::OPEN_ADDRESSING) {
+    return this->findOrInsertOpen(name, prefixLen, h, allowInsert);
+  }
 
-  for (const Node* node = m_buckets[bucket]; node != nullptr; node = node->next) {
+  BucketArray* table = nullptr;
+  size_t bucket = 0;
+  std::tie(table, bucket) = this->selectChainedBucket(h);
+
+  for (const Node* node = table->buckets[bucket]; node != nullptr; node = node->next) {
     if (node->hash == h && name.compare(0, prefixLen, node->entry.getName()) == 0) {
       NFD_LOG_TRACE("found " << name.getPrefix(prefixLen) << " hash=" << h << " bucket=" << bucket);
       return {node, false};
@@ -194,8 +475,8 @@ Hashtable::findOrInsert(const Name& name, size_t prefixLen, HashValue h, bool al
     return {nullptr, false};
   }
 
-  Node* node = new Node(h, name.getPrefix(prefixLen));
-  this->attach(bucket, node);
+  Node* node = this->createNode(h, name.getPrefix(prefixLen));
+  attach(*table, bucket, node);
   NFD_LOG_TRACE("insert " << node->entry.getName() << " hash=" << h << " bucket=" << bucket);
   ++m_size;
 
@@ -206,6 +487,142 @@ Hashtable::findOrInsert(const Name& name, size_t prefixLen, HashValue h, bool al
   return {node, true};
 }
 
+std::pair<const Node*, bool>
+Hashtable::findOrInsertOpen(const Name& name, size_t prefixLen, HashValue h, bool allowInsert)
+{
+  size_t freeBucket = m_table.buckets.size();
+  const Node* found = findOpen(m_table, name, prefixLen, h, allowInsert ? &freeBucket : nullptr);
+  if (found == nullptr && this->isResizing()) {
+    found = findOpen(m_oldTable, name, prefixLen, h, nullptr);
+  }
+
+  if (found != nullptr) {
+    NFD_LOG_TRACE("found " << name.getPrefix(prefixLen) << " hash=" << h);
+    return {found, false};
+  }
+
+  if (!allowInsert) {
+    NFD_LOG_TRACE("not-found " << name.getPrefix(prefixLen) << " hash=" << h);
+    return {nullptr, false};
+  }
+
+  // new nodes always go into the new bucket array
+  Node* node = this->createNode(h, name.getPrefix(prefixLen));
+  BOOST_ASSERT(freeBucket < m_table.buckets.size());
+  if (m_table.ctrl[freeBucket] == CTRL_DELETED) {
+    --m_table.nTombstones;
+  }
+  m_table.ctrl[freeBucket] = computeTag(h);
+  m_table.buckets[freeBucket] = node;
+  NFD_LOG_TRACE("insert " << node->entry.getName() << " hash=" << h << " bucket=" << freeBucket);
+  ++m_size;
+
+  if (m_size > m_expandThreshold) {
+    this->resize(static_cast<size_t>(m_options.expandFactor * this->getNBuckets()));
+  }
+  else if (m_size + m_table.nTombstones > m_expandThreshold) {
+    // deleted buckets lengthen probes and would eventually leave no empty bucket to end them
+    NFD_LOG_DEBUG("purge tombstones=" << m_table.nTombstones);
+    this->startResize(this->getNBuckets());
+  }
+
+  return {node, true};
+}
+
+const Node*
+Hashtable::findOpen(const BucketArray& table, const Name& name, size_t prefixLen, HashValue h,
+                    size_t* freeBucket)
+{
+  size_t nGroups = table.buckets.size() / GROUP_WIDTH;
+  size_t group = computeHomeGroup(h, nGroups);
+  uint8_t tag = computeTag(h);
+
+  // Probe groups in triangular order, which visits every group because nGroups is a power of two.
+  // The probe ends at a group with an empty bucket, which always exists below the load limit.
+  for (size_t step = 1; ; ++step) {
+    size_t base = group * GROUP_WIDTH;
+    const uint8_t* ctrl = &table.ctrl[base];
+
+    for (GroupMask match = matchByte(ctrl, tag); match != 0; match &= match - 1) {
+      const Node* node = table.buckets[base + lowestBit(match)];
+      if (node->hash == h && name.compare(0, prefixLen, node->entry.getName()) == 0) {
+        return node;
+      }
+    }
+
+    if (freeBucket != nullptr && *freeBucket == table.buckets.size()) {
+      GroupMask available = matchEmptyOrDeleted(ctrl);
+      if (available != 0) {
+        *freeBucket = base + lowestBit(available);
+      }
+    }
+
+    if (matchByte(ctrl, CTRL_EMPTY) != 0) {
+      return nullptr;
+    }
+    BOOST_ASSERT(step < nGroups);
+    group = (group + step) & (nGroups - 1);
+  }
+}
+
+size_t
+Hashtable::findBucketOpen(const BucketArray& table, const Node* node)
+{
+  size_t nGroups = table.buckets.size() / GROUP_WIDTH;
+  size_t group = computeHomeGroup(node->hash, nGroups);
+  uint8_t tag = computeTag(node->hash);
+
+  for (size_t step = 1; step <= nGroups; ++step) {
+    size_t base = group * GROUP_WIDTH;
+    const uint8_t* ctrl = &table.ctrl[base];
+    for (GroupMask match = matchByte(ctrl, tag); match != 0; match &= match - 1) {
+      size_t bucket = base + lowestBit(match);
+      if (table.buckets[bucket] == node) {
+        return bucket;
+      }
+    }
+    if (matchByte(ctrl, CTRL_EMPTY) != 0) {
+      break;
+    }
+    group = (group + step) & (nGroups - 1);
+  }
+  return table.buckets.size();
+}
+
+void
+Hashtable::placeOpen(BucketArray& table, Node* node)
+{
+  size_t nGroups = table.buckets.size() / GROUP_WIDTH;
+  size_t group = computeHomeGroup(node->hash, nGroups);
+
+  for (size_t step = 1; ; ++step) {
+    size_t base = group * GROUP_WIDTH;
+    GroupMask available = matchEmptyOrDeleted(&table.ctrl[base]);
+    if (available != 0) {
+      size_t bucket = base + lowestBit(available);
+      if (table.ctrl[bucket] == CTRL_DELETED) {
+        --table.nTombstones;
+      }
+      table.ctrl[bucket] = computeTag(node->hash);
+      table.buckets[bucket] = node;
+      return;
+    }
+    BOOST_ASSERT(step < nGroups);
+    group = (group + step) & (nGroups - 1);
+  }
+}
+
+void
+Hashtable::place(Node* node)
+{
+  if (m_options.layout == HashtableLayout::OPEN_ADDRESSING) {
+    placeOpen(m_table, node);
+  }
+  else {
+    attach(m_table, this->computeBucketIndex(node->hash), node);
+  }
+}
+
 const Node*
 Hashtable::find(const Name& name, size_t prefixLen) const
 {
@@ -233,11 +650,41 @@ Hashtable::erase(Node* node)
   BOOST_ASSERT(node != nullptr);
   BOOST_ASSERT(node->entry.getParent() == nullptr);
 
-  size_t bucket = this->computeBucketIndex(node->hash);
-  NFD_LOG_TRACE("erase " << node->entry.getName() << " hash=" << node->hash << " bucket=" << bucket);
+  this->migrate(m_options.migrationStep);
 
-  this->detach(bucket, node);
-  delete node;
+  if (m_options.layout == HashtableLayout::OPEN_ADDRESSING) {
+    NFD_LOG_TRACE("erase " << node->entry.getName() << " hash=" << node->hash);
+    BucketArray* table = &m_table;
+    size_t bucket = findBucketOpen(m_table, node);
+    if (bucket == m_table.buckets.size()) {
+      table = &m_oldTable;
+      bucket = findBucketOpen(m_oldTable, node);
+    }
+    BOOST_ASSERT(bucket < table->buckets.size());
+    table->buckets[bucket] = nullptr;
+
+    // A group that still has an empty bucket has never been full since the bucket array was
+    // allocated, so no probe has passed it and the bucket can become empty. Otherwise a probe
+    // may have continued past this group, and the bucket must be marked as deleted to keep
+    // that probe going.
+    const uint8_t* group = &table->ctrl[bucket - bucket % GROUP_WIDTH];
+    if (matchByte(group, CTRL_EMPTY) != 0) {
+      table->ctrl[bucket] = CTRL_EMPTY;
+    }
+    else {
+      table->ctrl[bucket] = CTRL_DELETED;
+      ++table->nTombstones;
+    }
+  }
+  else {
+    BucketArray* table = nullptr;
+    size_t bucket = 0;
+    std::tie(table, bucket) = this->selectChainedBucket(node->hash);
+    NFD_LOG_TRACE("erase " << node->entry.getName() << " hash=" << node->hash << " bucket=" << bucket);
+    detach(*table, bucket, node);
+  }
+
+  this->destroyNode(node);
   --m_size;
 
   if (m_size < m_shrinkThreshold) {
@@ -247,10 +694,37 @@ Hashtable::erase(Node* node)
   }
 }
 
+void
+Hashtable::setLayout(HashtableLayout layout)
+{
+  if (m_options.layout == layout) {
+    return;
+  }
+  this->finishResize();
+
+  size_t newNBuckets = std::max(m_options.minSize, this->getNBuckets());
+  if (layout == HashtableLayout::OPEN_ADDRESSING) {
+    newNBuckets = roundToGroups(newNBuckets);
+  }
+  NFD_LOG_DEBUG("layout from=" << m_options.layout << " to=" << layout << " nBuckets=" << newNBuckets);
+
+  // the old bucket array keeps the old layout, which only a migration in one pass can handle
+  m_options.layout = layout;
+  ++m_resizeStats.nResizes;
+  m_oldTable = std::exchange(m_table, BucketArray(layout, newNBuckets));
+  m_migrationCursor = 0;
+  this->computeThresholds();
+  this->finishResize();
+}
+
 void
 Hashtable::computeThresholds()
 {
-  m_expandThreshold = static_cast<size_t>(m_options.expandLoadFactor * this->getNBuckets());
+  float expandLoadFactor = m_options.expandLoadFactor;
+  if (m_options.layout == HashtableLayout::OPEN_ADDRESSING) {
+    expandLoadFactor = std::min(expandLoadFactor, MAX_OPEN_LOAD_FACTOR);
+  }
+  m_expandThreshold = static_cast<size_t>(expandLoadFactor * this->getNBuckets());
   m_shrinkThreshold = static_cast<size_t>(m_options.shrinkLoadFactor * this->getNBuckets());
   NFD_LOG_TRACE("thresholds expand=" << m_expandThreshold << " shrink=" << m_shrinkThreshold);
 }
@@ -258,23 +732,81 @@ Hashtable::computeThresholds()
 void
 Hashtable::resize(size_t newNBuckets)
 {
+  if (m_options.layout == HashtableLayout::OPEN_ADDRESSING) {
+    newNBuckets = roundToGroups(newNBuckets);
+  }
   if (this->getNBuckets() == newNBuckets) {
     return;
   }
   NFD_LOG_DEBUG("resize from=" << this->getNBuckets() << " to=" << newNBuckets);
 
-  std::vector<Node*> oldBuckets;
-  oldBuckets.swap(m_buckets);
-  m_buckets.resize(newNBuckets);
+  this->startResize(newNBuckets);
+}
+
+void
+Hashtable::startResize(size_t newNBuckets)
+{
+  // a resize that is needed before the previous one completes first finishes the previous one
+  this->finishResize();
+
+  ++m_resizeStats.nResizes;
+  m_oldTable = std::exchange(m_table, BucketArray(m_options.layout, newNBuckets));
+  m_migrationCursor = 0;
+  this->computeThresholds();
+
+  if (m_options.migrationStep == 0) {
+    this->finishResize();
+  }
+}
+
+void
+Hashtable::finishResize()
+{
+  this->migrate(std::numeric_limits<size_t>::max());
+}
 
-  for (Node* head : oldBuckets) {
+void
+Hashtable::migrate(size_t nBuckets)
+{
+  if (!this->isResizing() || nBuckets == 0) {
+    return;
+  }
+  bool isTimed = nBuckets == std::numeric_limits<size_t>::max() ||
+                 m_resizeStats.nSteps % HashtableResizeStats::STEP_TIMING_INTERVAL == 0;
+  time::steady_clock::TimePoint t1;
+  if (isTimed) {
+    t1 = time::steady_clock::now();
+  }
+
+  size_t end = m_oldTable.buckets.size();
+  if (end - m_migrationCursor > nBuckets) {
+    end = m_migrationCursor + nBuckets;
+  }
+  bool isOldOpen = !m_oldTable.ctrl.empty();
+
+  for (; m_migrationCursor < end; ++m_migrationCursor) {
+    Node*& head = m_oldTable.buckets[m_migrationCursor];
     foreachNode(head, [this] (Node* node) {
-      size_t bucket = this->computeBucketIndex(node->hash);
-      this->attach(bucket, node);
+      node->prev = node->next = nullptr;
+      this->place(node);
     });
+    head = nullptr;
+    if (isOldOpen && m_oldTable.ctrl[m_migrationCursor] != CTRL_EMPTY) {
+      // keep probes in the old bucket array going past migrated buckets
+      m_oldTable.ctrl[m_migrationCursor] = CTRL_DELETED;
+    }
   }
 
-  this->computeThresholds();
+  if (m_migrationCursor == m_oldTable.buckets.size()) {
+    NFD_LOG_DEBUG("resize completed nBuckets=" << this->getNBuckets());
+    m_oldTable = BucketArray();
+    m_migrationCursor = 0;
+  }
+
+  ++m_resizeStats.nSteps;
+  if (isTimed) {
+    m_resizeStats.recordTimedStep(time::steady_clock::now() - t1);
+  }
 }
 
 } // namespace name_tree
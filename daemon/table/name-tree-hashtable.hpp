@@ -28,6 +28,12 @@
 
 #include "name-tree-entry.hpp"
 
+#include <ndn-cxx/tag-host.hpp>
+
+#include <boost/container/small_vector.hpp>
+
+#include <array>
+
 namespace nfd {
 namespace name_tree {
 
@@ -38,9 +44,11 @@ class Entry;
 using HashValue = size_t;
 
 /** \brief a sequence of hash values
+ *
+ *  Names of most packets are short enough for their hash values to be stored inline.
  *  \sa computeHashes
  */
-using HashSequence = std::vector<HashValue>;
+using HashSequence = boost::container::small_vector<HashValue, 16>;
 
 /** \brief computes hash value of \p name.getPrefix(prefixLen)
  */
@@ -53,6 +61,69 @@ computeHash(const Name& name, size_t prefixLen = std::numeric_limits<size_t>::ma
 HashSequence
 computeHashes(const Name& name, size_t prefixLen = std::numeric_limits<size_t>::max());
 
+/** \brief a packet tag that caches the hash values of the prefixes of the packet's name
+ *  \sa getHashes
+ */
+class HashesTag : public ndn::Tag
+{
+public:
+  static constexpr int
+  getTypeId() noexcept
+  {
+    return 0x4e544801;
+  }
+
+  /** \param nameWire wire encoding of the name that \p hashes are computed from
+   */
+  HashesTag(const Block& nameWire, HashSequence hashes);
+
+  const HashSequence&
+  get() const
+  {
+    return m_hashes;
+  }
+
+  /** \return whether the hash values are computed from the name encoded as \p nameWire
+   *
+   *  Changing the name of a packet gives it a new wire encoding, so a tag left on the packet
+   *  does not apply to the new name.
+   */
+  bool
+  isFor(const Block& nameWire) const
+  {
+    return m_nameWire == nameWire.data() && m_nameSize == nameWire.size();
+  }
+
+private:
+  ndn::ConstBufferPtr m_buffer; // keeps m_nameWire alive, so that another name cannot reuse it
+  const uint8_t* m_nameWire;
+  size_t m_nameSize;
+  HashSequence m_hashes;
+};
+
+/** \brief computes hash values for each prefix of \p name.getPrefix(prefixLen), or reuses those
+ *         cached on \p packet by a previous call
+ *  \param packet an Interest or Data
+ *  \param name the name of \p packet
+ *  \return a hash sequence that has at least min(prefixLen, name.size())+1 hash values,
+ *          where the i-th hash value equals computeHash(name, i)
+ *  \note The sequence is cached in a HashesTag on \p packet, and remains valid until a longer
+ *        sequence replaces it or the packet is destroyed.
+ */
+const HashSequence&
+getHashes(const ndn::TagHost& packet, const Name& name,
+          size_t prefixLen = std::numeric_limits<size_t>::max());
+
+/** \brief equivalent to `getHashes(packet, packet.getName(), prefixLen)`
+ *  \tparam Packet Interest or Data
+ */
+template<typename Packet>
+const HashSequence&
+getHashes(const Packet& packet, size_t prefixLen = std::numeric_limits<size_t>::max())
+{
+  return getHashes(packet, packet.getName(), prefixLen);
+}
+
 /** \brief a hashtable node
  *
  *  Zero or more nodes can be added to a hashtable bucket. They are organized as
@@ -101,6 +172,27 @@ foreachNode(N* head, const F& func)
   }
 }
 
+/** \brief how a Hashtable organizes its buckets
+ */
+enum class HashtableLayout {
+  /** \brief each bucket is a doubly linked list of nodes,
+   *         and a node goes into the bucket selected by its hash value
+   */
+  CHAINED,
+  /** \brief each bucket holds at most one node; a node goes into the first free bucket
+   *         along a probe sequence of bucket groups selected by its hash value
+   *
+   *  A control byte per bucket holds a 7-bit tag of the hash value, or marks the bucket
+   *  as empty or deleted. A lookup compares the tag against a whole group of control bytes
+   *  at once (with SSE2 or AVX2 when available), and dereferences only the nodes whose
+   *  tags match, so that it touches few cache lines besides the matching node.
+   */
+  OPEN_ADDRESSING,
+};
+
+std::ostream&
+operator<<(std::ostream& os, HashtableLayout layout);
+
 /** \brief provides options for Hashtable
  */
 class HashtableOptions
@@ -137,16 +229,82 @@ public:
   /** \brief when hashtable is shrunk, its new size is max(nBuckets*shrinkFactor, minSize)
    */
   float shrinkFactor = 0.5;
+
+  /** \brief how buckets are organized
+   *
+   *  With HashtableLayout::OPEN_ADDRESSING, the number of buckets is rounded up to a power of two
+   *  that is a multiple of the group width, and expandLoadFactor is capped at 0.875.
+   */
+  HashtableLayout layout = HashtableLayout::CHAINED;
+
+  /** \brief number of buckets migrated from the old bucket array per insert or erase
+   *         while the hashtable is resized; zero resizes in one pass
+   *
+   *  A resize allocates the new bucket array, and then migrates the old buckets a few at a time,
+   *  so that no single operation rehashes every node. Both bucket arrays are searched meanwhile.
+   *  Lookups do not migrate, so that they never move nodes under an ongoing enumeration.
+   */
+  size_t migrationStep = 16;
+};
+
+/** \brief counters of the time a Hashtable spends resizing
+ *
+ *  Reading the clock costs about as much as migrating a few buckets, so only one in
+ *  STEP_TIMING_INTERVAL incremental steps is timed. Every resize done in one pass is timed.
+ */
+class HashtableResizeStats
+{
+public:
+  /** \brief number of histogram bins
+   *
+   *  Bin 0 counts steps shorter than 1 microsecond. Bin i counts steps of at least 2^(i-1)
+   *  and less than 2^i microseconds, and the last bin also counts all longer steps.
+   */
+  static constexpr size_t N_HISTOGRAM_BINS = 16;
+
+  /** \brief one in this many incremental steps is timed
+   */
+  static constexpr uint64_t STEP_TIMING_INTERVAL = 64;
+
+  /** \brief count a timed resize step that took \p duration
+   */
+  void
+  recordTimedStep(time::nanoseconds duration);
+
+public:
+  /** \brief number of resizes started
+   */
+  uint64_t nResizes = 0;
+
+  /** \brief number of steps that migrated buckets, including resizes done in one pass
+   */
+  uint64_t nSteps = 0;
+
+  /** \brief number of steps that were timed
+   */
+  uint64_t nTimedSteps = 0;
+
+  /** \brief total time spent in the timed steps
+   */
+  time::nanoseconds totalTime = time::nanoseconds::zero();
+
+  /** \brief number of timed steps by duration
+   */
+  std::array<uint64_t, N_HISTOGRAM_BINS> histogram{};
 };
 
 /** \brief a hashtable for fast exact name lookup
  *
  *  The Hashtable contains a number of buckets.
  *  Each node is placed into a bucket determined by a hash value computed from its name.
- *  Hash collision is resolved through a doubly linked list in each bucket.
+ *  Hash collision is resolved through a doubly linked list in each bucket, or through probing
+ *  with HashtableLayout::OPEN_ADDRESSING.
  *  The number of buckets is adjusted according to how many nodes are stored.
+ *
+ *  Nodes are allocated from a pool owned by the hashtable, and never move while they are stored.
+ *  Memory of erased nodes is reused for new nodes, and is only released with the hashtable.
  */
-class Hashtable
+class Hashtable : noncopyable
 {
 public:
   typedef HashtableOptions Options;
@@ -171,29 +329,83 @@ public:
   size_t
   getNBuckets() const
   {
-    return m_buckets.size();
+    return m_table.buckets.size();
   }
 
-  /** \return bucket index for hash value h
+  HashtableLayout
+  getLayout() const
+  {
+    return m_options.layout;
+  }
+
+  /** \brief reorganize all buckets in \p layout
+   *
+   *  Nodes are kept, so that references to them remain valid.
+   *  This completes any ongoing resize, and migrates all nodes in one pass.
+   */
+  void
+  setLayout(HashtableLayout layout);
+
+  /** \return index of the bucket for hash value h, or the first bucket probed for it
+   *          with HashtableLayout::OPEN_ADDRESSING
    */
   size_t
-  computeBucketIndex(HashValue h) const
+  computeBucketIndex(HashValue h) const;
+
+  /** \return whether the old bucket array of a resize still has nodes to migrate
+   */
+  bool
+  isResizing() const
   {
-    return h % this->getNBuckets();
+    return !m_oldTable.buckets.empty();
   }
 
-  /** \return i-th bucket
-   *  \pre bucket < getNBuckets()
+  /** \brief migrate all remaining nodes of an ongoing resize
+   */
+  void
+  finishResize();
+
+  const HashtableResizeStats&
+  getResizeStats() const
+  {
+    return m_resizeStats;
+  }
+
+  /** \return number of bucket indices accepted by getBucket
+   *
+   *  This exceeds getNBuckets() while the hashtable is resizing: indices from getNBuckets()
+   *  refer to the buckets of the old bucket array.
+   */
+  size_t
+  getNBucketIndices() const
+  {
+    return m_table.buckets.size() + m_oldTable.buckets.size();
+  }
+
+  /** \return i-th bucket, which contains at most one node with HashtableLayout::OPEN_ADDRESSING
+   *  \pre bucket < getNBucketIndices()
    */
   const Node*
   getBucket(size_t bucket) const
   {
-    BOOST_ASSERT(bucket < this->getNBuckets());
-    return m_buckets[bucket]; // don't use m_bucket.at() for better performance
+    BOOST_ASSERT(bucket < this->getNBucketIndices());
+    // don't use .at() for better performance
+    if (bucket < m_table.buckets.size()) {
+      return m_table.buckets[bucket];
+    }
+    return m_oldTable.buckets[bucket - m_table.buckets.size()];
   }
 
+  /** \return index of the bucket that contains \p node, as accepted by getBucket
+   *  \pre node exists in this hashtable
+   */
+  size_t
+  getBucketIndex(const Node* node) const;
+
   /** \brief find node for name.getPrefix(prefixLen)
    *  \pre name.size() > prefixLen
+   *  \note This does not migrate buckets of an ongoing resize, so that a lookup never moves nodes
+   *        between the bucket indices walked by an enumeration.
    */
   const Node*
   find(const Name& name, size_t prefixLen) const;
@@ -208,42 +420,112 @@ public:
   /** \brief find or insert node for name.getPrefix(prefixLen)
    *  \pre name.size() > prefixLen
    *  \pre hashes == computeHashes(name)
+   *  \note While the hashtable is resizing, this also migrates a few buckets.
    */
   std::pair<const Node*, bool>
   insert(const Name& name, size_t prefixLen, const HashSequence& hashes);
 
   /** \brief delete node
    *  \pre node exists in this hashtable
+   *  \note While the hashtable is resizing, this also migrates a few buckets.
    */
   void
   erase(Node* node);
 
 private:
-  /** \brief attach node to bucket
+  /** \brief an array of buckets, and the control bytes of open addressing
    */
+  struct BucketArray
+  {
+    BucketArray() = default;
+
+    BucketArray(HashtableLayout layout, size_t nBuckets);
+
+    std::vector<Node*> buckets;
+    std::vector<uint8_t> ctrl; ///< control bytes, only with HashtableLayout::OPEN_ADDRESSING
+    size_t nTombstones = 0; ///< buckets marked as deleted
+  };
+
+  Node*
+  createNode(HashValue h, const Name& name);
+
   void
-  attach(size_t bucket, Node* node);
+  destroyNode(Node* node);
+
+  /** \brief attach node to bucket
+   */
+  static void
+  attach(BucketArray& table, size_t bucket, Node* node);
 
   /** \brief detach node from bucket
    */
-  void
-  detach(size_t bucket, Node* node);
+  static void
+  detach(BucketArray& table, size_t bucket, Node* node);
+
+  /** \return the array that holds, or would hold, the nodes with hash value h in a chained bucket
+   *  \pre layout is HashtableLayout::CHAINED
+   */
+  std::pair<BucketArray*, size_t>
+  selectChainedBucket(HashValue h);
 
   std::pair<const Node*, bool>
   findOrInsert(const Name& name, size_t prefixLen, HashValue h, bool allowInsert);
 
+  std::pair<const Node*, bool>
+  findOrInsertOpen(const Name& name, size_t prefixLen, HashValue h, bool allowInsert);
+
+  /** \brief find node for name.getPrefix(prefixLen) in an open addressing bucket array
+   *  \param[out] freeBucket if not nullptr, receives the first free bucket along the probe sequence
+   */
+  static const Node*
+  findOpen(const BucketArray& table, const Name& name, size_t prefixLen, HashValue h,
+           size_t* freeBucket);
+
+  /** \return index of the bucket that contains node in an open addressing bucket array,
+   *          or table.buckets.size() if it is not there
+   */
+  static size_t
+  findBucketOpen(const BucketArray& table, const Node* node);
+
+  /** \brief place node into the first free bucket of its probe sequence
+   *  \pre node does not exist in table
+   */
+  static void
+  placeOpen(BucketArray& table, Node* node);
+
+  /** \brief place node into the current bucket array
+   */
+  void
+  place(Node* node);
+
   void
   computeThresholds();
 
   void
   resize(size_t newNBuckets);
 
+  /** \brief allocate a new bucket array in the current layout, and start migrating into it
+   */
+  void
+  startResize(size_t newNBuckets);
+
+  /** \brief migrate at most \p nBuckets buckets of the old bucket array
+   */
+  void
+  migrate(size_t nBuckets);
+
 private:
-  std::vector<Node*> m_buckets;
+  class NodePool;
+
+  BucketArray m_table;
+  BucketArray m_oldTable; ///< buckets being migrated by a resize, empty otherwise
+  size_t m_migrationCursor; ///< buckets of m_oldTable below this index have been migrated
   Options m_options;
   size_t m_size;
   size_t m_expandThreshold;
   size_t m_shrinkThreshold;
+  unique_ptr<NodePool> m_pool;
+  HashtableResizeStats m_resizeStats;
 };
 
 } // namespace name_tree
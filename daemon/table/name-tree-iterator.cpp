@@ -116,7 +116,7 @@ FullEnumerationImpl::advance(Iterator& i)
 {
   // find first entry
   if (i.m_entry == nullptr) {
-    for (size_t bucket = 0; bucket < ht.getNBuckets(); ++bucket) {
+    for (size_t bucket = 0; bucket < ht.getNBucketIndices(); ++bucket) {
       const Node* node = ht.getBucket(bucket);
       if (node != nullptr) {
         i.m_entry = &node->entry;
@@ -141,8 +141,8 @@ FullEnumerationImpl::advance(Iterator& i)
   }
 
   // process other buckets
-  size_t currentBucket = ht.computeBucketIndex(getNode(*i.m_entry)->hash);
-  for (size_t bucket = currentBucket + 1; bucket < ht.getNBuckets(); ++bucket) {
+  size_t currentBucket = ht.getBucketIndex(getNode(*i.m_entry));
+  for (size_t bucket = currentBucket + 1; bucket < ht.getNBucketIndices(); ++bucket) {
     for (const Node* node = ht.getBucket(bucket); node != nullptr; node = node->next) {
       if (m_pred(node->entry)) {
         i.m_entry = &node->entry;
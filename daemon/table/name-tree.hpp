@@ -69,6 +69,22 @@ public: // information
     return m_ht.getNBuckets();
   }
 
+  /** \return how hashtable buckets are organized
+   */
+  HashtableLayout
+  getHashtableLayout() const
+  {
+    return m_ht.getLayout();
+  }
+
+  /** \return counters of the time spent resizing the hashtable
+   */
+  const HashtableResizeStats&
+  getHashtableResizeStats() const
+  {
+    return m_ht.getResizeStats();
+  }
+
   /** \return name tree entry on which a table entry is attached,
    *          or nullptr if the table entry is detached
    */
@@ -80,6 +96,17 @@ public: // information
   }
 
 public: // mutation
+  /** \brief reorganize hashtable buckets in \p layout
+   *
+   *  Entries are kept, so that references to them remain valid.
+   *  Existing iterators may skip or revisit entries afterwards.
+   */
+  void
+  setHashtableLayout(HashtableLayout layout)
+  {
+    m_ht.setLayout(layout);
+  }
+
   /** \brief Find or insert an entry by name
    *
    *  This method seeks a name tree entry of name \c name.getPrefix(prefixLen).
@@ -92,6 +119,13 @@ public: // mutation
   Entry&
   lookup(const Name& name, size_t prefixLen);
 
+  /** \brief Equivalent to `lookup(name, prefixLen)`, with precomputed hash values
+   *  \param hashes hash values of the prefixes of \p name up to at least \p prefixLen components,
+   *                such as those cached on a packet by \c getHashes
+   */
+  Entry&
+  lookup(const Name& name, size_t prefixLen, const HashSequence& hashes);
+
   /** \brief Equivalent to `lookup(name, name.size())`
    */
   Entry&
@@ -136,7 +170,9 @@ public: // mutation
    *  \post If the entry is empty, it's deleted. If \p canEraseAncestors is true,
    *        ancestors of the entry are also deleted if they become empty.
    *  \note This function must be called after detaching a table entry from a name tree entry,
-   *  \note Existing iterators, except those pointing to deleted entries, are unaffected.
+   *  \note Existing iterators, except those pointing to deleted entries, remain valid. However,
+   *        erasing may migrate hashtable buckets of an ongoing resize, after which a full
+   *        enumeration may skip entries or visit some entries twice.
    */
   size_t
   eraseIfEmpty(Entry* entry, bool canEraseAncestors = true);
@@ -148,6 +184,12 @@ public: // matching
   Entry*
   findExactMatch(const Name& name, size_t prefixLen = std::numeric_limits<size_t>::max()) const;
 
+  /** \brief Equivalent to `findExactMatch(name, prefixLen)`, with precomputed hash values
+   *  \param hashes hash values of the prefixes of \p name up to at least \p prefixLen components
+   */
+  Entry*
+  findExactMatch(const Name& name, size_t prefixLen, const HashSequence& hashes) const;
+
   /** \brief Longest prefix matching
    *  \return entry whose name is a prefix of \p name and passes \p entrySelector,
    *          where no other entry with a longer name satisfies those requirements;
@@ -157,6 +199,14 @@ public: // matching
   findLongestPrefixMatch(const Name& name,
                          const EntrySelector& entrySelector = AnyEntry()) const;
 
+  /** \brief Equivalent to `findLongestPrefixMatch(name, entrySelector)`, with precomputed hash values
+   *  \param hashes hash values of the prefixes of \p name up to at least
+   *                `min(name.size(), getMaxDepth())` components
+   */
+  Entry*
+  findLongestPrefixMatch(const Name& name, const HashSequence& hashes,
+                         const EntrySelector& entrySelector = AnyEntry()) const;
+
   /** \brief Equivalent to `findLongestPrefixMatch(entry.getName(), entrySelector)`
    *  \note This overload is more efficient than
    *        `findLongestPrefixMatch(const Name&, const EntrySelector&)` in common cases.
@@ -213,6 +263,14 @@ public: // matching
   findAllMatches(const Name& name,
                  const EntrySelector& entrySelector = AnyEntry()) const;
 
+  /** \brief Equivalent to `findAllMatches(name, entrySelector)`, with precomputed hash values
+   *  \param hashes hash values of the prefixes of \p name up to at least
+   *                `min(name.size(), getMaxDepth())` components
+   */
+  Range
+  findAllMatches(const Name& name, const HashSequence& hashes,
+                 const EntrySelector& entrySelector = AnyEntry()) const;
+
 public: // enumeration
   using const_iterator = Iterator;
 
@@ -39,22 +39,30 @@ Pit::Pit(NameTree& nameTree)
 {
 }
 
+size_t
+Pit::getNameTreeDepth(const Name& name)
+{
+  bool hasDigest = name.size() > 0 && name[-1].isImplicitSha256Digest();
+  return std::min(name.size() - static_cast<int>(hasDigest), NameTree::getMaxDepth());
+}
+
 std::pair<shared_ptr<Entry>, bool>
 Pit::findOrInsert(const Interest& interest, bool allowInsert)
 {
   // determine which NameTree entry should the PIT entry be attached onto
   const Name& name = interest.getName();
-  bool hasDigest = name.size() > 0 && name[-1].isImplicitSha256Digest();
-  size_t nteDepth = name.size() - static_cast<int>(hasDigest);
-  nteDepth = std::min(nteDepth, NameTree::getMaxDepth());
+  size_t nteDepth = getNameTreeDepth(name);
+
+  // hash values are cached on the Interest, for later lookups of the same packet
+  const name_tree::HashSequence& hashes = name_tree::getHashes(interest, nteDepth);
 
   // ensure NameTree entry exists
   name_tree::Entry* nte = nullptr;
   if (allowInsert) {
-    nte = &m_nameTree.lookup(name, nteDepth);
+    nte = &m_nameTree.lookup(name, nteDepth, hashes);
   }
   else {
-    nte = m_nameTree.findExactMatch(name, nteDepth);
+    nte = m_nameTree.findExactMatch(name, nteDepth, hashes);
     if (nte == nullptr) {
       return {nullptr, true};
     }
@@ -85,7 +93,9 @@ Pit::findOrInsert(const Interest& interest, bool allowInsert)
 DataMatchResult
 Pit::findAllDataMatches(const Data& data) const
 {
-  auto&& ntMatches = m_nameTree.findAllMatches(data.getName(), &nteHasPitEntries);
+  auto&& ntMatches = m_nameTree.findAllMatches(data.getName(),
+                                               name_tree::getHashes(data, NameTree::getMaxDepth()),
+                                               &nteHasPitEntries);
 
   DataMatchResult matches;
   for (const auto& nte : ntMatches) {
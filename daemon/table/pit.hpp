@@ -68,6 +68,13 @@ public:
     return const_cast<Pit*>(this)->findOrInsert(interest, false).first;
   }
 
+  /** \brief Returns the depth of the NameTree entry that a PIT entry for \p name is attached onto
+   *
+   *  An implicit digest component is not included, and the depth is at most NameTree::getMaxDepth().
+   */
+  static size_t
+  getNameTreeDepth(const Name& name);
+
   /** \brief Inserts a PIT entry for \p interest
    *  \param interest the Interest; must be created with make_shared
    *  \return a new or existing entry with same Name and Selectors,
@@ -0,0 +1,69 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "core/cs-byte-info.hpp"
+
+#include "tests/test-common.hpp"
+
+#include <ndn-cxx/mgmt/nfd/cs-info.hpp>
+
+namespace nfd {
+namespace tests {
+
+BOOST_AUTO_TEST_SUITE(TestCsByteInfo)
+
+BOOST_AUTO_TEST_CASE(RoundTrip)
+{
+  ndn::nfd::CsInfo info;
+  info.setCapacity(2681)
+      .setNEntries(310);
+  BOOST_CHECK(extractCsByteInfo(info.wireEncode()) == nullopt);
+
+  CsByteInfo byteInfo;
+  byteInfo.byteCapacity = 1048576;
+  byteInfo.nBytes = 393216;
+  Block wire = appendCsByteInfo(info.wireEncode(), byteInfo);
+
+  // the fields defined by the NFD Management Protocol are unaffected
+  ndn::nfd::CsInfo decoded(wire);
+  BOOST_CHECK_EQUAL(decoded.getCapacity(), 2681);
+  BOOST_CHECK_EQUAL(decoded.getNEntries(), 310);
+
+  auto extracted = extractCsByteInfo(decoded.wireEncode());
+  BOOST_REQUIRE(extracted);
+  BOOST_CHECK(extracted->byteCapacity == optional<uint64_t>(1048576));
+  BOOST_CHECK_EQUAL(extracted->nBytes, 393216);
+
+  byteInfo.byteCapacity = nullopt;
+  extracted = extractCsByteInfo(appendCsByteInfo(info.wireEncode(), byteInfo));
+  BOOST_REQUIRE(extracted);
+  BOOST_CHECK(extracted->byteCapacity == nullopt);
+  BOOST_CHECK_EQUAL(extracted->nBytes, 393216);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestCsByteInfo
+
+} // namespace tests
+} // namespace nfd
@@ -0,0 +1,78 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "core/cs-wtinylfu-info.hpp"
+#include "core/cs-byte-info.hpp"
+
+#include "tests/test-common.hpp"
+
+#include <ndn-cxx/mgmt/nfd/cs-info.hpp>
+
+namespace nfd {
+namespace tests {
+
+BOOST_AUTO_TEST_SUITE(TestCsWTinyLfuInfo)
+
+BOOST_AUTO_TEST_CASE(RoundTrip)
+{
+  ndn::nfd::CsInfo info;
+  info.setCapacity(2681)
+      .setNEntries(310);
+  CsByteInfo byteInfo;
+  byteInfo.nBytes = 393216;
+  Block wire = appendCsByteInfo(info.wireEncode(), byteInfo);
+  BOOST_CHECK(extractCsWTinyLfuInfo(wire) == nullopt);
+
+  CsWTinyLfuInfo policyInfo;
+  policyInfo.nWindowHits = 52;
+  policyInfo.nProbationHits = 377;
+  policyInfo.nProtectedHits = 1410;
+  policyInfo.nInserted = 2295;
+  policyInfo.nAdmitted = 118;
+  policyInfo.nRejected = 1867;
+  wire = appendCsWTinyLfuInfo(wire, policyInfo);
+
+  // the fields defined by the NFD Management Protocol and the byte usage are unaffected
+  ndn::nfd::CsInfo decoded(wire);
+  BOOST_CHECK_EQUAL(decoded.getCapacity(), 2681);
+  BOOST_CHECK_EQUAL(decoded.getNEntries(), 310);
+  auto extractedBytes = extractCsByteInfo(decoded.wireEncode());
+  BOOST_REQUIRE(extractedBytes);
+  BOOST_CHECK_EQUAL(extractedBytes->nBytes, 393216);
+
+  auto extracted = extractCsWTinyLfuInfo(decoded.wireEncode());
+  BOOST_REQUIRE(extracted);
+  BOOST_CHECK_EQUAL(extracted->nWindowHits, 52);
+  BOOST_CHECK_EQUAL(extracted->nProbationHits, 377);
+  BOOST_CHECK_EQUAL(extracted->nProtectedHits, 1410);
+  BOOST_CHECK_EQUAL(extracted->nInserted, 2295);
+  BOOST_CHECK_EQUAL(extracted->nAdmitted, 118);
+  BOOST_CHECK_EQUAL(extracted->nRejected, 1867);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestCsWTinyLfuInfo
+
+} // namespace tests
+} // namespace nfd
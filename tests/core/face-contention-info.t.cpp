@@ -0,0 +1,73 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "core/face-contention-info.hpp"
+
+#include "tests/test-common.hpp"
+
+#include <ndn-cxx/mgmt/nfd/face-status.hpp>
+
+namespace nfd {
+namespace tests {
+
+BOOST_AUTO_TEST_SUITE(TestFaceContentionInfo)
+
+BOOST_AUTO_TEST_CASE(RoundTrip)
+{
+  ndn::nfd::FaceStatus status;
+  status.setFaceId(256)
+        .setRemoteUri("udp4://224.0.23.170:56363")
+        .setLocalUri("udp4://192.0.2.1:56363")
+        .setLinkType(ndn::nfd::LINK_TYPE_AD_HOC)
+        .setNInInterests(2954);
+  BOOST_CHECK(extractFaceContentionInfo(status.wireEncode()) == nullopt);
+
+  FaceContentionInfo info;
+  info.nDuplicateInterests = 721;
+  info.nDeferredInterests = 1309;
+  info.nSuppressedInterests = 455;
+  info.nRebroadcastInterests = 854;
+  info.nRedundantRebroadcasts = 96;
+  Block wire = appendFaceContentionInfo(status.wireEncode(), info);
+
+  // the fields defined by the NFD Management Protocol are unaffected
+  ndn::nfd::FaceStatus decoded(wire);
+  BOOST_CHECK_EQUAL(decoded.getFaceId(), 256);
+  BOOST_CHECK_EQUAL(decoded.getLinkType(), ndn::nfd::LINK_TYPE_AD_HOC);
+  BOOST_CHECK_EQUAL(decoded.getNInInterests(), 2954);
+
+  auto extracted = extractFaceContentionInfo(decoded.wireEncode());
+  BOOST_REQUIRE(extracted);
+  BOOST_CHECK_EQUAL(extracted->nDuplicateInterests, 721);
+  BOOST_CHECK_EQUAL(extracted->nDeferredInterests, 1309);
+  BOOST_CHECK_EQUAL(extracted->nSuppressedInterests, 455);
+  BOOST_CHECK_EQUAL(extracted->nRebroadcastInterests, 854);
+  BOOST_CHECK_EQUAL(extracted->nRedundantRebroadcasts, 96);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestFaceContentionInfo
+
+} // namespace tests
+} // namespace nfd
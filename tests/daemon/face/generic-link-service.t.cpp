@@ -25,6 +25,7 @@
 
 #include "face/generic-link-service.hpp"
 #include "face/face.hpp"
+#include "face/lp-location.hpp"
 
 #include "tests/test-common.hpp"
 #include "tests/key-chain-fixture.hpp"
@@ -1433,6 +1434,68 @@ BOOST_AUTO_TEST_CASE(ReceivePrefixAnnouncementDropNack)
   BOOST_CHECK(receivedNacks.empty());
 }
 
+BOOST_AUTO_TEST_CASE(SendLocation)
+{
+  auto interest = makeInterest("/12345678");
+  auto tag = make_shared<LocationTag>();
+  tag->setPrevLocation(ndn::Location(40.5, -74.25));
+  interest->setTag(tag);
+
+  face->sendInterest(*interest);
+
+  BOOST_REQUIRE_EQUAL(transport->sentPackets.size(), 1);
+  lp::Packet sent(transport->sentPackets.back());
+  BOOST_REQUIRE(sent.has<LocationField>());
+  BOOST_CHECK(sent.get<LocationField>() == tag->getValue());
+}
+
+BOOST_AUTO_TEST_CASE(SendLpLocation)
+{
+  lp::LocationHeader header;
+  header.setMyLocation(ndn::Location(10, 20));
+  header.setPrevLocation(ndn::Location(30, 40));
+  header.setDestLocation(ndn::Location(50, 60));
+  auto interest = makeInterest("/12345678");
+  interest->setTag(make_shared<lp::LocationTag>(header));
+
+  face->sendInterest(*interest);
+
+  BOOST_REQUIRE_EQUAL(transport->sentPackets.size(), 1);
+  lp::Packet sent(transport->sentPackets.back());
+  BOOST_REQUIRE(sent.has<LocationField>());
+  LocationTag tag(sent.get<LocationField>());
+  BOOST_CHECK_EQUAL(tag.get().getMyLocation().getLatitude(), 10);
+  BOOST_CHECK_EQUAL(tag.get().getPrevLocation().getLongitude(), 40);
+  BOOST_CHECK_EQUAL(tag.get().getDestLocation().getLatitude(), 50);
+}
+
+BOOST_AUTO_TEST_CASE(ReceiveLocation)
+{
+  LocationTag sentTag;
+  sentTag.setMyLocation(ndn::Location(1.5, 2.5));
+  sentTag.setDestLocation(ndn::Location(-3, 4));
+
+  auto data = makeData("/12345678");
+  lp::Packet packet(data->wireEncode());
+  packet.add<LocationField>(sentTag.getValue());
+
+  transport->receivePacket(packet.wireEncode());
+
+  BOOST_REQUIRE_EQUAL(receivedData.size(), 1);
+  auto tag = receivedData.back().getTag<LocationTag>();
+  BOOST_REQUIRE(tag != nullptr);
+  BOOST_CHECK_EQUAL(tag->get().getMyLocation().getLatitude(), 1.5);
+  BOOST_CHECK_EQUAL(tag->get().getMyLocation().getLongitude(), 2.5);
+  BOOST_CHECK_EQUAL(tag->get().getPrevLocation().getLatitude(), 0);
+  BOOST_CHECK_EQUAL(tag->get().getDestLocation().getLatitude(), -3);
+  BOOST_CHECK_EQUAL(tag->get().getDestLocation().getLongitude(), 4);
+
+  auto lpTag = receivedData.back().getTag<lp::LocationTag>();
+  BOOST_REQUIRE(lpTag != nullptr);
+  BOOST_CHECK_EQUAL(lpTag->get().getMyLocation().getLatitude(), 1.5);
+  BOOST_CHECK_EQUAL(lpTag->get().getDestLocation().getLongitude(), 4);
+}
+
 BOOST_AUTO_TEST_SUITE_END() // LpFields
 
 BOOST_AUTO_TEST_SUITE(Malformed) // receive malformed packets
@@ -0,0 +1,122 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "face/lp-location.hpp"
+
+#include "tests/test-common.hpp"
+
+#include <ndn-cxx/lp/tlv.hpp>
+
+namespace nfd {
+namespace face {
+namespace tests {
+
+BOOST_AUTO_TEST_SUITE(Face)
+BOOST_AUTO_TEST_SUITE(TestLpLocation)
+
+BOOST_AUTO_TEST_CASE(Patch)
+{
+  LocationTag tag;
+  LocationTag::Value zero{};
+  BOOST_CHECK(tag.getValue() == zero);
+
+  tag.setMyLocation(ndn::Location(10, 20));
+  tag.setPrevLocation(ndn::Location(-30.125, 40));
+  tag.setDestLocation(ndn::Location(50, -60.5));
+  LocationTag::Value before = tag.getValue();
+
+  // only the 16 bytes of PrevLocation change
+  tag.setPrevLocation(ndn::Location(1, 2));
+  for (size_t i = 0; i < LocationTag::VALUE_SIZE; ++i) {
+    if (i < 16 || i >= 32) {
+      BOOST_CHECK_EQUAL(tag.getValue()[i], before[i]);
+    }
+  }
+  BOOST_CHECK_EQUAL(tag.get().getPrevLocation().getLatitude(), 1);
+  BOOST_CHECK_EQUAL(tag.get().getPrevLocation().getLongitude(), 2);
+
+  // the value decodes to the same locations
+  LocationTag decoded(tag.getValue());
+  BOOST_CHECK_EQUAL(decoded.get().getMyLocation().getLatitude(), 10);
+  BOOST_CHECK_EQUAL(decoded.get().getMyLocation().getLongitude(), 20);
+  BOOST_CHECK_EQUAL(decoded.get().getPrevLocation().getLatitude(), 1);
+  BOOST_CHECK_EQUAL(decoded.get().getPrevLocation().getLongitude(), 2);
+  BOOST_CHECK_EQUAL(decoded.get().getDestLocation().getLatitude(), 50);
+  BOOST_CHECK_EQUAL(decoded.get().getDestLocation().getLongitude(), -60.5);
+}
+
+BOOST_AUTO_TEST_CASE(EncodeDecode)
+{
+  LocationTag tag;
+  tag.setMyLocation(ndn::Location(1, -1));
+
+  ndn::EncodingBuffer encoder;
+  size_t length = LocationField::encode(encoder, tag.getValue());
+  BOOST_CHECK_EQUAL(length, 3 + 1 + LocationTag::VALUE_SIZE);
+
+  Block wire = encoder.block();
+  BOOST_CHECK_EQUAL(wire.type(), TLV_LOCATION_FIELD);
+  BOOST_CHECK(LocationField::decode(wire) == tag.getValue());
+
+  // big-endian IEEE 754 1.0
+  const uint8_t one[] = {0x3f, 0xf0, 0, 0, 0, 0, 0, 0};
+  BOOST_CHECK_EQUAL_COLLECTIONS(wire.value_begin(), wire.value_begin() + 8, one, one + 8);
+
+  const uint8_t shortValue[8] = {};
+  BOOST_CHECK_THROW(LocationField::decode(ndn::encoding::makeBinaryBlock(TLV_LOCATION_FIELD, shortValue)),
+                    tlv::Error);
+  BOOST_CHECK_THROW(LocationField::decode(ndn::encoding::makeBinaryBlock(lp::tlv::CongestionMark,
+                                                                         tag.getValue())),
+                    tlv::Error);
+}
+
+BOOST_AUTO_TEST_CASE(TranslateLpTag)
+{
+  Interest interest("/A");
+  BOOST_CHECK(getLocationTag(interest) == nullptr);
+
+  lp::LocationHeader header;
+  header.setMyLocation(ndn::Location(1, 2));
+  header.setPrevLocation(ndn::Location(3, 4));
+  header.setDestLocation(ndn::Location(5, 6));
+  interest.setTag(make_shared<lp::LocationTag>(header));
+
+  auto tag = getLocationTag(interest);
+  BOOST_REQUIRE(tag != nullptr);
+  BOOST_CHECK_EQUAL(LocationTag(tag->getValue()).get().getPrevLocation().getLongitude(), 4);
+  BOOST_CHECK_EQUAL(tag->get().getMyLocation().getLatitude(), 1);
+  BOOST_CHECK_EQUAL(tag->get().getDestLocation().getLongitude(), 6);
+
+  // the translated tag is attached, so updates of the locations go with the packet
+  BOOST_CHECK_EQUAL(interest.getTag<LocationTag>(), tag);
+  BOOST_CHECK_EQUAL(getLocationTag(interest), tag);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestLpLocation
+BOOST_AUTO_TEST_SUITE_END() // Face
+
+} // namespace tests
+} // namespace face
+} // namespace nfd
@@ -0,0 +1,196 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "fw/clf-contention.hpp"
+
+#include "tests/test-common.hpp"
+#include "tests/daemon/global-io-fixture.hpp"
+#include "tests/daemon/face/dummy-face.hpp"
+
+namespace nfd {
+namespace fw {
+namespace clf {
+namespace tests {
+
+using namespace nfd::tests;
+
+BOOST_AUTO_TEST_SUITE(Fw)
+BOOST_AUTO_TEST_SUITE(TestClfContention)
+
+BOOST_AUTO_TEST_CASE(ParseMode)
+{
+  BOOST_CHECK(parseContentionMode("fixed") == ContentionMode::FIXED);
+  BOOST_CHECK(parseContentionMode("adaptive") == ContentionMode::ADAPTIVE);
+  BOOST_CHECK_THROW(parseContentionMode("random"), std::invalid_argument);
+  BOOST_CHECK_EQUAL(boost::lexical_cast<std::string>(ContentionMode::ADAPTIVE), "adaptive");
+}
+
+BOOST_AUTO_TEST_CASE(Fixed)
+{
+  const auto t = time::steady_clock::now();
+  NeighborTable neighbors;
+  for (EndpointId ep = 1; ep <= 20; ++ep) {
+    neighbors.update(300, ep, ndn::Location(ep, ep), t);
+  }
+  ContentionController contention(neighbors, ContentionMode::FIXED);
+
+  contention.recordInterest(300, true);
+  BOOST_CHECK_EQUAL(contention.getScale(300, t), 1.0);
+  BOOST_CHECK_EQUAL(contention.computeDelay(300, 10_ms, t), 10_ms);
+}
+
+BOOST_AUTO_TEST_CASE(AdaptiveDensity)
+{
+  const auto t = time::steady_clock::now();
+  NeighborTable neighbors;
+  ContentionController contention(neighbors, ContentionMode::ADAPTIVE);
+
+  // no neighbor known is the same as one neighbor
+  BOOST_CHECK_CLOSE(contention.getScale(300, t), 0.25, 0.0001);
+  BOOST_CHECK_EQUAL(contention.computeDelay(300, 10_ms, t), 2500_us);
+
+  neighbors.update(300, 1, ndn::Location(1, 1), t);
+  BOOST_CHECK_CLOSE(contention.getScale(300, t), 0.25, 0.0001);
+  BOOST_CHECK_EQUAL(contention.computeDelay(300, 10_ms, t), 2500_us);
+
+  // the scale grows with the density
+  double prevScale = contention.getScale(300, t);
+  for (EndpointId ep = 2; ep <= 8; ++ep) {
+    neighbors.update(300, ep, ndn::Location(ep, ep), t);
+    double scale = contention.getScale(300, t);
+    BOOST_CHECK_GT(scale, prevScale);
+    prevScale = scale;
+  }
+  for (EndpointId ep = 2; ep <= 8; ++ep) {
+    neighbors.update(300, ep, ndn::Location(ep, ep), t);
+  }
+  BOOST_CHECK_CLOSE(contention.getScale(300, t), 2.0, 0.0001);
+  BOOST_CHECK_EQUAL(contention.computeDelay(300, 10_ms, t), 20_ms);
+
+  // neighbors of another face are not counted
+  BOOST_CHECK_CLOSE(contention.getScale(301, t), 0.25, 0.0001);
+
+  // clamped to MAX_SCALE
+  for (EndpointId ep = 9; ep <= 100; ++ep) {
+    neighbors.update(300, ep, ndn::Location(ep, ep), t);
+  }
+  BOOST_CHECK_EQUAL(contention.getScale(300, t), ContentionController::MAX_SCALE);
+
+  // neighbors expire
+  BOOST_CHECK_CLOSE(contention.getScale(300, t + 10_s), 0.25, 0.0001);
+}
+
+BOOST_AUTO_TEST_CASE(AdaptiveDuplicates)
+{
+  const auto t = time::steady_clock::now();
+  NeighborTable neighbors;
+  for (EndpointId ep = 1; ep <= 4; ++ep) {
+    neighbors.update(300, ep, ndn::Location(ep, ep), t);
+  }
+  ContentionController contention(neighbors, ContentionMode::ADAPTIVE);
+
+  contention.recordInterest(300, false);
+  BOOST_CHECK_CLOSE(contention.getScale(300, t), 1.0, 0.0001);
+
+  contention.recordInterest(300, true);
+  BOOST_CHECK_CLOSE(contention.getScale(300, t), 1.1, 0.0001);
+  contention.recordInterest(300, true);
+  BOOST_CHECK_CLOSE(contention.getScale(300, t), 1.19, 0.0001);
+
+  for (int i = 0; i < 200; ++i) {
+    contention.recordInterest(300, true);
+  }
+  BOOST_CHECK_CLOSE(contention.getScale(300, t), 2.0, 0.01);
+
+  const auto* counters = contention.getCounters(300);
+  BOOST_REQUIRE(counters != nullptr);
+  BOOST_CHECK_EQUAL(counters->nInterests, 203);
+  BOOST_CHECK_EQUAL(counters->nDuplicates, 202);
+}
+
+BOOST_AUTO_TEST_CASE(Counters)
+{
+  NeighborTable neighbors;
+  ContentionController contention(neighbors, ContentionMode::ADAPTIVE);
+  BOOST_CHECK(contention.getCounters(300) == nullptr);
+
+  contention.computeDelay(300, 10_ms);
+  contention.computeDelay(300, 10_ms);
+  contention.computeDelay(300, 10_ms);
+  contention.recordSuppressed(300);
+  contention.recordRebroadcast(300, 10_ms);
+  contention.recordRebroadcast(300, 5_ms);
+  contention.recordRedundantRebroadcast(300);
+
+  const auto* counters = contention.getCounters(300);
+  BOOST_REQUIRE(counters != nullptr);
+  BOOST_CHECK_EQUAL(counters->nDeferred, 3);
+  BOOST_CHECK_EQUAL(counters->nSuppressed, 1);
+  BOOST_CHECK_EQUAL(counters->nRebroadcasts, 2);
+  BOOST_CHECK_EQUAL(counters->nRedundantRebroadcasts, 1);
+  BOOST_CHECK_EQUAL(counters->addedLatency, 15_ms);
+  BOOST_CHECK(contention.getCounters(301) == nullptr);
+
+  contention.eraseFace(300);
+  BOOST_CHECK(contention.getCounters(300) == nullptr);
+}
+
+BOOST_FIXTURE_TEST_CASE(FaceCounters, GlobalIoFixture)
+{
+  FaceTable faceTable;
+  auto face = make_shared<DummyFace>();
+  faceTable.add(face);
+  FaceId faceId = face->getId();
+
+  NeighborTable neighbors;
+  ContentionController contention(neighbors, ContentionMode::ADAPTIVE, &faceTable);
+
+  contention.recordInterest(faceId, false);
+  contention.recordInterest(faceId, true);
+  contention.computeDelay(faceId, 10_ms);
+  contention.computeDelay(faceId, 10_ms);
+  contention.recordSuppressed(faceId);
+  contention.recordRebroadcast(faceId, 10_ms);
+  contention.recordRedundantRebroadcast(faceId);
+
+  const auto& counters = face->getCounters();
+  BOOST_CHECK_EQUAL(counters.nDuplicateInterests, 1);
+  BOOST_CHECK_EQUAL(counters.nDeferredInterests, 2);
+  BOOST_CHECK_EQUAL(counters.nSuppressedInterests, 1);
+  BOOST_CHECK_EQUAL(counters.nRebroadcastInterests, 1);
+  BOOST_CHECK_EQUAL(counters.nRedundantRebroadcasts, 1);
+
+  // a face that is not in the table is only counted by the controller
+  contention.recordSuppressed(faceId + 1);
+  BOOST_CHECK_EQUAL(contention.getCounters(faceId + 1)->nSuppressed, 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestClfContention
+BOOST_AUTO_TEST_SUITE_END() // Fw
+
+} // namespace tests
+} // namespace clf
+} // namespace fw
+} // namespace nfd
@@ -0,0 +1,309 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "fw/clf-deferred-interest-pool.hpp"
+
+#include "tests/test-common.hpp"
+#include "tests/daemon/global-io-fixture.hpp"
+#include "tests/daemon/face/dummy-face.hpp"
+
+namespace nfd {
+namespace fw {
+namespace clf {
+namespace tests {
+
+using namespace nfd::tests;
+
+class DeferredInterestPoolFixture : public GlobalIoTimeFixture
+{
+protected:
+  SchedulerTimerBackend timers;
+  DeferredInterestPool pool{timers, 1_ms, 8};
+};
+
+BOOST_AUTO_TEST_SUITE(Fw)
+BOOST_FIXTURE_TEST_SUITE(TestClfDeferredInterestPool, DeferredInterestPoolFixture)
+
+BOOST_AUTO_TEST_CASE(ScheduleFire)
+{
+  Name nameA("/A"), nameB("/B");
+  int nFiredA = 0, nFiredB = 0;
+  pool.schedule(nameA, name_tree::computeHash(nameA), 3_ms, [&] { ++nFiredA; });
+  pool.schedule(nameB, name_tree::computeHash(nameB), 20_ms, [&] { ++nFiredB; }); // beyond one rotation
+  BOOST_CHECK_EQUAL(pool.size(), 2);
+  BOOST_CHECK(pool.contains(nameA, name_tree::computeHash(nameA)));
+
+  this->advanceClocks(1_ms, 3_ms);
+  BOOST_CHECK_EQUAL(nFiredA, 1);
+  BOOST_CHECK_EQUAL(pool.size(), 1);
+  BOOST_CHECK(!pool.contains(nameA, name_tree::computeHash(nameA)));
+
+  this->advanceClocks(1_ms, 10_ms);
+  BOOST_CHECK_EQUAL(nFiredB, 0); // its slot is passed at tick 12, but it is not due in that round
+
+  this->advanceClocks(1_ms, 10_ms);
+  BOOST_CHECK_EQUAL(nFiredB, 1);
+  BOOST_CHECK(pool.empty());
+  BOOST_CHECK_EQUAL(pool.getCounters().nScheduled, 2);
+  BOOST_CHECK_EQUAL(pool.getCounters().nFired, 2);
+  BOOST_CHECK_EQUAL(pool.getCounters().nCancelled, 0);
+  BOOST_CHECK_EQUAL(timers.getCounters().nScheduled, 2); // the timer is armed only for ticks 3 and 20
+}
+
+BOOST_AUTO_TEST_CASE(LateCallback)
+{
+  std::string fired;
+  auto schedule = [&] (const std::string& name, time::nanoseconds delay) {
+    pool.schedule(name, name_tree::computeHash(name), delay, [&fired, name] { fired += name[1]; });
+  };
+  schedule("/A", 4_ms);
+  schedule("/B", 2_ms);
+  schedule("/C", 9_ms);
+
+  // the timer callback runs 3 ms late, and fires every transmission that became due meanwhile
+  this->advanceClocks(5_ms, 5_ms);
+  BOOST_CHECK_EQUAL(fired, "BA");
+  BOOST_CHECK_EQUAL(timers.getCounters().nFired, 1);
+  BOOST_CHECK_EQUAL(pool.getCounters().nBatches, 2);
+
+  // the wheel stays anchored to its start time, so the lateness does not carry over
+  schedule("/D", 1_ms);
+  this->advanceClocks(1_ms, 1_ms);
+  BOOST_CHECK_EQUAL(fired, "BAD");
+  this->advanceClocks(1_ms, 2_ms);
+  BOOST_CHECK_EQUAL(fired, "BAD");
+  this->advanceClocks(1_ms, 1_ms);
+  BOOST_CHECK_EQUAL(fired, "BADC");
+  BOOST_CHECK(pool.empty());
+}
+
+BOOST_AUTO_TEST_CASE(Cancel)
+{
+  Name name("/A");
+  auto hash = name_tree::computeHash(name);
+  int nFired = 0;
+  pool.schedule(name, hash, 3_ms, [&] { ++nFired; });
+  BOOST_CHECK(pool.cancel(name, hash));
+  BOOST_CHECK(!pool.cancel(name, hash));
+  BOOST_CHECK(!pool.erase(name, hash));
+
+  this->advanceClocks(1_ms, 5_ms);
+  BOOST_CHECK_EQUAL(nFired, 0);
+  BOOST_CHECK_EQUAL(pool.getCounters().nCancelled, 1);
+  BOOST_CHECK_EQUAL(timers.getCounters().nScheduled, 1); // wheel stops ticking when empty
+}
+
+BOOST_AUTO_TEST_CASE(Replace)
+{
+  Name name("/A");
+  auto hash = name_tree::computeHash(name);
+  int nFired1 = 0, nFired2 = 0;
+  pool.schedule(name, hash, 2_ms, [&] { ++nFired1; });
+  pool.schedule(name, hash, 4_ms, [&] { ++nFired2; });
+  BOOST_CHECK_EQUAL(pool.size(), 1);
+
+  this->advanceClocks(1_ms, 5_ms);
+  BOOST_CHECK_EQUAL(nFired1, 0);
+  BOOST_CHECK_EQUAL(nFired2, 1);
+}
+
+BOOST_AUTO_TEST_CASE(HashCollision)
+{
+  Name nameA("/A"), nameB("/B");
+  int nFiredA = 0, nFiredB = 0;
+  pool.schedule(nameA, 42, 2_ms, [&] { ++nFiredA; });
+  pool.schedule(nameB, 42, 2_ms, [&] { ++nFiredB; });
+  BOOST_CHECK_EQUAL(pool.size(), 2);
+
+  BOOST_CHECK(pool.cancel(nameB, 42));
+  BOOST_CHECK(pool.contains(nameA, 42));
+  this->advanceClocks(1_ms, 3_ms);
+  BOOST_CHECK_EQUAL(nFiredA, 1);
+  BOOST_CHECK_EQUAL(nFiredB, 0);
+}
+
+BOOST_AUTO_TEST_CASE(WideWheel)
+{
+  // the slots span several words of the occupancy bitmap, and the next due slot wraps around
+  DeferredInterestPool wide(timers, 1_ms, 128);
+  std::string fired;
+  auto schedule = [&] (const std::string& name, time::nanoseconds delay) {
+    wide.schedule(name, name_tree::computeHash(name), delay, [&fired, name] { fired += name[1]; });
+  };
+  schedule("/A", 100_ms);
+  schedule("/B", 70_ms);
+  schedule("/C", 300_ms); // beyond one rotation, in slot 44
+
+  this->advanceClocks(1_ms, 100_ms);
+  BOOST_CHECK_EQUAL(fired, "BA");
+  this->advanceClocks(1_ms, 199_ms);
+  BOOST_CHECK_EQUAL(fired, "BA");
+  this->advanceClocks(1_ms, 1_ms);
+  BOOST_CHECK_EQUAL(fired, "BAC");
+  BOOST_CHECK(wide.empty());
+  // armed for tick 100, then 70, then each due tick
+  BOOST_CHECK_EQUAL(timers.getCounters().nScheduled, 4);
+}
+
+BOOST_AUTO_TEST_CASE(CancelInSameTick)
+{
+  Name nameA("/A"), nameB("/B");
+  auto hashB = name_tree::computeHash(nameB);
+  int nFiredB = 0;
+  // whichever fires first cancels the other
+  pool.schedule(nameA, name_tree::computeHash(nameA), 2_ms, [&] { pool.cancel(nameB, hashB); });
+  pool.schedule(nameB, hashB, 2_ms, [&] { ++nFiredB; });
+
+  this->advanceClocks(1_ms, 3_ms);
+  BOOST_CHECK(pool.empty());
+  BOOST_CHECK_EQUAL(pool.getCounters().nFired + pool.getCounters().nCancelled, 2);
+}
+
+BOOST_AUTO_TEST_CASE(ManyEntries)
+{
+  int nFired = 0;
+  for (int i = 0; i < 1000; ++i) {
+    Name name("/A");
+    name.appendNumber(i);
+    pool.schedule(name, name_tree::computeHash(name), time::milliseconds(i % 50), [&] { ++nFired; });
+  }
+  BOOST_CHECK_EQUAL(pool.size(), 1000);
+
+  for (int i = 0; i < 1000; i += 2) {
+    Name name("/A");
+    name.appendNumber(i);
+    BOOST_CHECK(pool.cancel(name, name_tree::computeHash(name)));
+  }
+
+  this->advanceClocks(1_ms, 60_ms);
+  BOOST_CHECK_EQUAL(nFired, 500);
+  BOOST_CHECK(pool.empty());
+}
+
+BOOST_AUTO_TEST_CASE(Coalesce)
+{
+  pool.setCoalescingWindow(4_ms);
+  BOOST_CHECK_EQUAL(pool.getCoalescingWindow(), 4_ms);
+
+  std::string fired;
+  auto schedule = [&] (const std::string& name, time::nanoseconds delay, DeferredInterestPool::BatchKey key) {
+    pool.schedule(name, name_tree::computeHash(name), delay, [&fired, name] { fired += name[1]; }, key);
+  };
+  schedule("/A", 1_ms, 1);
+  schedule("/B", 2_ms, 2);
+  schedule("/C", 3_ms, 1);
+  schedule("/D", 5_ms, 1);
+
+  this->advanceClocks(1_ms, 3_ms);
+  BOOST_CHECK_EQUAL(fired, "");
+
+  // A, B and C are due in the first window, and fire grouped by key
+  this->advanceClocks(1_ms, 1_ms);
+  BOOST_REQUIRE_EQUAL(fired.size(), 3);
+  BOOST_CHECK_EQUAL(fired[2], 'B');
+  BOOST_CHECK_EQUAL(pool.getCounters().nBatches, 2);
+
+  this->advanceClocks(1_ms, 3_ms);
+  BOOST_CHECK_EQUAL(fired.size(), 3);
+  this->advanceClocks(1_ms, 1_ms);
+  BOOST_CHECK_EQUAL(fired.size(), 4);
+  BOOST_CHECK_EQUAL(pool.getCounters().nFired, 4);
+  BOOST_CHECK_EQUAL(pool.getCounters().nBatches, 3);
+
+  pool.setCoalescingWindow(0_ns);
+  BOOST_CHECK_EQUAL(pool.getCoalescingWindow(), 0_ns);
+}
+
+BOOST_AUTO_TEST_CASE(Actions)
+{
+  std::vector<FaceId> fired;
+  pool.setActionCallback([&] (const DeferredAction& action, time::nanoseconds delay) {
+    BOOST_CHECK_EQUAL(delay, 2_ms);
+    fired.push_back(action.getEgressId());
+  });
+
+  auto face1 = make_shared<DummyFace>();
+  auto face2 = make_shared<DummyFace>();
+  face1->setId(301);
+  face2->setId(302);
+  std::vector<shared_ptr<pit::Entry>> pitEntries;
+  for (const char* uri : {"/A", "/B", "/C"}) {
+    auto interest = makeInterest(uri);
+    pitEntries.push_back(make_shared<pit::Entry>(*interest));
+    Face& face = uri[1] == 'B' ? *face2 : *face1;
+    pool.schedule(interest->getName(), name_tree::computeHash(interest->getName()), 2_ms,
+                  DeferredAction(*interest, pitEntries.back(), face), face.getId());
+  }
+
+  // the actions do not keep the PIT entries alive
+  BOOST_CHECK_EQUAL(pitEntries.front().use_count(), 1);
+
+  // removing a face cancels its actions
+  BOOST_CHECK_EQUAL(pool.cancelBatch(301), 2);
+  BOOST_CHECK_EQUAL(pool.size(), 1);
+  BOOST_CHECK_EQUAL(pool.getCounters().nCancelled, 2);
+
+  this->advanceClocks(1_ms, 3_ms);
+  BOOST_REQUIRE_EQUAL(fired.size(), 1);
+  BOOST_CHECK_EQUAL(fired[0], 302);
+  BOOST_CHECK(pool.empty());
+}
+
+BOOST_AUTO_TEST_CASE(ActionNamedByPitEntry)
+{
+  int nFired = 0;
+  pool.setActionCallback([&] (const DeferredAction&, time::nanoseconds) { ++nFired; });
+
+  auto face = make_shared<DummyFace>();
+  auto interestA = makeInterest("/A");
+  auto interestB = makeInterest("/B");
+  auto pitEntryA = make_shared<pit::Entry>(*interestA);
+  auto pitEntryB = make_shared<pit::Entry>(*interestB);
+  // colliding hashes are told apart by the names of the PIT entries
+  pool.schedule("/A", 42, 2_ms, DeferredAction(*interestA, pitEntryA, *face));
+  pool.schedule("/B", 42, 2_ms, DeferredAction(*interestB, pitEntryB, *face));
+  BOOST_CHECK_EQUAL(pool.size(), 2);
+  BOOST_CHECK(pool.contains("/A", 42));
+  BOOST_CHECK(!pool.contains("/C", 42));
+
+  BOOST_CHECK(pool.cancel("/A", 42));
+  BOOST_CHECK(!pool.contains("/A", 42));
+
+  // an action whose PIT entry is erased cannot be found, and is discarded when due
+  pitEntryB.reset();
+  BOOST_CHECK(!pool.contains("/B", 42));
+  BOOST_CHECK(!pool.cancel("/B", 42));
+  this->advanceClocks(1_ms, 3_ms);
+  BOOST_CHECK_EQUAL(nFired, 1);
+  BOOST_CHECK(pool.empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestClfDeferredInterestPool
+BOOST_AUTO_TEST_SUITE_END() // Fw
+
+} // namespace tests
+} // namespace clf
+} // namespace fw
+} // namespace nfd
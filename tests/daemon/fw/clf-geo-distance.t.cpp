@@ -0,0 +1,117 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "fw/clf-geo-distance.hpp"
+
+#include "tests/test-common.hpp"
+
+#include <random>
+
+namespace nfd {
+namespace fw {
+namespace clf {
+namespace tests {
+
+using namespace nfd::tests;
+
+BOOST_AUTO_TEST_SUITE(Fw)
+BOOST_AUTO_TEST_SUITE(TestClfGeoDistance)
+
+BOOST_AUTO_TEST_CASE(ParseMode)
+{
+  BOOST_CHECK(parseDistanceMode("planar") == DistanceMode::PLANAR);
+  BOOST_CHECK(parseDistanceMode("equirectangular") == DistanceMode::EQUIRECTANGULAR);
+  BOOST_CHECK(parseDistanceMode("haversine") == DistanceMode::HAVERSINE);
+  BOOST_CHECK_THROW(parseDistanceMode("manhattan"), std::invalid_argument);
+  BOOST_CHECK_EQUAL(boost::lexical_cast<std::string>(DistanceMode::HAVERSINE), "haversine");
+}
+
+BOOST_AUTO_TEST_CASE(Pairwise)
+{
+  ndn::Location a(0, 0);
+  BOOST_CHECK_EQUAL(computeDistance(DistanceMode::PLANAR, a, ndn::Location(3, 4)), 5.0);
+
+  // one degree of latitude
+  BOOST_CHECK_CLOSE(computeDistance(DistanceMode::HAVERSINE, a, ndn::Location(1, 0)), 111.195, 0.001);
+  BOOST_CHECK_CLOSE(computeDistance(DistanceMode::EQUIRECTANGULAR, a, ndn::Location(1, 0)), 111.195, 0.001);
+
+  // a few kilometers away at mid latitude, equirectangular stays within 0.1% of haversine
+  ndn::Location b(45.0, 7.0);
+  ndn::Location c(45.02, 7.03);
+  BOOST_CHECK_CLOSE(computeDistance(DistanceMode::EQUIRECTANGULAR, b, c),
+                    computeDistance(DistanceMode::HAVERSINE, b, c), 0.1);
+}
+
+BOOST_AUTO_TEST_CASE(LocationScore)
+{
+  ndn::Location dest(0, 10);
+  // me is halfway between prev and dest
+  BOOST_CHECK_CLOSE(computeLocationScore(DistanceMode::PLANAR, ndn::Location(0, 0), ndn::Location(0, 5), dest),
+                    0.5, 0.0001);
+  // me is farther than prev
+  BOOST_CHECK_EQUAL(computeLocationScore(DistanceMode::PLANAR, ndn::Location(0, 5), ndn::Location(0, 0), dest),
+                    0.0);
+  // everyone is at dest
+  BOOST_CHECK_EQUAL(computeLocationScore(DistanceMode::PLANAR, dest, dest, dest), 0.0);
+}
+
+BOOST_AUTO_TEST_CASE(BatchMatchesPairwise)
+{
+  std::mt19937 rng(0);
+  std::uniform_real_distribution<double> offset(-0.1, 0.1);
+  ndn::Location me(40.7, -74.0);
+  ndn::Location prev(40.71, -74.01);
+
+  // sizes around the SIMD width and the chunk size
+  for (size_t n : {0, 1, 3, 4, 5, 63, 64, 65, 200}) {
+    LocationBatch dests;
+    for (size_t i = 0; i < n; ++i) {
+      dests.push_back(ndn::Location(me.getLatitude() + offset(rng), me.getLongitude() + offset(rng)));
+    }
+    BOOST_REQUIRE_EQUAL(dests.size(), n);
+
+    for (auto mode : {DistanceMode::PLANAR, DistanceMode::EQUIRECTANGULAR, DistanceMode::HAVERSINE}) {
+      std::vector<double> distances(n);
+      std::vector<double> scores(n);
+      computeDistances(mode, me, dests, distances.data());
+      computeLocationScores(mode, prev, me, dests, scores.data());
+
+      for (size_t i = 0; i < n; ++i) {
+        BOOST_TEST_CONTEXT("n=" << n << " mode=" << mode << " i=" << i) {
+          BOOST_CHECK_CLOSE(distances[i], computeDistance(mode, me, dests[i]), 1e-6);
+          BOOST_CHECK_SMALL(scores[i] - computeLocationScore(mode, prev, me, dests[i]), 1e-9);
+        }
+      }
+    }
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestClfGeoDistance
+BOOST_AUTO_TEST_SUITE_END() // Fw
+
+} // namespace tests
+} // namespace clf
+} // namespace fw
+} // namespace nfd
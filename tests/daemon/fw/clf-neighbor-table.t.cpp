@@ -0,0 +1,108 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "fw/clf-neighbor-table.hpp"
+
+#include "tests/test-common.hpp"
+
+namespace nfd {
+namespace fw {
+namespace clf {
+namespace tests {
+
+using namespace nfd::tests;
+
+BOOST_AUTO_TEST_SUITE(Fw)
+BOOST_AUTO_TEST_SUITE(TestClfNeighborTable)
+
+BOOST_AUTO_TEST_CASE(UpdateAndVelocity)
+{
+  const auto t = time::steady_clock::now();
+  NeighborTable table(5_s);
+
+  const auto& entry = table.update(300, 1, ndn::Location(10, 20), t);
+  BOOST_CHECK_EQUAL(entry.faceId, 300);
+  BOOST_CHECK_EQUAL(entry.endpointId, 1);
+  BOOST_CHECK_EQUAL(entry.latitudeSpeed, 0);
+  BOOST_CHECK_EQUAL(table.size(), 1);
+
+  // moved by (2, -4) in 2 seconds; the first sample is averaged with the initial zero velocity
+  table.update(300, 1, ndn::Location(12, 16), t + 2_s);
+  const auto* found = table.find(300, 1, t + 2_s);
+  BOOST_REQUIRE(found != nullptr);
+  BOOST_CHECK_EQUAL(found->position.getLatitude(), 12);
+  BOOST_CHECK_CLOSE(found->latitudeSpeed, 0.5, 0.0001);
+  BOOST_CHECK_CLOSE(found->longitudeSpeed, -1.0, 0.0001);
+
+  auto predicted = found->predictPosition(t + 4_s);
+  BOOST_CHECK_CLOSE(predicted.getLatitude(), 13, 0.0001);
+  BOOST_CHECK_CLOSE(predicted.getLongitude(), 14, 0.0001);
+
+  BOOST_CHECK(table.find(300, 2, t + 2_s) == nullptr);
+  BOOST_CHECK(table.find(301, 1, t + 2_s) == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(Aging)
+{
+  const auto t = time::steady_clock::now();
+  NeighborTable table(5_s);
+  table.update(300, 1, ndn::Location(1, 1), t);
+  table.update(300, 2, ndn::Location(2, 2), t + 3_s);
+  table.update(301, 1, ndn::Location(3, 3), t + 3_s);
+
+  BOOST_CHECK_EQUAL(table.countNeighbors(300, t + 4_s), 2);
+  BOOST_CHECK_EQUAL(table.countNeighbors(300, t + 6_s), 1);
+  BOOST_CHECK(table.find(300, 1, t + 6_s) == nullptr);
+  BOOST_CHECK_EQUAL(table.size(), 3);
+
+  BOOST_CHECK_EQUAL(table.removeExpired(t + 6_s), 1);
+  BOOST_CHECK_EQUAL(table.size(), 2);
+
+  // expired entries are also cleaned up by update
+  table.update(302, 1, ndn::Location(4, 4), t + 20_s);
+  BOOST_CHECK_EQUAL(table.size(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(EraseFace)
+{
+  const auto t = time::steady_clock::now();
+  NeighborTable table;
+  table.update(300, 1, ndn::Location(1, 1), t);
+  table.update(300, 2, ndn::Location(2, 2), t);
+  table.update(301, 1, ndn::Location(3, 3), t);
+
+  table.eraseFace(300);
+  BOOST_CHECK_EQUAL(table.size(), 1);
+  BOOST_CHECK_EQUAL(table.countNeighbors(300, t), 0);
+  BOOST_CHECK_EQUAL(table.countNeighbors(301, t), 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestClfNeighborTable
+BOOST_AUTO_TEST_SUITE_END() // Fw
+
+} // namespace tests
+} // namespace clf
+} // namespace fw
+} // namespace nfd
@@ -0,0 +1,193 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "fw/clf-prefix-location-tree.hpp"
+
+#include "tests/test-common.hpp"
+
+namespace nfd {
+namespace fw {
+namespace clf {
+namespace tests {
+
+using namespace nfd::tests;
+
+BOOST_AUTO_TEST_SUITE(Fw)
+BOOST_AUTO_TEST_SUITE(TestClfPrefixLocationTree)
+
+BOOST_AUTO_TEST_CASE(LongestPrefix)
+{
+  PrefixLocationTree tree;
+  BOOST_CHECK(tree.findLongestPrefix("/A/B/C") == nullptr);
+
+  tree.insert("/A", ndn::Location(10, 10));
+  tree.insert("/A/B", ndn::Location(20, 20));
+  BOOST_CHECK_EQUAL(tree.size(), 2);
+
+  BOOST_REQUIRE(tree.findLongestPrefix("/A/B/C") != nullptr);
+  BOOST_CHECK_EQUAL(tree.findLongestPrefix("/A/B/C")->getName(), "/A/B");
+  BOOST_CHECK_EQUAL(tree.findLongestPrefix("/A/D")->getName(), "/A");
+  BOOST_CHECK(tree.findLongestPrefix("/E") == nullptr);
+
+  tree.erase("/A/B");
+  BOOST_CHECK_EQUAL(tree.size(), 1);
+  BOOST_CHECK_EQUAL(tree.findLongestPrefix("/A/B/C")->getName(), "/A");
+}
+
+BOOST_AUTO_TEST_CASE(ParentChild)
+{
+  PrefixLocationTree tree;
+  auto a = tree.insert("/A", ndn::Location(0, 0));
+  auto abc = tree.insert("/A/B/C", ndn::Location(0, 0));
+  BOOST_CHECK(abc->getParent() == a);
+
+  // /A/B is inserted between /A and /A/B/C
+  auto ab = tree.insert("/A/B", ndn::Location(0, 0));
+  BOOST_CHECK(ab->getParent() == a);
+  BOOST_CHECK(abc->getParent() == ab);
+  BOOST_CHECK_EQUAL(a->getChildren().size(), 1);
+  BOOST_CHECK_EQUAL(tree.findDescendants("/A").size(), 2);
+
+  // erasing /A/B attaches /A/B/C to /A again
+  tree.erase("/A/B");
+  BOOST_CHECK(abc->getParent() == a);
+  BOOST_CHECK(!ab->hasParent());
+  BOOST_CHECK(!ab->hasChildren());
+}
+
+BOOST_AUTO_TEST_CASE(Nearest)
+{
+  PrefixLocationTree tree(10.0);
+  tree.insert("/A/1", ndn::Location(5, 5));
+  tree.insert("/A/2", ndn::Location(95, 95));
+  tree.insert("/B", ndn::Location(50, 50));
+  tree.insert("/A", ndn::Location(1000, 1000));
+
+  BOOST_CHECK_EQUAL(tree.findNearest("/A/1/seg", ndn::Location(90, 90))->getName(), "/A/1");
+  BOOST_CHECK_EQUAL(tree.findNearest("/A/3/seg", ndn::Location(90, 90))->getName(), "/A");
+  BOOST_CHECK_EQUAL(tree.findNearest("/A/1/seg", ndn::Location(0, 0))->getName(), "/A/1");
+  BOOST_CHECK_EQUAL(tree.findNearest("/A/2/seg", ndn::Location(90, 90))->getName(), "/A/2");
+  BOOST_CHECK_EQUAL(tree.findNearest("/B/seg", ndn::Location(-500, -500))->getName(), "/B");
+  BOOST_CHECK(tree.findNearest("/C", ndn::Location(0, 0)) == nullptr);
+  BOOST_CHECK(tree.findNearest("/A/1/seg", ndn::Location(90, 90), 50.0) == nullptr);
+
+  // moving an entry updates the spatial index
+  tree.insert("/A/1", ndn::Location(91, 91));
+  BOOST_CHECK_EQUAL(tree.findNearest("/A/1/seg", ndn::Location(90, 90), 50.0)->getName(), "/A/1");
+  BOOST_CHECK_EQUAL(tree.size(), 4);
+}
+
+BOOST_AUTO_TEST_CASE(NearestAfterErase)
+{
+  PrefixLocationTree tree(10.0);
+  tree.insert("/B", ndn::Location(30, 40));
+  tree.insert("/B/1", ndn::Location(3, 4));
+
+  BOOST_CHECK_EQUAL(tree.findNearest("/B/1/seg", ndn::Location(0, 0), 5.0)->getName(), "/B/1");
+  BOOST_CHECK(tree.findNearest("/B/1/seg", ndn::Location(0, 0), 4.9) == nullptr);
+
+  // erasing an entry removes it from the spatial index
+  tree.erase("/B/1");
+  BOOST_CHECK(tree.findNearest("/B/1/seg", ndn::Location(0, 0), 5.0) == nullptr);
+  BOOST_CHECK_EQUAL(tree.findNearest("/B/1/seg", ndn::Location(0, 0))->getName(), "/B");
+}
+
+BOOST_AUTO_TEST_CASE(Limits)
+{
+  BOOST_CHECK_THROW(PrefixLocationTree(10.0, 0), std::invalid_argument);
+
+  const auto t = time::steady_clock::now();
+  PrefixLocationTree tree(10.0, 2, 10_s);
+  BOOST_CHECK_EQUAL(tree.getMemoryUsage(), 0);
+  tree.insert("/A", ndn::Location(0, 0), t);
+  tree.insert("/A/B", ndn::Location(1, 1), t + 1_s);
+  size_t usage = tree.getMemoryUsage();
+  BOOST_CHECK_GT(usage, 0);
+
+  // touching /A makes /A/B the least recently used entry
+  tree.touch(*tree.find("/A")->second, t + 2_s);
+  tree.insert("/C", ndn::Location(2, 2), t + 3_s);
+  BOOST_CHECK_EQUAL(tree.size(), 2);
+  BOOST_CHECK(tree.find("/A/B") == tree.end());
+  BOOST_CHECK(!tree.find("/A")->second->hasChildren());
+  BOOST_CHECK(tree.findNearest("/A/B", ndn::Location(1, 1), 0.5) == nullptr);
+
+  // /A was last used at t + 2s, /C at t + 3s
+  BOOST_CHECK_EQUAL(tree.evict(t + 11_s), 0);
+  BOOST_CHECK_EQUAL(tree.evict(t + 12_s), 1);
+  BOOST_CHECK(tree.find("/A") == tree.end());
+  BOOST_CHECK_EQUAL(tree.evict(t + 13_s), 1);
+  BOOST_CHECK(tree.empty());
+  BOOST_CHECK_EQUAL(tree.size(), 0);
+  BOOST_CHECK_EQUAL(tree.getMemoryUsage(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(Replicas)
+{
+  const auto t = time::steady_clock::now();
+  PrefixLocationTree tree(10.0);
+  tree.addReplica("/A", ndn::Location(5, 5), t);
+  tree.addReplica("/A", ndn::Location(95, 95), t + 1_s);
+  tree.addReplica("/A", ndn::Location(5.5, 5), t + 2_s); // same replica as (5, 5)
+  BOOST_CHECK_EQUAL(tree.size(), 1);
+  size_t usage = tree.getMemoryUsage();
+
+  auto entry = tree.find("/A")->second;
+  BOOST_REQUIRE_EQUAL(entry->getReplicas().size(), 2);
+  BOOST_CHECK_EQUAL(entry->getLocation().getLatitude(), 5.5);
+  BOOST_CHECK(entry->getReplicas()[0].lastSeen == t + 2_s);
+  BOOST_CHECK_EQUAL(entry->getReplicas()[1].location.getLatitude(), 95);
+
+  // every replica is indexed in the grid
+  BOOST_CHECK_EQUAL(tree.findNearest("/A/seg", ndn::Location(90, 90), 10.0)->getName(), "/A");
+  BOOST_CHECK_EQUAL(tree.findNearest("/A/seg", ndn::Location(0, 0), 10.0)->getName(), "/A");
+  BOOST_CHECK(tree.findNearest("/A/seg", ndn::Location(50, 50), 10.0) == nullptr);
+
+  // the least recently seen replica is replaced when the set is full
+  for (size_t i = 0; i < PrefixLocationEntry::MAX_REPLICAS - 1; ++i) {
+    tree.addReplica("/A", ndn::Location(200 + 20 * i, 0), t + 3_s + time::seconds(i));
+  }
+  BOOST_CHECK_EQUAL(entry->getReplicas().size(), PrefixLocationEntry::MAX_REPLICAS);
+  BOOST_CHECK(tree.findNearest("/A/seg", ndn::Location(90, 90), 10.0) == nullptr);
+  BOOST_CHECK_EQUAL(tree.findNearest("/A/seg", ndn::Location(0, 0), 10.0)->getName(), "/A");
+  BOOST_CHECK_GT(tree.getMemoryUsage(), usage);
+
+  // insert replaces all replicas
+  tree.insert("/A", ndn::Location(95, 95), t + 10_s);
+  BOOST_CHECK_EQUAL(entry->getReplicas().size(), 1);
+  BOOST_CHECK(tree.findNearest("/A/seg", ndn::Location(0, 0), 10.0) == nullptr);
+  BOOST_CHECK_EQUAL(tree.findNearest("/A/seg", ndn::Location(90, 90), 10.0)->getName(), "/A");
+
+  tree.erase("/A");
+  BOOST_CHECK_EQUAL(tree.getMemoryUsage(), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestClfPrefixLocationTree
+BOOST_AUTO_TEST_SUITE_END() // Fw
+
+} // namespace tests
+} // namespace clf
+} // namespace fw
+} // namespace nfd
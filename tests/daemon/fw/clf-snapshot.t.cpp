@@ -0,0 +1,289 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "fw/clf-snapshot.hpp"
+#include "fw/strategy.hpp"
+
+#include "tests/test-common.hpp"
+#include "tests/daemon/global-io-fixture.hpp"
+#include "tests/daemon/face/dummy-face.hpp"
+#include "tests/daemon/fw/dummy-strategy.hpp"
+#include "tests/daemon/fw/choose-strategy.hpp"
+
+#include <sstream>
+
+namespace nfd {
+namespace fw {
+namespace clf {
+namespace tests {
+
+using namespace nfd::tests;
+
+class ClfSnapshotTestStrategy : public DummyStrategy
+{
+public:
+  static void
+  registerAs(const Name& strategyName)
+  {
+    registerAsImpl<ClfSnapshotTestStrategy>(strategyName);
+  }
+
+  ClfSnapshotTestStrategy(Forwarder& forwarder, const Name& name)
+    : DummyStrategy(forwarder, name)
+  {
+  }
+
+  MeasurementsAccessor&
+  getMeasurementsAccessor()
+  {
+    return this->getMeasurements();
+  }
+};
+
+/** \brief a node whose learned state is saved, and a restarted node that restores it
+ */
+class ClfSnapshotFixture : public GlobalIoTimeFixture
+{
+protected:
+  ClfSnapshotFixture()
+  {
+    const auto strategyName = Name("/clf-snapshot-test-strategy").appendVersion(1);
+    ClfSnapshotTestStrategy::registerAs(strategyName);
+    accessor = &choose<ClfSnapshotTestStrategy>(forwarder, "/", strategyName).getMeasurementsAccessor();
+    restartedAccessor = &choose<ClfSnapshotTestStrategy>(restartedForwarder, "/", strategyName)
+                           .getMeasurementsAccessor();
+
+    faceTable.add(face1);
+    faceTable.add(face2);
+    // after the restart, the faces are created in the opposite order
+    restartedFaceTable.add(make_shared<DummyFace>("dummy://local", "dummy://2"));
+    restartedFaceTable.add(make_shared<DummyFace>("dummy://local", "dummy://1"));
+  }
+
+  /** \brief learn scores of /A on face1 and face2, and two replicas of /P
+   */
+  void
+  learn(VanetMeasurements& vm, PrefixLocationTree& tree)
+  {
+    vm.incrementDataCount("/A", face1->getId());
+    vm.incrementDataCount("/A", face1->getId());
+    vm.incrementDataCount("/A", face2->getId());
+    advanceClocks(1_s, 6); // close the epoch
+    BOOST_REQUIRE_EQUAL(vm.getEpoch(), 1);
+
+    tree.insert("/P", ndn::Location(10, 20));
+    advanceClocks(1_s, 4);
+    tree.addReplica("/P", ndn::Location(30, 40));
+  }
+
+  static StateSnapshot
+  roundTrip(const StateSnapshot& snapshot)
+  {
+    std::stringstream ss;
+    snapshot.write(ss);
+    return StateSnapshot::read(ss);
+  }
+
+protected:
+  shared_ptr<Face> face1 = make_shared<DummyFace>("dummy://local", "dummy://1");
+  shared_ptr<Face> face2 = make_shared<DummyFace>("dummy://local", "dummy://2");
+  FaceTable faceTable;
+  Forwarder forwarder{faceTable};
+  MeasurementsAccessor* accessor;
+  FaceTable restartedFaceTable;
+  Forwarder restartedForwarder{restartedFaceTable};
+  MeasurementsAccessor* restartedAccessor;
+  SchedulerTimerBackend timers;
+};
+
+BOOST_AUTO_TEST_SUITE(Fw)
+BOOST_FIXTURE_TEST_SUITE(TestClfSnapshot, ClfSnapshotFixture)
+
+BOOST_AUTO_TEST_CASE(WriteRead)
+{
+  VanetMeasurements vm(*accessor, timers);
+  PrefixLocationTree tree;
+  learn(vm, tree);
+
+  StateSnapshot snapshot = StateSnapshot::capture(vm, tree, faceTable);
+  BOOST_CHECK(snapshot.getTimestamp() == time::system_clock::now());
+  BOOST_CHECK_EQUAL(snapshot.getNamespaces().size(), 2); // /A and the root
+  BOOST_REQUIRE_EQUAL(snapshot.getPrefixLocations().size(), 1);
+
+  StateSnapshot copy = roundTrip(snapshot);
+  BOOST_CHECK(copy.getTimestamp() == snapshot.getTimestamp());
+  BOOST_REQUIRE_EQUAL(copy.getNamespaces().size(), snapshot.getNamespaces().size());
+  for (size_t i = 0; i < copy.getNamespaces().size(); ++i) {
+    const auto& ns = copy.getNamespaces()[i];
+    BOOST_CHECK_EQUAL(ns.prefix, snapshot.getNamespaces()[i].prefix);
+    BOOST_CHECK_EQUAL(ns.idleTime, snapshot.getNamespaces()[i].idleTime);
+    BOOST_REQUIRE_EQUAL(ns.scores.size(), 2);
+    BOOST_CHECK_EQUAL(ns.scores[0].localUri, "dummy://local");
+    BOOST_CHECK_EQUAL(ns.scores[0].remoteUri, "dummy://1");
+    BOOST_CHECK_EQUAL(ns.scores[1].remoteUri, "dummy://2");
+    BOOST_CHECK_EQUAL(ns.scores[0].scs, snapshot.getNamespaces()[i].scores[0].scs);
+  }
+
+  const auto& location = copy.getPrefixLocations().front();
+  BOOST_CHECK_EQUAL(location.prefix, "/P");
+  BOOST_CHECK_EQUAL(location.idleTime, 0_ns);
+  BOOST_REQUIRE_EQUAL(location.replicas.size(), 2);
+  BOOST_CHECK_EQUAL(location.replicas[0].first.getLatitude(), 30);
+  BOOST_CHECK_EQUAL(location.replicas[0].second, 0_ns);
+  BOOST_CHECK_EQUAL(location.replicas[1].first.getLongitude(), 20);
+  BOOST_CHECK_EQUAL(location.replicas[1].second, 4_s);
+}
+
+BOOST_AUTO_TEST_CASE(Restore)
+{
+  VanetMeasurements vm(*accessor, timers);
+  PrefixLocationTree tree;
+  learn(vm, tree);
+  double centrality = *vm.getCentrality("/A/1");
+  BOOST_CHECK_GT(centrality, 0);
+
+  StateSnapshot snapshot = roundTrip(StateSnapshot::capture(vm, tree, faceTable));
+
+  // restarted 20 seconds later
+  VanetMeasurements restartedVm(*restartedAccessor, timers);
+  PrefixLocationTree restartedTree;
+  snapshot.restore(restartedVm, restartedTree, restartedFaceTable, snapshot.getTimestamp() + 20_s);
+
+  BOOST_CHECK_EQUAL(restartedVm.size(), 2);
+  BOOST_REQUIRE(restartedVm.getCentrality("/A/1"));
+  BOOST_CHECK_CLOSE(*restartedVm.getCentrality("/A/1"), centrality * 0.9 * 0.9, 0.0001);
+
+  auto entry = restartedTree.findLongestPrefix("/P/1");
+  BOOST_REQUIRE(entry != nullptr);
+  BOOST_REQUIRE_EQUAL(entry->getReplicas().size(), 2);
+  BOOST_CHECK_EQUAL(entry->getLocation().getLatitude(), 30);
+  BOOST_CHECK(entry->getReplicas()[0].lastSeen == time::steady_clock::now() - 20_s);
+  BOOST_CHECK(entry->getReplicas()[1].lastSeen == time::steady_clock::now() - 24_s);
+
+  // restored state keeps aging: the scores are gone with their lifetime
+  advanceClocks(10_s, VanetMeasurements::MEASUREMENTS_LIFETIME);
+  BOOST_CHECK_EQUAL(restartedVm.size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(RestoreFaces)
+{
+  VanetMeasurements vm(*accessor, timers);
+  PrefixLocationTree tree;
+  learn(vm, tree);
+  auto findA = [] (const std::vector<VanetMeasurements::NamespaceRecord>& records) {
+    auto it = std::find_if(records.begin(), records.end(), [] (const auto& r) { return r.prefix == "/A"; });
+    BOOST_REQUIRE(it != records.end());
+    return *it;
+  };
+  auto scores = findA(vm.exportScores()).scores;
+  BOOST_REQUIRE_EQUAL(scores.size(), 2);
+  BOOST_REQUIRE_EQUAL(scores[0].first, face1->getId());
+  BOOST_REQUIRE_GT(scores[0].second, scores[1].second);
+
+  StateSnapshot snapshot = roundTrip(StateSnapshot::capture(vm, tree, faceTable));
+
+  // the scores follow the FaceUris, not the FaceIds
+  {
+    VanetMeasurements restartedVm(*restartedAccessor, timers);
+    PrefixLocationTree restartedTree;
+    snapshot.restore(restartedVm, restartedTree, restartedFaceTable, snapshot.getTimestamp());
+    auto restored = findA(restartedVm.exportScores()).scores;
+    BOOST_REQUIRE_EQUAL(restored.size(), 2);
+    for (const auto& score : restored) {
+      const Face* face = restartedFaceTable.get(score.first);
+      BOOST_REQUIRE(face != nullptr);
+      size_t original = face->getRemoteUri().toString() == "dummy://1" ? 0 : 1;
+      BOOST_CHECK_CLOSE(score.second, scores[original].second, 0.0001);
+    }
+  }
+
+  // scores of faces that are missing or ambiguous are dropped
+  FaceTable otherFaceTable;
+  Forwarder otherForwarder{otherFaceTable};
+  const auto strategyName = Name("/clf-snapshot-test-strategy").appendVersion(1);
+  auto& otherAccessor = choose<ClfSnapshotTestStrategy>(otherForwarder, "/", strategyName).getMeasurementsAccessor();
+  otherFaceTable.add(make_shared<DummyFace>("dummy://local", "dummy://1"));
+  otherFaceTable.add(make_shared<DummyFace>("dummy://local", "dummy://1"));
+  otherFaceTable.add(make_shared<DummyFace>("dummy://local", "dummy://3"));
+  VanetMeasurements otherVm(otherAccessor, timers);
+  PrefixLocationTree otherTree;
+  snapshot.restore(otherVm, otherTree, otherFaceTable, snapshot.getTimestamp());
+  for (const auto& ns : otherVm.exportScores()) {
+    BOOST_CHECK(ns.scores.empty());
+  }
+  BOOST_CHECK(otherTree.findLongestPrefix("/P") != nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(RestoreStale)
+{
+  VanetMeasurements vm(*accessor, timers);
+  PrefixLocationTree tree;
+  learn(vm, tree);
+  StateSnapshot snapshot = StateSnapshot::capture(vm, tree, faceTable);
+
+  // one replica of /P expired during the downtime, and the other one is about to
+  PrefixLocationTree restartedTree(PrefixLocationTree::DEFAULT_CELL_SIZE, PrefixLocationTree::DEFAULT_MAX_ENTRIES,
+                                   30_s);
+  VanetMeasurements restartedVm(*restartedAccessor, timers, VanetMeasurements::DEFAULT_MAX_ENTRIES, 20_s);
+  snapshot.restore(restartedVm, restartedTree, restartedFaceTable, snapshot.getTimestamp() + 28_s);
+
+  BOOST_CHECK_EQUAL(restartedVm.size(), 0);
+  auto entry = restartedTree.findLongestPrefix("/P");
+  BOOST_REQUIRE(entry != nullptr);
+  BOOST_REQUIRE_EQUAL(entry->getReplicas().size(), 1);
+  BOOST_CHECK_EQUAL(entry->getLocation().getLatitude(), 30);
+
+  PrefixLocationTree emptyTree;
+  snapshot.restore(restartedVm, emptyTree, restartedFaceTable, snapshot.getTimestamp() + 1_h);
+  BOOST_CHECK(emptyTree.empty());
+}
+
+BOOST_AUTO_TEST_CASE(Malformed)
+{
+  VanetMeasurements vm(*accessor, timers);
+  PrefixLocationTree tree;
+  learn(vm, tree);
+  std::ostringstream os;
+  StateSnapshot::capture(vm, tree, faceTable).write(os);
+  const std::string wire = os.str();
+
+  std::istringstream badMagic("XLFS" + wire.substr(4));
+  BOOST_CHECK_THROW(StateSnapshot::read(badMagic), StateSnapshot::Error);
+
+  for (size_t size : {size_t(0), size_t(5), wire.size() / 2, wire.size() - 1}) {
+    std::istringstream truncated(wire.substr(0, size));
+    BOOST_CHECK_THROW(StateSnapshot::read(truncated), StateSnapshot::Error);
+  }
+
+  BOOST_CHECK_THROW(StateSnapshot::load("/nonexistent/clf.snapshot"), StateSnapshot::Error);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestClfSnapshot
+BOOST_AUTO_TEST_SUITE_END() // Fw
+
+} // namespace tests
+} // namespace clf
+} // namespace fw
+} // namespace nfd
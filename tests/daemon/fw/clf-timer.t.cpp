@@ -0,0 +1,84 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "fw/clf-timer.hpp"
+
+#include "tests/test-common.hpp"
+#include "tests/daemon/global-io-fixture.hpp"
+
+namespace nfd {
+namespace fw {
+namespace clf {
+namespace tests {
+
+using namespace nfd::tests;
+
+BOOST_AUTO_TEST_SUITE(Fw)
+BOOST_FIXTURE_TEST_SUITE(TestClfTimer, GlobalIoTimeFixture)
+
+BOOST_AUTO_TEST_CASE(Scheduler)
+{
+  auto timers = makeTimerBackend("scheduler");
+  BOOST_CHECK_EQUAL(timers->getName(), "scheduler");
+
+  int nFired = 0;
+  timers->schedule(10_ms, [&] { ++nFired; });
+  TimerId cancelled = timers->schedule(20_ms, [&] { ++nFired; });
+  BOOST_CHECK_EQUAL(timers->getCounters().nScheduled, 2);
+
+  this->advanceClocks(5_ms, 15_ms);
+  BOOST_CHECK_EQUAL(nFired, 1);
+
+  cancelled.cancel();
+  cancelled.cancel(); // no-op
+  this->advanceClocks(5_ms, 20_ms);
+  BOOST_CHECK_EQUAL(nFired, 1);
+  BOOST_CHECK_EQUAL(timers->getCounters().nFired, 1);
+  BOOST_CHECK_EQUAL(timers->getCounters().nCancelled, 1);
+}
+
+BOOST_AUTO_TEST_CASE(CancelAfterFire)
+{
+  auto timers = makeTimerBackend("scheduler");
+  TimerId id = timers->schedule(10_ms, [] {});
+  this->advanceClocks(5_ms, 15_ms);
+  id.cancel();
+  BOOST_CHECK_EQUAL(timers->getCounters().nFired, 1);
+  BOOST_CHECK_EQUAL(timers->getCounters().nCancelled, 0);
+}
+
+BOOST_AUTO_TEST_CASE(UnknownBackend)
+{
+  BOOST_CHECK_THROW(makeTimerBackend("no-such-backend"), std::invalid_argument);
+  BOOST_CHECK(makeTimerBackend() != nullptr);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestClfTimer
+BOOST_AUTO_TEST_SUITE_END() // Fw
+
+} // namespace tests
+} // namespace clf
+} // namespace fw
+} // namespace nfd
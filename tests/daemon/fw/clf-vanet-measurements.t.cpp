@@ -0,0 +1,274 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "fw/clf-vanet-measurements.hpp"
+#include "fw/strategy.hpp"
+
+#include "tests/test-common.hpp"
+#include "tests/daemon/global-io-fixture.hpp"
+#include "tests/daemon/fw/dummy-strategy.hpp"
+#include "tests/daemon/fw/choose-strategy.hpp"
+
+namespace nfd {
+namespace fw {
+namespace clf {
+namespace tests {
+
+using namespace nfd::tests;
+
+class ClfMeasurementsTestStrategy : public DummyStrategy
+{
+public:
+  static void
+  registerAs(const Name& strategyName)
+  {
+    registerAsImpl<ClfMeasurementsTestStrategy>(strategyName);
+  }
+
+  ClfMeasurementsTestStrategy(Forwarder& forwarder, const Name& name)
+    : DummyStrategy(forwarder, name)
+  {
+  }
+
+  MeasurementsAccessor&
+  getMeasurementsAccessor()
+  {
+    return this->getMeasurements();
+  }
+};
+
+class VanetMeasurementsFixture : public GlobalIoTimeFixture
+{
+protected:
+  VanetMeasurementsFixture()
+  {
+    const auto strategyName = Name("/clf-measurements-test-strategy").appendVersion(1);
+    ClfMeasurementsTestStrategy::registerAs(strategyName);
+    accessor = &choose<ClfMeasurementsTestStrategy>(forwarder, "/", strategyName)
+                 .getMeasurementsAccessor();
+  }
+
+  NamespaceInfo*
+  findInfo(const Name& prefix)
+  {
+    auto* me = accessor->findExactMatch(prefix);
+    return me == nullptr ? nullptr : me->getStrategyInfo<NamespaceInfo>();
+  }
+
+protected:
+  FaceTable faceTable;
+  Forwarder forwarder{faceTable};
+  const fib::Entry& fibEntry{forwarder.getFib().findLongestPrefixMatch("/")};
+  MeasurementsAccessor* accessor;
+  SchedulerTimerBackend timers;
+};
+
+BOOST_AUTO_TEST_SUITE(Fw)
+BOOST_AUTO_TEST_SUITE(TestClfVanetMeasurements)
+
+BOOST_AUTO_TEST_CASE(FaceSlots)
+{
+  NamespaceInfo info;
+  BOOST_CHECK_EQUAL(info.size(), 0);
+  BOOST_CHECK_EQUAL(info.findFace(256), NamespaceInfo::INVALID_SLOT);
+
+  // more faces than stored inline
+  for (FaceId faceId = 256; faceId < 256 + 2 * NamespaceInfo::N_INLINE_FACES; ++faceId) {
+    auto slot = info.getOrCreateFace(faceId);
+    BOOST_CHECK_EQUAL(info.getFaceId(slot), faceId);
+    BOOST_CHECK_EQUAL(info.findFace(faceId), slot);
+    BOOST_CHECK_EQUAL(info.getOrCreateFace(faceId), slot);
+    for (FaceId i = 256; i <= faceId; ++i) {
+      info.incrementInterestCount(slot);
+    }
+  }
+  BOOST_CHECK_EQUAL(info.size(), 2 * NamespaceInfo::N_INLINE_FACES);
+
+  for (FaceId faceId = 256; faceId < 256 + 2 * NamespaceInfo::N_INLINE_FACES; ++faceId) {
+    auto slot = info.findFace(faceId);
+    BOOST_CHECK_EQUAL(info.getInterestCount(slot), static_cast<int>(faceId - 255));
+    BOOST_CHECK_EQUAL(info.getDataCount(slot), 0);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(ScoreEpochs)
+{
+  const Name prefix("/A");
+  const auto t = time::steady_clock::now();
+  NamespaceInfo info;
+  auto slot = info.getOrCreateFace(256);
+  auto other = info.getOrCreateFace(257);
+  BOOST_CHECK_EQUAL(info.getScs(slot, 0, t), 0.0);
+  BOOST_CHECK(!info.hasCounts(slot));
+
+  info.incrementInterestCount(slot);
+  info.incrementInterestCount(slot);
+  info.incrementDataCount(slot);
+  BOOST_CHECK(info.hasCounts(slot));
+  BOOST_CHECK(!info.hasCounts(other));
+
+  info.updateScore(slot, prefix, 1, t);
+  BOOST_CHECK(!info.hasCounts(slot));
+  BOOST_CHECK_CLOSE(info.getCs(slot), 0.5, 0.0001);
+  BOOST_CHECK_CLOSE(info.getScs(slot, 1, t), 0.0625, 0.0001);
+  BOOST_CHECK_EQUAL(info.getScs(other, 1, t), 0.0);
+
+  // epochs 2 and 3 had no traffic: each contributes a centrality score of zero
+  double scs3 = 0.0625 * 0.875 * 0.875;
+  BOOST_CHECK_CLOSE(info.getScs(slot, 3, t), scs3, 0.0001);
+
+  info.addCounts(slot, 4, 4);
+  info.updateScore(slot, prefix, 4, t);
+  BOOST_CHECK_CLOSE(info.getScs(slot, 4, t), 0.125 + 0.875 * scs3, 0.0001);
+}
+
+BOOST_AUTO_TEST_CASE(ScoreMoreDataThanInterests)
+{
+  const Name prefix("/A");
+  const auto t = time::steady_clock::now();
+  NamespaceInfo info;
+  auto slot = info.getOrCreateFace(256);
+  info.addCounts(slot, 1, 3);
+  info.updateScore(slot, prefix, 1, t);
+  BOOST_CHECK_CLOSE(info.getCs(slot), 1.0, 0.0001);
+  BOOST_CHECK_CLOSE(info.getScs(slot, 1, t), 0.125, 0.0001);
+}
+
+BOOST_AUTO_TEST_CASE(ScoreDecay)
+{
+  const Name prefix("/A");
+  const auto t = time::steady_clock::now();
+  NamespaceInfo info;
+  auto slot = info.getOrCreateFace(256);
+  info.addCounts(slot, 1, 1);
+  info.updateScore(slot, prefix, 1, t);
+  BOOST_CHECK_CLOSE(info.getScs(slot, 1, t), 0.125, 0.0001);
+
+  // r = 0.9 per decay period = 10s by default, also for fractions of a period
+  BOOST_CHECK_CLOSE(info.getScs(slot, 1, t + 10_s), 0.125 * 0.9, 0.0001);
+  BOOST_CHECK_CLOSE(info.getScs(slot, 1, t + 25_s), 0.125 * std::pow(0.9, 2.5), 0.0001);
+
+  // an update folds the decayed score and restarts the decay
+  info.addCounts(slot, 1, 1);
+  info.updateScore(slot, prefix, 2, t + 20_s);
+  double scs = 0.125 + 0.875 * 0.125 * 0.81;
+  BOOST_CHECK_CLOSE(info.getScs(slot, 2, t + 20_s), scs, 0.0001);
+  BOOST_CHECK_CLOSE(info.getScs(slot, 2, t + 30_s), scs * 0.9, 0.0001);
+}
+
+BOOST_AUTO_TEST_CASE(ScoreCustomParameters)
+{
+  const Name prefix("/A");
+  const auto t = time::steady_clock::now();
+  ScoreParameters params;
+  params.alpha = 0.5;
+  params.r = 0.5;
+  params.decayPeriod = 2_s;
+
+  NamespaceInfo info;
+  auto slot = info.getOrCreateFace(256);
+  info.addCounts(slot, 1, 1);
+  info.updateScore(slot, prefix, 1, t, params);
+  BOOST_CHECK_CLOSE(info.getScs(slot, 1, t, params), 0.5, 0.0001);
+  BOOST_CHECK_CLOSE(info.getScs(slot, 1, t + 4_s, params), 0.5 * 0.25, 0.0001);
+  // an epoch without traffic weighs the score by 1 - alpha
+  BOOST_CHECK_CLOSE(info.getScs(slot, 2, t, params), 0.25, 0.0001);
+}
+
+BOOST_FIXTURE_TEST_CASE(Eviction, VanetMeasurementsFixture)
+{
+  BOOST_CHECK_THROW(VanetMeasurements(*accessor, timers, 0), std::invalid_argument);
+  BOOST_CHECK_THROW(VanetMeasurements(*accessor, timers, 2, VanetMeasurements::SCORE_UPDATE_INTERVAL),
+                    std::invalid_argument);
+  ScoreParameters badParams;
+  badParams.r = 0;
+  BOOST_CHECK_THROW(VanetMeasurements(*accessor, timers, 2, VanetMeasurements::MEASUREMENTS_LIFETIME, badParams),
+                    std::invalid_argument);
+
+  VanetMeasurements vm(*accessor, timers, 2, 10_s);
+  vm.incrementDataCount("/A", 256);
+  vm.incrementDataCount("/B", 256);
+  BOOST_CHECK_EQUAL(vm.size(), 2);
+  BOOST_REQUIRE(findInfo("/A") != nullptr);
+  size_t usage = vm.getMemoryUsage();
+  BOOST_CHECK_EQUAL(usage, 2 * findInfo("/A")->getMemoryUsage());
+
+  // the least recently used namespace is evicted, and is no longer dirty
+  vm.incrementDataCount("/C", 256);
+  BOOST_CHECK_EQUAL(vm.size(), 2);
+  BOOST_CHECK(findInfo("/A") == nullptr);
+  BOOST_CHECK(findInfo("/C") != nullptr);
+  BOOST_CHECK_EQUAL(vm.getNDirtyEntries(), 2);
+  BOOST_CHECK_EQUAL(vm.getMemoryUsage(), usage);
+
+  // closing the epoch creates the root namespace, which evicts /B
+  advanceClocks(1_s, 6);
+  BOOST_CHECK_EQUAL(vm.getEpoch(), 1);
+  BOOST_CHECK_EQUAL(vm.getNDirtyEntries(), 0);
+  BOOST_CHECK_EQUAL(vm.size(), 2);
+  BOOST_CHECK(findInfo("/") != nullptr);
+  BOOST_CHECK(findInfo("/B") == nullptr);
+
+  // unused namespaces expire with their measurement entries
+  advanceClocks(1_s, 15);
+  BOOST_CHECK_EQUAL(vm.size(), 0);
+  BOOST_CHECK_EQUAL(vm.getMemoryUsage(), 0);
+}
+
+class SkewedTimerBackend : public SchedulerTimerBackend
+{
+public:
+  time::steady_clock::TimePoint
+  now() const override
+  {
+    return SchedulerTimerBackend::now() + skew;
+  }
+
+public:
+  time::nanoseconds skew = 0_ns;
+};
+
+BOOST_FIXTURE_TEST_CASE(TimerClock, VanetMeasurementsFixture)
+{
+  SkewedTimerBackend skewedTimers;
+  VanetMeasurements vm(*accessor, skewedTimers, 10, 10_s);
+  vm.incrementDataCount("/A", 256);
+  BOOST_REQUIRE(findInfo("/A") != nullptr);
+
+  // namespaces age on the clock of the timer backend
+  skewedTimers.skew = 11_s;
+  vm.incrementDataCount("/B", 256);
+  BOOST_CHECK(findInfo("/A") == nullptr);
+  BOOST_CHECK(findInfo("/B") != nullptr);
+  BOOST_CHECK_EQUAL(vm.size(), 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestClfVanetMeasurements
+BOOST_AUTO_TEST_SUITE_END() // Fw
+
+} // namespace tests
+} // namespace clf
+} // namespace fw
+} // namespace nfd
@@ -0,0 +1,274 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "fw/clf-vanet-strategy.hpp"
+#include "face/lp-location.hpp"
+
+#include "tests/test-common.hpp"
+#include "tests/daemon/global-io-fixture.hpp"
+#include "tests/daemon/face/dummy-face.hpp"
+#include "choose-strategy.hpp"
+#include "strategy-tester.hpp"
+
+#include <boost/lexical_cast.hpp>
+
+namespace nfd {
+namespace fw {
+namespace clf {
+namespace tests {
+
+using namespace nfd::fw::tests;
+
+using ClfStrategyTester = StrategyTester<ClfStrategy>;
+NFD_REGISTER_STRATEGY(ClfStrategyTester);
+
+class ClfStrategyFixture : public GlobalIoTimeFixture
+{
+protected:
+  ClfStrategyFixture()
+    : appFace(make_shared<DummyFace>("dummy://", "dummy://", ndn::nfd::FACE_SCOPE_LOCAL))
+    , adHocFace(make_shared<DummyFace>("dummy://", "dummy://", ndn::nfd::FACE_SCOPE_NON_LOCAL,
+                                       ndn::nfd::FACE_PERSISTENCY_PERMANENT, ndn::nfd::LINK_TYPE_AD_HOC))
+  {
+    faceTable.add(appFace);
+    faceTable.add(adHocFace);
+    fib.addOrUpdateNextHop(*fib.insert("/").first, *adHocFace, 0);
+  }
+
+  ClfStrategyTester&
+  chooseMode(const std::string& mode)
+  {
+    return choose<ClfStrategyTester>(forwarder, "/",
+                                     Name(ClfStrategyTester::getStrategyName()).append("mode~" + mode));
+  }
+
+  /** \brief create an Interest as received from a neighbor at \p prev, by this node at \p me
+   */
+  static shared_ptr<Interest>
+  makeRebroadcastInterest(const Name& name, const ndn::Location& prev, const ndn::Location& me,
+                          const ndn::Location& dest = ndn::Location(0, 0))
+  {
+    auto interest = makeInterest(name);
+    auto locationTag = make_shared<face::LocationTag>();
+    locationTag->setMyLocation(me);
+    locationTag->setPrevLocation(prev);
+    locationTag->setDestLocation(dest);
+    interest->setTag(std::move(locationTag));
+    return interest;
+  }
+
+  shared_ptr<pit::Entry>
+  receiveInterest(ClfStrategyTester& strategy, Face& face, const Interest& interest)
+  {
+    auto pitEntry = pit.insert(interest).first;
+    pitEntry->insertOrUpdateInRecord(face, interest);
+    strategy.afterReceiveInterest(interest, FaceEndpoint(face, 0), pitEntry);
+    return pitEntry;
+  }
+
+protected:
+  FaceTable faceTable;
+  Forwarder forwarder{faceTable};
+  Fib& fib{forwarder.getFib()};
+  Pit& pit{forwarder.getPit()};
+
+  shared_ptr<DummyFace> appFace;
+  shared_ptr<DummyFace> adHocFace;
+};
+
+BOOST_AUTO_TEST_SUITE(Fw)
+BOOST_FIXTURE_TEST_SUITE(TestClfVanetStrategy, ClfStrategyFixture)
+
+BOOST_AUTO_TEST_CASE(ForwardingModes)
+{
+  for (auto mode : {ForwardingMode::BROADCAST, ForwardingMode::VNDN,
+                    ForwardingMode::NAVIGO, ForwardingMode::CLF}) {
+    BOOST_CHECK_EQUAL(parseForwardingMode(boost::lexical_cast<std::string>(mode)), mode);
+  }
+  BOOST_CHECK_THROW(parseForwardingMode(""), std::invalid_argument);
+  BOOST_CHECK_THROW(parseForwardingMode("CLF"), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(InstantiationWithParameters)
+{
+  auto checkValidity = [&] (std::string parameters, bool isCorrect) {
+    Name strategyName(Name(ClfStrategy::getStrategyName()).append(std::move(parameters)));
+    if (isCorrect) {
+      BOOST_CHECK_NO_THROW(make_unique<ClfStrategy>(forwarder, strategyName));
+    }
+    else {
+      BOOST_CHECK_THROW(make_unique<ClfStrategy>(forwarder, strategyName), std::invalid_argument);
+    }
+  };
+
+  checkValidity("", true);
+  checkValidity("/mode~broadcast", true);
+  checkValidity("/mode~vndn", true);
+  checkValidity("/mode~navigo", true);
+  checkValidity("/mode~clf", true);
+  checkValidity("/mode~navigo/timer-scale~0.5", true);
+  checkValidity("/alpha~0", true);
+  checkValidity("/alpha~1", true);
+  checkValidity("/smoothing~0.25/r~1/decay~10", true);
+  checkValidity("/timer-scale~2.5", true);
+  checkValidity("/timer~scheduler", true);
+  checkValidity("/distance~haversine/contention~adaptive", true);
+  checkValidity("/limit~100/lifetime~60/coalesce~2000", true);
+  checkValidity("/snapshot~clf-state/snapshot-interval~30", true);
+
+  checkValidity("/mode~foo", false);
+  checkValidity("/mode~", false);
+  checkValidity("/mode", false);
+  checkValidity("/~clf", false);
+  checkValidity("/foo~42", false);
+  // parseFraction
+  checkValidity("/alpha~1.5", false);
+  checkValidity("/alpha~-0.1", false);
+  checkValidity("/alpha~foo", false);
+  checkValidity("/smoothing~0", false);
+  checkValidity("/r~0", false);
+  checkValidity("/r~", false);
+  // parsePositiveInteger
+  checkValidity("/decay~0", false);
+  checkValidity("/decay~-10", false);
+  checkValidity("/decay~1.5", false);
+  checkValidity("/limit~", false);
+  checkValidity("/lifetime~+60", false);
+  checkValidity("/coalesce~99999999999999999999999", false);
+  checkValidity("/snapshot-interval~foo", false);
+  // other values
+  checkValidity("/timer-scale~0", false);
+  checkValidity("/timer-scale~-1", false);
+  checkValidity("/timer-scale~inf", false);
+  checkValidity("/timer~no-such-backend", false);
+  checkValidity("/distance~foo", false);
+  checkValidity("/contention~foo", false);
+  checkValidity("/snapshot~", false);
+
+  Name otherVersion = ClfStrategy::getStrategyName().getPrefix(-1);
+  otherVersion.appendVersion(ClfStrategy::getStrategyName()[-1].toVersion() + 1);
+  BOOST_CHECK_THROW(make_unique<ClfStrategy>(forwarder, otherVersion), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(Broadcast)
+{
+  auto& strategy = chooseMode("broadcast");
+
+  auto interest = makeInterest("/A/1");
+  receiveInterest(strategy, *appFace, *interest);
+  BOOST_REQUIRE_EQUAL(strategy.sendInterestHistory.size(), 1);
+  BOOST_CHECK_EQUAL(strategy.sendInterestHistory.back().outFaceId, adHocFace->getId());
+
+  // a neighbor's Interest is rebroadcast without delay as well
+  auto rebroadcast = makeRebroadcastInterest("/A/2", ndn::Location(100, 0), ndn::Location(200, 0));
+  receiveInterest(strategy, *adHocFace, *rebroadcast);
+  BOOST_CHECK_EQUAL(strategy.sendInterestHistory.size(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(Vndn)
+{
+  auto& strategy = chooseMode("vndn");
+
+  // the consumer broadcasts at once, with a Location header
+  auto interest = makeInterest("/A/1");
+  receiveInterest(strategy, *appFace, *interest);
+  BOOST_CHECK_EQUAL(strategy.sendInterestHistory.size(), 1);
+  BOOST_CHECK(face::getLocationTag(*interest) != nullptr);
+
+  // a relay defers the rebroadcast by its distance from the previous hop
+  auto rebroadcast = makeRebroadcastInterest("/A/2", ndn::Location(100, 0), ndn::Location(200, 0));
+  receiveInterest(strategy, *adHocFace, *rebroadcast);
+  BOOST_CHECK_EQUAL(strategy.sendInterestHistory.size(), 1);
+  BOOST_CHECK_EQUAL(strategy.getDeferredInterests().size(), 1);
+
+  advanceClocks(1_ms, 20);
+  BOOST_REQUIRE_EQUAL(strategy.sendInterestHistory.size(), 2);
+  BOOST_CHECK_EQUAL(strategy.sendInterestHistory.back().outFaceId, adHocFace->getId());
+  // the relay is the previous hop of its rebroadcast
+  auto locationTag = face::getLocationTag(*rebroadcast);
+  BOOST_REQUIRE(locationTag != nullptr);
+  BOOST_CHECK_EQUAL(locationTag->get().getPrevLocation().getLatitude(), 200);
+}
+
+BOOST_AUTO_TEST_CASE(Navigo)
+{
+  auto& strategy = chooseMode("navigo");
+
+  // a relay closer to the destination than the previous hop rebroadcasts after a delay
+  auto closer = makeRebroadcastInterest("/A/1", ndn::Location(100, 0), ndn::Location(200, 0),
+                                        ndn::Location(1000, 0));
+  receiveInterest(strategy, *adHocFace, *closer);
+  BOOST_CHECK_EQUAL(strategy.sendInterestHistory.size(), 0);
+  advanceClocks(10_ms, 20);
+  BOOST_CHECK_EQUAL(strategy.sendInterestHistory.size(), 1);
+
+  // a relay farther from the destination does not rebroadcast
+  auto farther = makeRebroadcastInterest("/A/2", ndn::Location(100, 0), ndn::Location(50, 0),
+                                         ndn::Location(1000, 0));
+  receiveInterest(strategy, *adHocFace, *farther);
+  advanceClocks(10_ms, 20);
+  BOOST_CHECK_EQUAL(strategy.sendInterestHistory.size(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(Clf)
+{
+  auto& strategy = chooseMode("clf");
+
+  // the consumer broadcasts at once, with a Location header
+  auto interest = makeInterest("/A/1");
+  receiveInterest(strategy, *appFace, *interest);
+  BOOST_CHECK_EQUAL(strategy.sendInterestHistory.size(), 1);
+  BOOST_CHECK(face::getLocationTag(*interest) != nullptr);
+
+  // a relay defers the rebroadcast by its location and centrality scores
+  auto rebroadcast = makeRebroadcastInterest("/A/2", ndn::Location(100, 0), ndn::Location(200, 0),
+                                             ndn::Location(1000, 0));
+  receiveInterest(strategy, *adHocFace, *rebroadcast);
+  BOOST_CHECK_EQUAL(strategy.sendInterestHistory.size(), 1);
+  advanceClocks(1_ms, 10);
+  BOOST_CHECK_EQUAL(strategy.sendInterestHistory.size(), 2);
+
+  // another copy received while the rebroadcast is deferred suppresses it
+  auto suppressed = makeRebroadcastInterest("/A/3", ndn::Location(100, 0), ndn::Location(200, 0),
+                                            ndn::Location(1000, 0));
+  receiveInterest(strategy, *adHocFace, *suppressed);
+  receiveInterest(strategy, *adHocFace, *suppressed);
+  BOOST_CHECK_EQUAL(strategy.rejectPendingInterestHistory.size(), 1);
+  advanceClocks(1_ms, 10);
+  BOOST_CHECK_EQUAL(strategy.sendInterestHistory.size(), 2);
+
+  const auto* counters = strategy.getContentionController().getCounters(adHocFace->getId());
+  BOOST_REQUIRE(counters != nullptr);
+  BOOST_CHECK_EQUAL(counters->nSuppressed, 1);
+  BOOST_CHECK_EQUAL(counters->nRebroadcasts, 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestClfVanetStrategy
+BOOST_AUTO_TEST_SUITE_END() // Fw
+
+} // namespace tests
+} // namespace clf
+} // namespace fw
+} // namespace nfd
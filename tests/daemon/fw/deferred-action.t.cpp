@@ -0,0 +1,122 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "fw/deferred-action.hpp"
+#include "fw/face-table.hpp"
+
+#include "tests/test-common.hpp"
+#include "tests/daemon/global-io-fixture.hpp"
+#include "tests/daemon/face/dummy-face.hpp"
+
+namespace nfd {
+namespace fw {
+namespace tests {
+
+using namespace nfd::tests;
+
+class DeferredActionFixture : public GlobalIoFixture
+{
+protected:
+  DeferredActionFixture()
+  {
+    faceTable.add(face);
+  }
+
+protected:
+  FaceTable faceTable;
+  shared_ptr<Face> face = make_shared<DummyFace>();
+  shared_ptr<Interest> interest = makeInterest("/A");
+  shared_ptr<pit::Entry> pitEntry = make_shared<pit::Entry>(*interest);
+};
+
+BOOST_AUTO_TEST_SUITE(Fw)
+BOOST_FIXTURE_TEST_SUITE(TestDeferredAction, DeferredActionFixture)
+
+BOOST_AUTO_TEST_CASE(Resolve)
+{
+  DeferredAction action(*interest, pitEntry, *face);
+  BOOST_CHECK(!action.empty());
+  BOOST_CHECK_EQUAL(action.getEgressId(), face->getId());
+  BOOST_CHECK_EQUAL(pitEntry.use_count(), 1);
+
+  auto resolved = action.resolve(faceTable);
+  BOOST_REQUIRE(resolved);
+  BOOST_CHECK_EQUAL(resolved.pitEntry, pitEntry);
+  BOOST_CHECK_EQUAL(resolved.interest, interest);
+  BOOST_CHECK_EQUAL(resolved.egress, face.get());
+
+  action.reset();
+  BOOST_CHECK(action.empty());
+  BOOST_CHECK(!action.resolve(faceTable));
+}
+
+BOOST_AUTO_TEST_CASE(InterestReleased)
+{
+  // an Interest that is not owned anymore is replaced by the Interest of the PIT entry
+  auto retx = makeInterest("/A", false, nullopt, 2);
+  DeferredAction action(*retx, pitEntry, *face);
+  retx.reset();
+
+  auto resolved = action.resolve(faceTable);
+  BOOST_REQUIRE(resolved);
+  BOOST_CHECK_EQUAL(resolved.interest.get(), &pitEntry->getInterest());
+}
+
+BOOST_AUTO_TEST_CASE(PitEntrySatisfied)
+{
+  DeferredAction action(*interest, pitEntry, *face);
+  pitEntry->isSatisfied = true;
+  BOOST_CHECK(!action.resolve(faceTable));
+}
+
+BOOST_AUTO_TEST_CASE(PitEntryErased)
+{
+  DeferredAction action(*interest, pitEntry, *face);
+  pitEntry.reset();
+  BOOST_CHECK(!action.resolve(faceTable));
+}
+
+BOOST_AUTO_TEST_CASE(HasName)
+{
+  DeferredAction action(*interest, pitEntry, *face);
+  BOOST_CHECK(action.hasName("/A"));
+  BOOST_CHECK(!action.hasName("/B"));
+  pitEntry.reset();
+  BOOST_CHECK(!action.hasName("/A"));
+}
+
+BOOST_AUTO_TEST_CASE(FaceRemoved)
+{
+  DeferredAction action(*interest, pitEntry, *face);
+  face->close();
+  BOOST_CHECK(!action.resolve(faceTable));
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestDeferredAction
+BOOST_AUTO_TEST_SUITE_END() // Fw
+
+} // namespace tests
+} // namespace fw
+} // namespace nfd
@@ -24,6 +24,9 @@
  */
 
 #include "mgmt/cs-manager.hpp"
+#include "core/cs-byte-info.hpp"
+#include "core/cs-wtinylfu-info.hpp"
+#include "table/cs-policy-wtinylfu.hpp"
 
 #include "manager-common-fixture.hpp"
 
@@ -221,6 +224,53 @@ BOOST_AUTO_TEST_CASE(Info)
   BOOST_CHECK_EQUAL(info.getNEntries(), 310);
   BOOST_CHECK_EQUAL(info.getNHits(), 362);
   BOOST_CHECK_EQUAL(info.getNMisses(), 1493);
+
+  auto byteInfo = extractCsByteInfo(info.wireEncode());
+  BOOST_REQUIRE(byteInfo);
+  BOOST_CHECK(byteInfo->byteCapacity == nullopt);
+  BOOST_CHECK_EQUAL(byteInfo->nBytes, m_cs.getNBytes());
+  BOOST_CHECK_GT(byteInfo->nBytes, 0);
+  BOOST_CHECK(extractCsWTinyLfuInfo(info.wireEncode()) == nullopt);
+}
+
+BOOST_AUTO_TEST_CASE(InfoByteLimit)
+{
+  m_cs.setByteLimit(65536);
+  m_cs.insert(*makeData("/Q8H4oi4g"));
+
+  receiveInterest(*makeInterest("/localhost/nfd/cs/info", true));
+  Block dataset = concatenateResponses();
+  dataset.parse();
+  BOOST_REQUIRE_EQUAL(dataset.elements_size(), 1);
+
+  auto byteInfo = extractCsByteInfo(*dataset.elements_begin());
+  BOOST_REQUIRE(byteInfo);
+  BOOST_CHECK(byteInfo->byteCapacity == optional<uint64_t>(65536));
+  BOOST_CHECK_EQUAL(byteInfo->nBytes, m_cs.getNBytes());
+}
+
+BOOST_AUTO_TEST_CASE(InfoWTinyLfu)
+{
+  m_cs.setPolicy(cs::Policy::create(cs::WTinyLfuPolicy::POLICY_NAME));
+  m_cs.insert(*makeData("/Q8H4oi4g"));
+  m_cs.insert(*makeData("/hb5KXbBW"));
+  bool isHit = false;
+  m_cs.find(*makeInterest("/Q8H4oi4g"), [&] (auto&&...) { isHit = true; }, [] (auto&&...) {});
+  BOOST_REQUIRE(isHit);
+
+  receiveInterest(*makeInterest("/localhost/nfd/cs/info", true));
+  Block dataset = concatenateResponses();
+  dataset.parse();
+  BOOST_REQUIRE_EQUAL(dataset.elements_size(), 1);
+
+  // the policy counters follow the byte usage
+  BOOST_CHECK(extractCsByteInfo(*dataset.elements_begin()));
+  auto policyInfo = extractCsWTinyLfuInfo(*dataset.elements_begin());
+  BOOST_REQUIRE(policyInfo);
+  BOOST_CHECK_EQUAL(policyInfo->nWindowHits + policyInfo->nProbationHits + policyInfo->nProtectedHits, 1);
+  BOOST_CHECK_EQUAL(policyInfo->nInserted, 2);
+  BOOST_CHECK_EQUAL(policyInfo->nAdmitted, 0);
+  BOOST_CHECK_EQUAL(policyInfo->nRejected, 0);
 }
 
 BOOST_AUTO_TEST_SUITE_END() // TestCsManager
@@ -24,6 +24,7 @@
  */
 
 #include "mgmt/face-manager.hpp"
+#include "core/face-contention-info.hpp"
 #include "face/protocol-factory.hpp"
 
 #include "manager-common-fixture.hpp"
@@ -208,6 +209,47 @@ BOOST_AUTO_TEST_CASE(FaceDataset)
   BOOST_CHECK_EQUAL(status.getNOutBytes(), face->getCounters().nOutBytes);
 }
 
+BOOST_AUTO_TEST_CASE(FaceDatasetContention)
+{
+  auto adHocFace = make_shared<DummyFace>("dummy://", "dummy://", ndn::nfd::FACE_SCOPE_NON_LOCAL,
+                                          ndn::nfd::FACE_PERSISTENCY_PERMANENT,
+                                          ndn::nfd::LINK_TYPE_AD_HOC);
+  m_faceTable.add(adHocFace);
+  auto p2pFace = addFace();
+  advanceClocks(1_ms, 10);
+  m_responses.clear();
+
+  auto& counters = adHocFace->getCounters();
+  counters.nDuplicateInterests.set(37);
+  counters.nDeferredInterests.set(52);
+  counters.nSuppressedInterests.set(19);
+  counters.nRebroadcastInterests.set(33);
+  counters.nRedundantRebroadcasts.set(4);
+
+  receiveInterest(Interest("/localhost/nfd/faces/list").setCanBePrefix(true));
+
+  Block content = concatenateResponses();
+  content.parse();
+  BOOST_REQUIRE_EQUAL(content.elements().size(), 2);
+  for (const Block& element : content.elements()) {
+    ndn::nfd::FaceStatus status(element);
+    auto contention = extractFaceContentionInfo(element);
+    if (status.getFaceId() != adHocFace->getId()) {
+      // only ad hoc faces carry the contention counters
+      BOOST_CHECK_EQUAL(status.getFaceId(), p2pFace->getId());
+      BOOST_CHECK(contention == nullopt);
+      continue;
+    }
+
+    BOOST_REQUIRE(contention);
+    BOOST_CHECK_EQUAL(contention->nDuplicateInterests, 37);
+    BOOST_CHECK_EQUAL(contention->nDeferredInterests, 52);
+    BOOST_CHECK_EQUAL(contention->nSuppressedInterests, 19);
+    BOOST_CHECK_EQUAL(contention->nRebroadcastInterests, 33);
+    BOOST_CHECK_EQUAL(contention->nRedundantRebroadcasts, 4);
+  }
+}
+
 BOOST_AUTO_TEST_CASE(FaceQuery)
 {
   using ndn::nfd::FaceQueryFilter;
@@ -152,6 +152,56 @@ BOOST_AUTO_TEST_CASE(InvalidValue)
 
 BOOST_AUTO_TEST_SUITE_END() // CsMaxPackets
 
+BOOST_AUTO_TEST_SUITE(CsMaxBytes)
+
+BOOST_AUTO_TEST_CASE(Default)
+{
+  const std::string CONFIG = R"CONFIG(
+    tables
+    {
+    }
+  )CONFIG";
+
+  cs.setByteLimit(4096);
+
+  BOOST_REQUIRE_NO_THROW(runConfig(CONFIG, false));
+  BOOST_CHECK_EQUAL(cs.getByteLimit(), std::numeric_limits<size_t>::max());
+}
+
+BOOST_AUTO_TEST_CASE(Valid)
+{
+  const std::string CONFIG = R"CONFIG(
+    tables
+    {
+      cs_max_bytes 65536
+    }
+  )CONFIG";
+
+  BOOST_REQUIRE_NO_THROW(runConfig(CONFIG, true));
+  BOOST_CHECK_NE(cs.getByteLimit(), 65536);
+
+  BOOST_REQUIRE_NO_THROW(runConfig(CONFIG, false));
+  BOOST_CHECK_EQUAL(cs.getByteLimit(), 65536);
+
+  tablesConfig.ensureConfigured();
+  BOOST_CHECK_EQUAL(cs.getByteLimit(), 65536);
+}
+
+BOOST_AUTO_TEST_CASE(InvalidValue)
+{
+  const std::string CONFIG = R"CONFIG(
+    tables
+    {
+      cs_max_bytes invalid
+    }
+  )CONFIG";
+
+  BOOST_CHECK_THROW(runConfig(CONFIG, true), ConfigFile::Error);
+  BOOST_CHECK_THROW(runConfig(CONFIG, false), ConfigFile::Error);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // CsMaxBytes
+
 BOOST_AUTO_TEST_SUITE(CsPolicy)
 
 BOOST_AUTO_TEST_CASE(Default)
@@ -269,6 +319,56 @@ BOOST_AUTO_TEST_CASE(Unknown)
 
 BOOST_AUTO_TEST_SUITE_END() // CsUnsolicitedPolicy
 
+BOOST_AUTO_TEST_SUITE(NameTreeLayout)
+
+using name_tree::HashtableLayout;
+
+BOOST_AUTO_TEST_CASE(Known)
+{
+  const std::string CONFIG = R"CONFIG(
+    tables
+    {
+      name_tree_layout open_addressing
+    }
+  )CONFIG";
+
+  NameTree& nameTree = forwarder.getNameTree();
+  size_t nEntries = nameTree.size();
+
+  runConfig(CONFIG, true);
+  BOOST_CHECK_EQUAL(nameTree.getHashtableLayout(), HashtableLayout::CHAINED);
+
+  runConfig(CONFIG, false);
+  BOOST_CHECK_EQUAL(nameTree.getHashtableLayout(), HashtableLayout::OPEN_ADDRESSING);
+  BOOST_CHECK_EQUAL(nameTree.size(), nEntries);
+  BOOST_CHECK(nameTree.findExactMatch("/") != nullptr);
+
+  const std::string CONFIG_DEFAULT = R"CONFIG(
+    tables
+    {
+    }
+  )CONFIG";
+
+  // omitted option reverts to the default
+  runConfig(CONFIG_DEFAULT, false);
+  BOOST_CHECK_EQUAL(nameTree.getHashtableLayout(), HashtableLayout::CHAINED);
+}
+
+BOOST_AUTO_TEST_CASE(Unknown)
+{
+  const std::string CONFIG = R"CONFIG(
+    tables
+    {
+      name_tree_layout unknown
+    }
+  )CONFIG";
+
+  BOOST_CHECK_THROW(runConfig(CONFIG, true), ConfigFile::Error);
+  BOOST_CHECK_THROW(runConfig(CONFIG, false), ConfigFile::Error);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // NameTreeLayout
+
 BOOST_AUTO_TEST_SUITE(StrategyChoice)
 
 BOOST_AUTO_TEST_CASE(Unversioned)
@@ -0,0 +1,175 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "table/cs-policy-centrality.hpp"
+
+#include "tests/daemon/table/cs-fixture.hpp"
+
+namespace nfd {
+namespace cs {
+namespace tests {
+
+class CentralityFixture : public CsFixture
+{
+protected:
+  CentralityFixture()
+  {
+    auto policy = make_unique<CentralityPolicy>();
+    this->policy = policy.get();
+    cs.setPolicy(std::move(policy));
+    cs.setLimit(3);
+
+    // /H is central, /L is peripheral, nothing is known about other names
+    cs.setCentralitySource(this, [] (const Name& name) -> optional<double> {
+      if (Name("/H").isPrefixOf(name)) {
+        return 0.8;
+      }
+      if (Name("/L").isPrefixOf(name)) {
+        return 0.05;
+      }
+      return nullopt;
+    });
+  }
+
+protected:
+  CentralityPolicy* policy;
+};
+
+BOOST_AUTO_TEST_SUITE(Table)
+BOOST_FIXTURE_TEST_SUITE(TestCsCentrality, CentralityFixture)
+
+BOOST_AUTO_TEST_CASE(Registration)
+{
+  std::set<std::string> policyNames = Policy::getPolicyNames();
+  BOOST_CHECK_EQUAL(policyNames.count("centrality"), 1);
+}
+
+BOOST_AUTO_TEST_CASE(CentralitySources)
+{
+  BOOST_CHECK(cs.getCentrality("/A") == nullopt);
+  BOOST_CHECK_EQUAL(*cs.getCentrality("/L/1"), 0.05);
+
+  int other = 0;
+  cs.setCentralitySource(&other, [] (const Name&) { return optional<double>(0.3); });
+  BOOST_CHECK_EQUAL(*cs.getCentrality("/A"), 0.3);
+  BOOST_CHECK_EQUAL(*cs.getCentrality("/L/1"), 0.3);
+  BOOST_CHECK_EQUAL(*cs.getCentrality("/H/1"), 0.8);
+
+  cs.setCentralitySource(&other, nullptr);
+  BOOST_CHECK(cs.getCentrality("/A") == nullopt);
+}
+
+BOOST_AUTO_TEST_CASE(EvictByPriority)
+{
+  insert(1, "/H/1");
+  insert(2, "/A");
+  insert(3, "/L/1");
+
+  // evict /L/1 (low priority)
+  insert(4, "/B");
+  BOOST_CHECK_EQUAL(cs.size(), 3);
+  startInterest("/L/1");
+  CHECK_CS_FIND(0);
+
+  // evict /A (least recently used of normal priority)
+  startInterest("/A");
+  CHECK_CS_FIND(2);
+  startInterest("/B");
+  CHECK_CS_FIND(4);
+  insert(5, "/C");
+  BOOST_CHECK_EQUAL(cs.size(), 3);
+  startInterest("/A");
+  CHECK_CS_FIND(0);
+  startInterest("/H/1");
+  CHECK_CS_FIND(1);
+
+  const AdmissionCounters& counters = policy->getCounters();
+  BOOST_CHECK_EQUAL(counters.nAdmitted[PRIORITY_HIGH], 1);
+  BOOST_CHECK_EQUAL(counters.nAdmitted[PRIORITY_NORMAL], 3);
+  BOOST_CHECK_EQUAL(counters.nAdmitted[PRIORITY_LOW], 1);
+  BOOST_CHECK_EQUAL(counters.nRejected, 0);
+}
+
+BOOST_AUTO_TEST_CASE(RejectLowPriority)
+{
+  insert(1, "/H/1");
+  insert(2, "/A");
+  insert(3, "/L/1");
+
+  // a low priority entry may evict another one
+  insert(4, "/L/2");
+  BOOST_CHECK_EQUAL(cs.size(), 3);
+  startInterest("/L/1");
+  CHECK_CS_FIND(0);
+  startInterest("/L/2");
+  CHECK_CS_FIND(4);
+
+  // but not an entry of higher priority
+  insert(5, "/B");
+  insert(6, "/L/3");
+  insert(7, "/C", nullptr, true);
+  BOOST_CHECK_EQUAL(cs.size(), 3);
+  startInterest("/L/3");
+  CHECK_CS_FIND(0);
+  startInterest("/C");
+  CHECK_CS_FIND(0);
+  startInterest("/H/1");
+  CHECK_CS_FIND(1);
+
+  const AdmissionCounters& counters = policy->getCounters();
+  BOOST_CHECK_EQUAL(counters.nAdmitted[PRIORITY_LOW], 2);
+  BOOST_CHECK_EQUAL(counters.nRejected, 2);
+}
+
+BOOST_AUTO_TEST_CASE(Refresh)
+{
+  double centrality = 0.3;
+  cs.setCentralitySource(this, [&] (const Name&) { return optional<double>(centrality); });
+
+  insert(1, "/A");
+  insert(2, "/B");
+  insert(3, "/C");
+
+  // /A becomes central when refreshed
+  centrality = 0.9;
+  insert(1, "/A");
+  centrality = 0.3;
+
+  insert(4, "/D");
+  insert(5, "/E");
+  insert(6, "/F");
+  BOOST_CHECK_EQUAL(cs.size(), 3);
+  startInterest("/A");
+  CHECK_CS_FIND(1);
+  startInterest("/D");
+  CHECK_CS_FIND(0);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestCsCentrality
+BOOST_AUTO_TEST_SUITE_END() // Table
+
+} // namespace tests
+} // namespace cs
+} // namespace nfd
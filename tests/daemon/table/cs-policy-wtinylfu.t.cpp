@@ -0,0 +1,169 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "table/cs-policy-wtinylfu.hpp"
+
+#include "tests/daemon/table/cs-fixture.hpp"
+
+namespace nfd {
+namespace cs {
+namespace tests {
+
+using namespace nfd::cs::wtinylfu;
+
+class WTinyLfuFixture : public CsFixture
+{
+protected:
+  WTinyLfuFixture()
+  {
+    auto policy = make_unique<WTinyLfuPolicy>();
+    this->policy = policy.get();
+    cs.setPolicy(std::move(policy));
+    cs.setLimit(200);
+  }
+
+protected:
+  WTinyLfuPolicy* policy;
+};
+
+BOOST_AUTO_TEST_SUITE(Table)
+BOOST_FIXTURE_TEST_SUITE(TestCsWTinyLfu, WTinyLfuFixture)
+
+BOOST_AUTO_TEST_CASE(Registration)
+{
+  std::set<std::string> policyNames = Policy::getPolicyNames();
+  BOOST_CHECK_EQUAL(policyNames.count("wtinylfu"), 1);
+}
+
+BOOST_AUTO_TEST_CASE(Sketch)
+{
+  FrequencySketch sketch;
+  BOOST_CHECK_EQUAL(sketch.estimate(1), 0);
+
+  sketch.resize(100);
+  for (int i = 0; i < 3; ++i) {
+    sketch.increment(1);
+  }
+  BOOST_CHECK_EQUAL(sketch.estimate(1), 3);
+
+  for (int i = 0; i < 20; ++i) {
+    sketch.increment(2);
+  }
+  BOOST_CHECK_EQUAL(sketch.estimate(2), FrequencySketch::MAX_COUNT);
+
+  // counters are halved after 10 * 100 increments
+  uint64_t key = 1000;
+  while (sketch.estimate(2) == FrequencySketch::MAX_COUNT) {
+    BOOST_REQUIRE_LT(key, 2000);
+    sketch.increment(key++ * 0x9e3779b97f4a7c15);
+  }
+  BOOST_CHECK_EQUAL(sketch.estimate(2), FrequencySketch::MAX_COUNT / 2);
+  BOOST_CHECK_GE(key, 1000 + 10 * 100 - 3 - FrequencySketch::MAX_COUNT);
+}
+
+BOOST_AUTO_TEST_CASE(ScanResistance)
+{
+  // a hot working set, used until its frequencies saturate
+  for (uint32_t i = 0; i < 50; ++i) {
+    insert(i + 1, Name("/H").appendNumber(i));
+  }
+  for (int j = 0; j < 14; ++j) {
+    for (uint32_t i = 0; i < 50; ++i) {
+      startInterest(Name("/H").appendNumber(i));
+      CHECK_CS_FIND(i + 1);
+    }
+  }
+
+  // a sequential scan larger than the Content Store
+  for (uint32_t i = 0; i < 400; ++i) {
+    insert(i + 1000, Name("/S").appendNumber(i));
+  }
+  BOOST_CHECK_EQUAL(cs.size(), 200);
+
+  for (uint32_t i = 0; i < 50; ++i) {
+    startInterest(Name("/H").appendNumber(i));
+    CHECK_CS_FIND(i + 1);
+  }
+
+  const HitCounters& counters = policy->getCounters();
+  BOOST_CHECK_EQUAL(counters.nInserted, 450);
+  BOOST_CHECK_EQUAL(counters.nAdmitted, 0);
+  BOOST_CHECK_EQUAL(counters.nRejected, 250);
+  // the window holds the last two entries of the working set
+  BOOST_CHECK_EQUAL(counters.nHits[SEGMENT_WINDOW], 2 * 14);
+  BOOST_CHECK_EQUAL(counters.nHits[SEGMENT_PROBATION], 48 + 2);
+  BOOST_CHECK_EQUAL(counters.nHits[SEGMENT_PROTECTED], 48 * 13 + 48);
+}
+
+BOOST_AUTO_TEST_CASE(AdmitFrequent)
+{
+  for (uint32_t i = 0; i < 200; ++i) {
+    insert(i + 1, Name("/A").appendNumber(i));
+  }
+
+  // /B is evicted from the window of two entries when it is seen for the first time
+  insert(1001, "/B");
+  insert(1002, "/C");
+  insert(1003, "/D");
+  startInterest("/B");
+  CHECK_CS_FIND(0);
+
+  // but admitted over /A/0 when it is retrieved again
+  insert(1004, "/B");
+  insert(1005, "/E");
+  insert(1006, "/F");
+  startInterest("/B");
+  CHECK_CS_FIND(1004);
+  startInterest(Name("/A").appendNumber(0));
+  CHECK_CS_FIND(0);
+  BOOST_CHECK_EQUAL(cs.size(), 200);
+
+  const HitCounters& counters = policy->getCounters();
+  BOOST_CHECK_EQUAL(counters.nAdmitted, 1);
+  BOOST_CHECK_EQUAL(counters.nRejected, 5);
+}
+
+BOOST_AUTO_TEST_CASE(EraseAndByteLimit)
+{
+  for (uint32_t i = 0; i < 10; ++i) {
+    insert(i + 1, Name("/A").appendNumber(i));
+  }
+  startInterest(Name("/A").appendNumber(0));
+  CHECK_CS_FIND(1);
+
+  BOOST_CHECK_EQUAL(erase("/A", 3), 3);
+  BOOST_CHECK_EQUAL(cs.size(), 7);
+
+  cs.setByteLimit(cs.begin()->getNBytes() * 4);
+  BOOST_CHECK_EQUAL(cs.size(), 4);
+  BOOST_CHECK_LE(cs.getNBytes(), cs.getByteLimit());
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestCsWTinyLfu
+BOOST_AUTO_TEST_SUITE_END() // Table
+
+} // namespace tests
+} // namespace cs
+} // namespace nfd
@@ -24,6 +24,7 @@
  */
 
 #include "table/cs.hpp"
+#include "table/name-tree-hashtable.hpp"
 
 #include "tests/daemon/table/cs-fixture.hpp"
 
@@ -109,6 +110,36 @@ BOOST_AUTO_TEST_CASE(PrefixName_NoCanBePrefix)
   CHECK_CS_FIND(0);
 }
 
+BOOST_AUTO_TEST_CASE(ExactName_MustBeFresh)
+{
+  insert(1, "/A");
+  insert(2, "/A", [] (Data& data) { data.setFreshnessPeriod(1_h); });
+  insert(3, "/A/B", [] (Data& data) { data.setFreshnessPeriod(1_h); });
+
+  advanceClocks(500_ms);
+  startInterest("/A")
+    .setMustBeFresh(true);
+  CHECK_CS_FIND(2);
+}
+
+BOOST_AUTO_TEST_CASE(ExactName_AfterEviction)
+{
+  cs.setLimit(1);
+  Name n1 = insert(1, "/A");
+  insert(2, "/B");
+
+  startInterest("/A");
+  CHECK_CS_FIND(0);
+  startInterest(n1);
+  CHECK_CS_FIND(0);
+  startInterest("/B");
+  CHECK_CS_FIND(2);
+
+  insert(3, "/A");
+  startInterest("/A");
+  CHECK_CS_FIND(3);
+}
+
 BOOST_AUTO_TEST_CASE(MustBeFresh)
 {
   insert(1, "/A/1"); // omitted FreshnessPeriod means FreshnessPeriod = 0 ms
@@ -177,6 +208,32 @@ BOOST_AUTO_TEST_CASE(Erase)
   BOOST_CHECK_EQUAL(cs.size(), 2);
 }
 
+BOOST_AUTO_TEST_CASE(ByteLimit)
+{
+  insert(1, "/A");
+  insert(2, "/B");
+  BOOST_CHECK_EQUAL(cs.getNBytes(), cs.begin()->getNBytes() + std::next(cs.begin())->getNBytes());
+  const size_t nBytesPerEntry = cs.begin()->getNBytes();
+  BOOST_CHECK_GT(nBytesPerEntry, cs.begin()->getData().wireEncode().size());
+
+  cs.setByteLimit(nBytesPerEntry * 3);
+  insert(3, "/C");
+  insert(4, "/D");
+  BOOST_CHECK_EQUAL(cs.size(), 3);
+  BOOST_CHECK_LE(cs.getNBytes(), cs.getByteLimit());
+  startInterest("/A");
+  CHECK_CS_FIND(0);
+  startInterest("/D");
+  CHECK_CS_FIND(4);
+
+  cs.setByteLimit(nBytesPerEntry);
+  BOOST_CHECK_EQUAL(cs.size(), 1);
+  BOOST_CHECK_EQUAL(cs.getNBytes(), nBytesPerEntry);
+
+  BOOST_CHECK_EQUAL(erase("/", 10), 1);
+  BOOST_CHECK_EQUAL(cs.getNBytes(), 0);
+}
+
 // When the capacity limit is set to zero, Data cannot be inserted;
 // this test case covers this situation.
 // The behavior of non-zero capacity limit depends on the eviction policy,
@@ -238,6 +295,18 @@ BOOST_AUTO_TEST_CASE(CachePolicyNoCache)
   CHECK_CS_FIND(0);
 }
 
+BOOST_AUTO_TEST_CASE(StripHashes)
+{
+  insert(1, "/A/B", [] (Data& data) {
+    // as cached by the PIT lookup of the Data
+    name_tree::getHashes(data);
+    BOOST_REQUIRE(data.getTag<name_tree::HashesTag>() != nullptr);
+  });
+
+  BOOST_REQUIRE_EQUAL(cs.size(), 1);
+  BOOST_CHECK(cs.begin()->getData().getTag<name_tree::HashesTag>() == nullptr);
+}
+
 BOOST_AUTO_TEST_CASE(Enumeration)
 {
   Name nameA("/A");
@@ -28,6 +28,8 @@
 #include "tests/test-common.hpp"
 #include "tests/daemon/global-io-fixture.hpp"
 
+#include <numeric>
+
 namespace nfd {
 namespace name_tree {
 namespace tests {
@@ -51,6 +53,41 @@ BOOST_AUTO_TEST_CASE(ComputeHash)
 
   hashes = computeHashes(prefix, 2);
   BOOST_CHECK_EQUAL(hashes.size(), 3);
+
+  for (size_t i = 0; i <= prefix.size(); ++i) {
+    BOOST_CHECK_EQUAL(computeHashes(prefix).at(i), computeHash(prefix, i));
+  }
+
+  // the order of components matters
+  BOOST_CHECK_NE(computeHash("/A/B"), computeHash("/B/A"));
+}
+
+BOOST_AUTO_TEST_CASE(PacketHashes)
+{
+  auto interest = makeInterest("/A/B/C/D");
+  const HashSequence& hashes = getHashes(*interest, 2);
+  BOOST_CHECK_GE(hashes.size(), 3);
+  for (size_t i = 0; i < hashes.size(); ++i) {
+    BOOST_CHECK_EQUAL(hashes[i], computeHash(interest->getName(), i));
+  }
+
+  // cached on the packet
+  BOOST_CHECK(interest->getTag<HashesTag>() != nullptr);
+  BOOST_CHECK_EQUAL(&getHashes(*interest, 1), &hashes);
+
+  // a longer sequence replaces the cached one
+  const HashSequence& allHashes = getHashes(*interest);
+  BOOST_CHECK_EQUAL(allHashes.size(), 5);
+  BOOST_CHECK_EQUAL(allHashes.back(), computeHash(interest->getName()));
+
+  // the cache does not apply to a new name
+  interest->setName("/E/F");
+  const HashSequence& newHashes = getHashes(*interest);
+  BOOST_CHECK_EQUAL(newHashes.size(), 3);
+  BOOST_CHECK_EQUAL(newHashes.back(), computeHash("/E/F"));
+
+  auto data = makeData("/A/B");
+  BOOST_CHECK_EQUAL(getHashes(*data).back(), computeHash("/A/B"));
 }
 
 BOOST_AUTO_TEST_SUITE(Hashtable)
@@ -183,6 +220,149 @@ BOOST_AUTO_TEST_CASE(Resize)
   BOOST_CHECK_EQUAL(ht.getNBuckets(), 6);
 }
 
+BOOST_AUTO_TEST_CASE(OpenAddressing)
+{
+  HashtableOptions options(9);
+  options.layout = HashtableLayout::OPEN_ADDRESSING;
+  Hashtable ht(options);
+  BOOST_CHECK_EQUAL(ht.getLayout(), HashtableLayout::OPEN_ADDRESSING);
+  size_t minNBuckets = ht.getNBuckets();
+  BOOST_CHECK_GE(minNBuckets, 16);
+  BOOST_CHECK_EQUAL(minNBuckets & (minNBuckets - 1), 0); // power of two
+
+  std::vector<const Node*> nodes;
+  for (int i = 0; i < 1000; ++i) {
+    Name name;
+    name.appendNumber(i);
+    HashSequence hashes = computeHashes(name);
+    const Node* node = nullptr;
+    bool isNew = false;
+    std::tie(node, isNew) = ht.insert(name, name.size(), hashes);
+    BOOST_CHECK(isNew);
+    nodes.push_back(node);
+  }
+  BOOST_CHECK_EQUAL(ht.size(), 1000);
+  BOOST_CHECK_GE(ht.getNBuckets(), 1000 / 0.875);
+
+  for (int i = 0; i < 1000; ++i) {
+    Name name;
+    name.appendNumber(i);
+    BOOST_CHECK_EQUAL(ht.find(name, name.size()), nodes[i]);
+    size_t bucket = ht.getBucketIndex(nodes[i]);
+    BOOST_REQUIRE_LT(bucket, ht.getNBucketIndices());
+    BOOST_CHECK_EQUAL(ht.getBucket(bucket), nodes[i]);
+    BOOST_CHECK(nodes[i]->next == nullptr);
+  }
+
+  // interleave erasures and insertions, leaving deleted buckets behind
+  for (int i = 0; i < 1000; i += 2) {
+    ht.erase(const_cast<Node*>(nodes[i]));
+    Name name;
+    name.appendNumber(i + 1000);
+    HashSequence hashes = computeHashes(name);
+    BOOST_CHECK(ht.insert(name, name.size(), hashes).second);
+  }
+  BOOST_CHECK_EQUAL(ht.size(), 1000);
+  for (int i = 0; i < 2000; ++i) {
+    Name name;
+    name.appendNumber(i);
+    bool isPresent = (i < 1000) == (i % 2 == 1);
+    BOOST_CHECK_EQUAL(ht.find(name, name.size()) != nullptr, isPresent);
+  }
+
+  for (int i = 1; i < 2000; i += 2) {
+    Name name;
+    name.appendNumber(i < 1000 ? i : i - 1);
+    const Node* node = ht.find(name, name.size());
+    BOOST_REQUIRE(node != nullptr);
+    ht.erase(const_cast<Node*>(node));
+  }
+  BOOST_CHECK_EQUAL(ht.size(), 0);
+  BOOST_CHECK_EQUAL(ht.getNBuckets(), minNBuckets);
+}
+
+BOOST_AUTO_TEST_CASE(IncrementalResize)
+{
+  for (auto layout : {HashtableLayout::CHAINED, HashtableLayout::OPEN_ADDRESSING}) {
+    BOOST_TEST_CONTEXT("layout=" << layout) {
+      HashtableOptions options(16);
+      options.layout = layout;
+      options.migrationStep = 1;
+      Hashtable ht(options);
+
+      std::vector<const Node*> nodes;
+      bool hasResized = false;
+      for (int i = 0; i < 200; ++i) {
+        Name name;
+        name.appendNumber(i);
+        HashSequence hashes = computeHashes(name);
+        nodes.push_back(ht.insert(name, name.size(), hashes).first);
+        hasResized = hasResized || ht.isResizing();
+
+        // nodes are found in either bucket array while the old one is migrated
+        for (int j = 0; j <= i; ++j) {
+          Name name2;
+          name2.appendNumber(j);
+          BOOST_CHECK_EQUAL(ht.find(name2, name2.size()), nodes[j]);
+        }
+      }
+      BOOST_CHECK(hasResized);
+
+      std::set<const Node*> enumerated;
+      for (size_t bucket = 0; bucket < ht.getNBucketIndices(); ++bucket) {
+        for (const Node* node = ht.getBucket(bucket); node != nullptr; node = node->next) {
+          BOOST_CHECK(enumerated.insert(node).second);
+        }
+      }
+      BOOST_CHECK_EQUAL(enumerated.size(), nodes.size());
+
+      ht.finishResize();
+      BOOST_CHECK(!ht.isResizing());
+      BOOST_CHECK_EQUAL(ht.getNBucketIndices(), ht.getNBuckets());
+
+      for (const Node* node : nodes) {
+        ht.erase(const_cast<Node*>(node));
+      }
+      BOOST_CHECK_EQUAL(ht.size(), 0);
+
+      const HashtableResizeStats& stats = ht.getResizeStats();
+      BOOST_CHECK_GT(stats.nResizes, 0);
+      BOOST_CHECK_GT(stats.nSteps, stats.nResizes);
+      BOOST_CHECK_GT(stats.nTimedSteps, 0);
+      BOOST_CHECK_LT(stats.nTimedSteps, stats.nSteps);
+      BOOST_CHECK_EQUAL(std::accumulate(stats.histogram.begin(), stats.histogram.end(), uint64_t(0)),
+                        stats.nTimedSteps);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(SetLayout)
+{
+  Hashtable ht(HashtableOptions(16));
+  BOOST_CHECK_EQUAL(ht.getLayout(), HashtableLayout::CHAINED);
+
+  Name name("/A/B/C/D");
+  HashSequence hashes = computeHashes(name);
+  std::vector<const Node*> nodes;
+  for (size_t i = 0; i <= name.size(); ++i) {
+    nodes.push_back(ht.insert(name, i, hashes).first);
+  }
+
+  ht.setLayout(HashtableLayout::OPEN_ADDRESSING);
+  BOOST_CHECK_EQUAL(ht.getLayout(), HashtableLayout::OPEN_ADDRESSING);
+  BOOST_CHECK_EQUAL(ht.size(), nodes.size());
+  for (size_t i = 0; i <= name.size(); ++i) {
+    BOOST_CHECK_EQUAL(ht.find(name, i, hashes), nodes[i]);
+  }
+
+  ht.setLayout(HashtableLayout::CHAINED);
+  BOOST_CHECK_EQUAL(ht.getLayout(), HashtableLayout::CHAINED);
+  BOOST_CHECK_EQUAL(ht.size(), nodes.size());
+  for (size_t i = 0; i <= name.size(); ++i) {
+    BOOST_CHECK_EQUAL(ht.find(name, i, hashes), nodes[i]);
+  }
+}
+
 BOOST_AUTO_TEST_SUITE_END() // Hashtable
 
 BOOST_AUTO_TEST_SUITE(TestEntry)
@@ -691,6 +871,30 @@ BOOST_FIXTURE_TEST_CASE(IteratorFindAllMatches, EnumerationFixture)
     .end();
 }
 
+BOOST_AUTO_TEST_CASE(OpenAddressingEnumeration)
+{
+  NameTree nt;
+  nt.lookup("/A/B/C");
+  nt.lookup("/A/D");
+  nt.setHashtableLayout(HashtableLayout::OPEN_ADDRESSING);
+  nt.lookup("/E/F");
+  BOOST_CHECK_EQUAL(nt.size(), 7);
+
+  std::set<Name> seenNames;
+  for (const Entry& entry : nt) {
+    BOOST_CHECK(seenNames.insert(entry.getName()).second);
+  }
+  BOOST_CHECK_EQUAL(seenNames.size(), 7);
+
+  Entry* entry = nt.findLongestPrefixMatch("/A/B/X");
+  BOOST_REQUIRE(entry != nullptr);
+  BOOST_CHECK_EQUAL(entry->getName(), "/A/B");
+
+  BOOST_CHECK_EQUAL(nt.eraseIfEmpty(nt.findExactMatch("/E/F")), 2);
+  BOOST_CHECK_EQUAL(nt.size(), 5);
+  BOOST_CHECK(nt.findExactMatch("/E") == nullptr);
+}
+
 BOOST_AUTO_TEST_CASE(HashTableResizeShrink)
 {
   size_t nBuckets = 16;
@@ -189,6 +189,20 @@ BOOST_AUTO_TEST_CASE(EraseWithFullName)
   BOOST_CHECK(pit.find(*interest) != nullptr);
 }
 
+BOOST_AUTO_TEST_CASE(NameTreeDepth)
+{
+  auto data = makeData("/A/B");
+  BOOST_CHECK_EQUAL(Pit::getNameTreeDepth("/A/B"), 2);
+  BOOST_CHECK_EQUAL(Pit::getNameTreeDepth(data->getFullName()), 2);
+  BOOST_CHECK_EQUAL(Pit::getNameTreeDepth("/"), 0);
+
+  Name longName;
+  while (longName.size() < NameTree::getMaxDepth() + 2) {
+    longName.append("X");
+  }
+  BOOST_CHECK_EQUAL(Pit::getNameTreeDepth(longName), NameTree::getMaxDepth());
+}
+
 BOOST_AUTO_TEST_CASE(FindAllDataMatches)
 {
   Name nameA   ("/A");
@@ -0,0 +1,199 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "benchmark-helpers.hpp"
+#include "fw/clf-vanet-measurements.hpp"
+
+#include <iostream>
+#include <random>
+
+#ifdef NFD_HAVE_VALGRIND
+#include <valgrind/callgrind.h>
+#endif
+
+namespace nfd {
+namespace tests {
+
+class ClfBenchmarkFixture
+{
+protected:
+  ClfBenchmarkFixture()
+  {
+#ifdef _DEBUG
+    std::cerr << "Benchmark compiled in debug mode is unreliable, please compile in release mode.\n";
+#endif
+  }
+
+  static time::microseconds
+  timedRun(const std::function<void()>& f)
+  {
+#ifdef NFD_HAVE_VALGRIND
+    CALLGRIND_START_INSTRUMENTATION;
+#endif
+
+    auto t1 = time::steady_clock::now();
+    f();
+    auto t2 = time::steady_clock::now();
+
+#ifdef NFD_HAVE_VALGRIND
+    CALLGRIND_STOP_INSTRUMENTATION;
+#endif
+
+    return time::duration_cast<time::microseconds>(t2 - t1);
+  }
+
+  static void
+  printRate(const std::string& label, size_t count, time::microseconds d)
+  {
+    std::cout << label << " " << count << ": " << d << ", "
+              << static_cast<uint64_t>(count * 1e6 / std::max<int64_t>(d.count(), 1))
+              << " lookups/s" << std::endl;
+  }
+
+  /** \brief (namespace, face) pairs looked up by a stream of forwarded packets
+   */
+  struct Lookup
+  {
+    size_t ns;
+    FaceId faceId;
+  };
+
+  static std::vector<Lookup>
+  makeLookupWorkload(size_t count)
+  {
+    std::mt19937 rng(0);
+    std::uniform_int_distribution<size_t> nsDist(0, N_NAMESPACES - 1);
+    std::uniform_int_distribution<FaceId> faceDist(FIRST_FACE_ID, FIRST_FACE_ID + N_FACES - 1);
+
+    std::vector<Lookup> workload(count);
+    for (auto& lookup : workload) {
+      lookup = {nsDist(rng), faceDist(rng)};
+    }
+    return workload;
+  }
+
+protected:
+  static constexpr size_t N_NAMESPACES = 10000;
+  static constexpr size_t N_FACES = 4;
+  static constexpr FaceId FIRST_FACE_ID = 256;
+  static constexpr size_t N_LOOKUPS = 10000000;
+};
+
+/** \brief per-face statistics as laid out before NamespaceInfo became a structure of arrays
+ *
+ *  This reproduces the data layout and the lookup of the removed FaceInfo and CsStats classes: an
+ *  unordered_map node per face, found twice by NamespaceInfo::get, and an Interest count that takes
+ *  the namespace name by value. It is not the removed code itself, which cannot be built against
+ *  the current VanetMeasurements, and it has two limits: the debug log statement of the old
+ *  incrementInterestCount is left out, and the scores are never updated. Both make this baseline
+ *  faster than the removed code, so the measured gain is a lower bound.
+ */
+class LegacyNamespaceInfo
+{
+public:
+  struct FaceInfo
+  {
+    void
+    incrementInterestCount(Name prefix)
+    {
+      ++nInterests;
+    }
+
+    int nInterests = 0;
+    int nData = 0;
+    double cs = 0;
+    double scs = 0;
+    uint64_t lastEpoch = 0;
+    time::steady_clock::TimePoint lastUpdate = time::steady_clock::TimePoint::min();
+  };
+
+  FaceInfo*
+  get(FaceId faceId)
+  {
+    if (m_fit.find(faceId) != m_fit.end()) {
+      return &m_fit.at(faceId);
+    }
+    else {
+      return nullptr;
+    }
+  }
+
+  void
+  insert(FaceId faceId)
+  {
+    m_fit.emplace(faceId, FaceInfo());
+  }
+
+private:
+  std::unordered_map<FaceId, FaceInfo> m_fit;
+};
+
+// the result of a timed loop is stored here, so that the loop is not optimized away
+static volatile double g_sink = 0;
+
+// find the face of a namespace, count an Interest and read the score
+BOOST_FIXTURE_TEST_CASE(FaceStatsLookup, ClfBenchmarkFixture)
+{
+  auto workload = makeLookupWorkload(N_LOOKUPS);
+  double sum = 0;
+
+  std::vector<Name> names;
+  std::vector<unique_ptr<LegacyNamespaceInfo>> legacy;
+  std::vector<unique_ptr<fw::clf::NamespaceInfo>> infos;
+  for (size_t i = 0; i < N_NAMESPACES; ++i) {
+    names.push_back(Name("/clf/namespace").appendNumber(i));
+    legacy.push_back(make_unique<LegacyNamespaceInfo>());
+    infos.push_back(make_unique<fw::clf::NamespaceInfo>());
+    for (FaceId faceId = FIRST_FACE_ID; faceId < FIRST_FACE_ID + N_FACES; ++faceId) {
+      legacy.back()->insert(faceId);
+      infos.back()->getOrCreateFace(faceId);
+    }
+  }
+
+  auto d1 = timedRun([&] {
+    for (const auto& lookup : workload) {
+      auto* info = legacy[lookup.ns]->get(lookup.faceId);
+      info->incrementInterestCount(names[lookup.ns]);
+      sum += info->cs;
+    }
+  });
+  printRate("unordered_map", N_LOOKUPS, d1);
+  g_sink = sum;
+  sum = 0;
+
+  auto d2 = timedRun([&] {
+    for (const auto& lookup : workload) {
+      auto& info = *infos[lookup.ns];
+      auto slot = info.findFace(lookup.faceId);
+      info.incrementInterestCount(slot);
+      sum += info.getCs(slot);
+    }
+  });
+  printRate("struct-of-arrays", N_LOOKUPS, d2);
+  g_sink = sum;
+}
+
+} // namespace tests
+} // namespace nfd
@@ -0,0 +1,762 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "benchmark-helpers.hpp"
+#include "common/global.hpp"
+#include "face/face.hpp"
+#include "face/internal-transport.hpp"
+#include "face/link-service.hpp"
+#include "fw/clf-vanet-strategy.hpp"
+#include "fw/face-table.hpp"
+#include "fw/forwarder.hpp"
+
+#include <ndn-cxx/prefix-announcement.hpp>
+#include <ndn-cxx/security/key-chain.hpp>
+#include <ndn-cxx/security/signing-helpers.hpp>
+#include <ndn-cxx/util/time-unit-test-clock.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <new>
+#include <random>
+
+// Count heap allocations made by the whole program, to report the allocations per received Interest.
+// Every replaceable allocation function is replaced, so that no form of new escapes the count and
+// no pointer is released by a deallocation function that does not match its allocator.
+static size_t g_nAllocations = 0;
+
+static void*
+countedAllocate(std::size_t size, std::size_t alignment = 0) noexcept
+{
+  ++g_nAllocations;
+  if (size == 0) {
+    size = 1;
+  }
+  if (alignment <= alignof(std::max_align_t)) {
+    return std::malloc(size);
+  }
+  void* p = nullptr;
+  return ::posix_memalign(&p, alignment, size) == 0 ? p : nullptr;
+}
+
+static void*
+countedAllocateOrThrow(std::size_t size, std::size_t alignment = 0)
+{
+  void* p = countedAllocate(size, alignment);
+  if (p == nullptr) {
+    throw std::bad_alloc();
+  }
+  return p;
+}
+
+void*
+operator new(std::size_t size)
+{
+  return countedAllocateOrThrow(size);
+}
+
+void*
+operator new[](std::size_t size)
+{
+  return countedAllocateOrThrow(size);
+}
+
+void*
+operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+  return countedAllocate(size);
+}
+
+void*
+operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+  return countedAllocate(size);
+}
+
+void
+operator delete(void* p) noexcept
+{
+  std::free(p);
+}
+
+void
+operator delete[](void* p) noexcept
+{
+  std::free(p);
+}
+
+void
+operator delete(void* p, std::size_t) noexcept
+{
+  std::free(p);
+}
+
+void
+operator delete[](void* p, std::size_t) noexcept
+{
+  std::free(p);
+}
+
+void
+operator delete(void* p, const std::nothrow_t&) noexcept
+{
+  std::free(p);
+}
+
+void
+operator delete[](void* p, const std::nothrow_t&) noexcept
+{
+  std::free(p);
+}
+
+#ifdef __cpp_aligned_new
+void*
+operator new(std::size_t size, std::align_val_t alignment)
+{
+  return countedAllocateOrThrow(size, static_cast<std::size_t>(alignment));
+}
+
+void*
+operator new[](std::size_t size, std::align_val_t alignment)
+{
+  return countedAllocateOrThrow(size, static_cast<std::size_t>(alignment));
+}
+
+void*
+operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+  return countedAllocate(size, static_cast<std::size_t>(alignment));
+}
+
+void*
+operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+  return countedAllocate(size, static_cast<std::size_t>(alignment));
+}
+
+void
+operator delete(void* p, std::align_val_t) noexcept
+{
+  std::free(p);
+}
+
+void
+operator delete[](void* p, std::align_val_t) noexcept
+{
+  std::free(p);
+}
+
+void
+operator delete(void* p, std::size_t, std::align_val_t) noexcept
+{
+  std::free(p);
+}
+
+void
+operator delete[](void* p, std::size_t, std::align_val_t) noexcept
+{
+  std::free(p);
+}
+
+void
+operator delete(void* p, std::align_val_t, const std::nothrow_t&) noexcept
+{
+  std::free(p);
+}
+
+void
+operator delete[](void* p, std::align_val_t, const std::nothrow_t&) noexcept
+{
+  std::free(p);
+}
+#endif // __cpp_aligned_new
+
+namespace nfd {
+namespace tests {
+
+using fw::clf::ClfStrategy;
+
+/** \brief a recorded mobility-and-request trace
+ *
+ *  The text format has one event per line, sorted by time:
+ *  \code
+ *  <time-ms> position <node> <x> <y>
+ *  <time-ms> produce <node> <prefix>
+ *  <time-ms> interest <node> <name>
+ *  \endcode
+ *  Positions are planar coordinates, in the same unit as the radio range.
+ *  Empty lines and lines starting with '#' are ignored.
+ */
+struct ClfTrace
+{
+  enum class EventType {
+    POSITION,
+    PRODUCE,
+    INTEREST,
+  };
+
+  struct Event
+  {
+    time::milliseconds time;
+    EventType type;
+    size_t node;
+    ndn::Location location;
+    Name name;
+  };
+
+  static ClfTrace
+  load(std::istream& is)
+  {
+    ClfTrace trace;
+    std::string line;
+    while (std::getline(is, line)) {
+      if (line.empty() || line[0] == '#') {
+        continue;
+      }
+
+      std::istringstream iss(line);
+      uint64_t ms = 0;
+      std::string type;
+      Event event;
+      if (!(iss >> ms >> type >> event.node)) {
+        NDN_THROW(std::invalid_argument("Malformed trace line: " + line));
+      }
+      event.time = time::milliseconds(ms);
+
+      if (type == "position") {
+        double x = 0, y = 0;
+        iss >> x >> y;
+        event.type = EventType::POSITION;
+        event.location = ndn::Location(x, y);
+      }
+      else if (type == "produce" || type == "interest") {
+        std::string name;
+        iss >> name;
+        event.type = type == "produce" ? EventType::PRODUCE : EventType::INTEREST;
+        event.name = Name(name);
+      }
+      else {
+        NDN_THROW(std::invalid_argument("Unknown trace event: " + type));
+      }
+      if (!iss) {
+        NDN_THROW(std::invalid_argument("Malformed trace line: " + line));
+      }
+
+      trace.nNodes = std::max(trace.nNodes, event.node + 1);
+      trace.events.push_back(std::move(event));
+    }
+
+    std::stable_sort(trace.events.begin(), trace.events.end(),
+                     [] (const Event& a, const Event& b) { return a.time < b.time; });
+    return trace;
+  }
+
+  /** \brief generate vehicles driving both ways on a circular highway
+   *
+   *  The first \p nProducers vehicles each announce /clf/p<i>. Every other vehicle
+   *  requests a new segment of a random producer prefix every \p interestInterval.
+   */
+  static ClfTrace
+  generate(size_t nNodes, size_t nProducers, double highwayLength,
+           time::milliseconds duration, time::milliseconds positionInterval,
+           time::milliseconds interestInterval)
+  {
+    BOOST_ASSERT(nProducers < nNodes);
+
+    ClfTrace trace;
+    trace.nNodes = nNodes;
+
+    std::mt19937 gen(0);
+    std::uniform_real_distribution<double> startDist(0, highwayLength);
+    std::uniform_real_distribution<double> speedDist(20, 35); // per second
+    std::uniform_int_distribution<size_t> producerDist(0, nProducers - 1);
+    std::uniform_int_distribution<int64_t> phaseDist(0, interestInterval.count() - 1);
+
+    // coordinates are offset, because (0, 0) means an absent location
+    const double offset = 1000;
+    std::vector<double> start(nNodes);
+    std::vector<double> speed(nNodes);
+    for (size_t i = 0; i < nNodes; ++i) {
+      start[i] = startDist(gen);
+      speed[i] = speedDist(gen) * (i % 2 == 0 ? 1 : -1);
+    }
+
+    for (size_t i = 0; i < nProducers; ++i) {
+      trace.events.push_back({0_ms, EventType::PRODUCE, i, {}, Name("/clf/p" + to_string(i))});
+    }
+
+    for (auto t = 0_ms; t < duration; t += positionInterval) {
+      double seconds = time::duration_cast<time::duration<double>>(t).count();
+      for (size_t i = 0; i < nNodes; ++i) {
+        double x = std::fmod(start[i] + speed[i] * seconds, highwayLength);
+        if (x < 0) {
+          x += highwayLength;
+        }
+        // one lane per direction
+        double y = speed[i] > 0 ? 0 : 10;
+        trace.events.push_back({t, EventType::POSITION, i, ndn::Location(offset + x, offset + y), {}});
+      }
+    }
+
+    for (size_t i = nProducers; i < nNodes; ++i) {
+      uint64_t seq = 0;
+      for (auto t = time::milliseconds(phaseDist(gen)) + positionInterval; t < duration; t += interestInterval) {
+        Name name("/clf/p" + to_string(producerDist(gen)));
+        name.append(to_string(i)).appendSegment(seq++);
+        trace.events.push_back({t, EventType::INTEREST, i, {}, name});
+      }
+    }
+
+    std::stable_sort(trace.events.begin(), trace.events.end(),
+                     [] (const Event& a, const Event& b) { return a.time < b.time; });
+    return trace;
+  }
+
+  size_t nNodes = 0;
+  std::vector<Event> events;
+};
+
+/** \brief a LinkService that hands packets to callbacks instead of encoding them
+ *
+ *  Tags attached to the packets, such as LocationTag and PrefixAnnouncementTag, are kept.
+ */
+class InProcessLinkService final : public face::LinkService
+{
+public:
+  void
+  receive(const Interest& interest, EndpointId endpointId = 0)
+  {
+    receiveInterest(interest, endpointId);
+  }
+
+  void
+  receive(const Data& data, EndpointId endpointId = 0)
+  {
+    receiveData(data, endpointId);
+  }
+
+private:
+  void
+  doSendInterest(const Interest& interest) final
+  {
+    if (onSendInterest) {
+      onSendInterest(interest);
+    }
+  }
+
+  void
+  doSendData(const Data& data) final
+  {
+    if (onSendData) {
+      onSendData(data);
+    }
+  }
+
+  void
+  doSendNack(const lp::Nack&) final
+  {
+  }
+
+  void
+  doReceivePacket(const Block&, const EndpointId&) final
+  {
+  }
+
+public:
+  std::function<void(const Interest&)> onSendInterest;
+  std::function<void(const Data&)> onSendData;
+};
+
+/** \brief replays a ClfTrace on one Forwarder per vehicle, with the CLF strategy
+ *
+ *  Each vehicle has an ad-hoc face attached to a shared broadcast medium, which delivers every
+ *  transmission to the vehicles within RADIO_RANGE after PROPAGATION_DELAY, and sets the
+ *  LocationTag of the received copy from the positions of the sender and the receiver. Each
+ *  vehicle also has an application face, through which producers answer Interests with Data
+ *  carrying their prefix announcement. Time is virtual: the clocks advance by TICK between
+ *  polls of the global io_service. TICK is the tick interval of the deferred Interest pool,
+ *  so that deferred transmissions are not delayed beyond their tick.
+ */
+class ClfTraceBenchmarkFixture
+{
+protected:
+  ClfTraceBenchmarkFixture()
+    : m_steadyClock(make_shared<time::UnitTestSteadyClock>())
+    , m_systemClock(make_shared<time::UnitTestSystemClock>())
+  {
+#ifdef _DEBUG
+    std::cerr << "Benchmark compiled in debug mode is unreliable, please compile in release mode.\n";
+#endif
+    time::setCustomClocks(m_steadyClock, m_systemClock);
+  }
+
+  ~ClfTraceBenchmarkFixture()
+  {
+    m_nodes.clear();
+    resetGlobalIoService();
+    time::setCustomClocks(nullptr, nullptr);
+  }
+
+  struct Node
+  {
+    FaceTable faceTable;
+    Forwarder forwarder{faceTable};
+    InProcessLinkService* adHoc = nullptr;
+    shared_ptr<Face> adHocFace;
+    InProcessLinkService* app = nullptr;
+    shared_ptr<Face> appFace;
+    ndn::Location location;
+    optional<lp::PrefixAnnouncementHeader> announcement;
+    std::unordered_map<Name, time::steady_clock::TimePoint> pending;
+  };
+
+  struct Stats
+  {
+    size_t nExpressed = 0;
+    size_t nSatisfied = 0;
+    time::nanoseconds totalLatency = 0_ns;
+    size_t nTransmissions = 0;
+    size_t nInterestDeliveries = 0;
+    std::chrono::nanoseconds interestCpuTime{0};
+    size_t nInterestAllocations = 0;
+  };
+
+  void
+  setup(const ClfTrace& trace, const Name& strategyName = ClfStrategy::getStrategyName())
+  {
+    for (size_t i = 0; i < trace.nNodes; ++i) {
+      auto node = make_unique<Node>();
+      node->adHocFace = makeFace(ndn::nfd::FACE_SCOPE_NON_LOCAL, ndn::nfd::LINK_TYPE_AD_HOC, node->adHoc);
+      node->appFace = makeFace(ndn::nfd::FACE_SCOPE_LOCAL, ndn::nfd::LINK_TYPE_POINT_TO_POINT, node->app);
+      node->faceTable.add(node->adHocFace);
+      node->faceTable.add(node->appFace);
+
+      node->forwarder.getStrategyChoice().insert("/clf", strategyName);
+      auto& fibEntry = *node->forwarder.getFib().insert("/clf").first;
+      node->forwarder.getFib().addOrUpdateNextHop(fibEntry, *node->adHocFace, 0);
+
+      node->adHoc->onSendInterest = [this, i] (const Interest& interest) { broadcast(i, interest); };
+      node->adHoc->onSendData = [this, i] (const Data& data) { broadcast(i, data); };
+      node->app->onSendInterest = [this, i] (const Interest& interest) { produce(i, interest); };
+      node->app->onSendData = [this, i] (const Data& data) { consume(i, data); };
+      m_nodes.push_back(std::move(node));
+    }
+  }
+
+  void
+  apply(const ClfTrace::Event& event)
+  {
+    Node& node = *m_nodes.at(event.node);
+    switch (event.type) {
+      case ClfTrace::EventType::POSITION:
+        node.location = event.location;
+        break;
+      case ClfTrace::EventType::PRODUCE: {
+        ndn::PrefixAnnouncement pa;
+        pa.setAnnouncedName(event.name);
+        pa.setExpiration(1_h);
+        pa.toData(m_keyChain, ndn::signingWithSha256());
+        node.announcement.emplace(pa);
+        auto& fibEntry = *node.forwarder.getFib().insert(event.name).first;
+        node.forwarder.getFib().addOrUpdateNextHop(fibEntry, *node.appFace, 0);
+        break;
+      }
+      case ClfTrace::EventType::INTEREST: {
+        Interest interest(event.name);
+        interest.setInterestLifetime(INTEREST_LIFETIME);
+        node.pending[event.name] = time::steady_clock::now();
+        ++stats.nExpressed;
+        node.app->receive(interest);
+        break;
+      }
+    }
+  }
+
+  /** \brief advance the virtual clocks to \p t, polling the global io_service at every tick
+   */
+  void
+  advanceTo(time::nanoseconds t)
+  {
+    while (m_now < t) {
+      auto step = std::min<time::nanoseconds>(TICK, t - m_now);
+      m_steadyClock->advance(step);
+      m_systemClock->advance(step);
+      m_now += step;
+
+      auto& io = getGlobalIoService();
+      if (io.stopped()) {
+#if BOOST_VERSION >= 106600
+        io.restart();
+#else
+        io.reset();
+#endif
+      }
+      io.poll();
+    }
+  }
+
+  ClfStrategy&
+  getStrategy(size_t i)
+  {
+    return dynamic_cast<ClfStrategy&>(m_nodes[i]->forwarder.getStrategyChoice().findEffectiveStrategy("/clf"));
+  }
+
+  size_t
+  getNodeCount() const
+  {
+    return m_nodes.size();
+  }
+
+  const Node&
+  getNode(size_t i) const
+  {
+    return *m_nodes[i];
+  }
+
+private:
+  static shared_ptr<Face>
+  makeFace(ndn::nfd::FaceScope scope, ndn::nfd::LinkType linkType, InProcessLinkService*& service)
+  {
+    auto linkService = make_unique<InProcessLinkService>();
+    service = linkService.get();
+    auto transport = make_unique<face::InternalForwarderTransport>(FaceUri("internal://"), FaceUri("internal://"),
+                                                                   scope, linkType);
+    return make_shared<Face>(std::move(linkService), std::move(transport));
+  }
+
+  template<typename Packet>
+  void
+  broadcast(size_t sender, const Packet& packet)
+  {
+    ++stats.nTransmissions;
+    const ndn::Location& from = m_nodes[sender]->location;
+    auto locationTag = packet.template getTag<face::LocationTag>();
+    ndn::Location dest = locationTag == nullptr ? ndn::Location(0, 0) : locationTag->get().getDestLocation();
+
+    for (size_t i = 0; i < m_nodes.size(); ++i) {
+      const ndn::Location& to = m_nodes[i]->location;
+      if (i == sender || std::hypot(from.getLatitude() - to.getLatitude(),
+                                    from.getLongitude() - to.getLongitude()) > RADIO_RANGE) {
+        continue;
+      }
+
+      auto copy = make_shared<Packet>(packet);
+      getScheduler().schedule(PROPAGATION_DELAY, [this, i, sender, copy, from, dest] {
+        deliver(i, sender, *copy, from, dest);
+      });
+    }
+  }
+
+  template<typename Packet>
+  void
+  deliver(size_t receiver, size_t sender, Packet& packet, const ndn::Location& from, const ndn::Location& dest)
+  {
+    Node& node = *m_nodes[receiver];
+    // the copies share the sender's tag, so each receiver gets its own, as if decoded from the wire
+    auto locationTag = make_shared<face::LocationTag>();
+    locationTag->setMyLocation(node.location);
+    locationTag->setPrevLocation(from);
+    locationTag->setDestLocation(dest);
+    packet.setTag(std::move(locationTag));
+
+    // the endpoint of a neighbor is its index, which is never zero
+    EndpointId endpointId = sender + 1;
+    if (std::is_same<Packet, Interest>::value) {
+      auto nAllocations = g_nAllocations;
+      auto t1 = std::chrono::steady_clock::now();
+      node.adHoc->receive(packet, endpointId);
+      auto t2 = std::chrono::steady_clock::now();
+      stats.interestCpuTime += t2 - t1;
+      stats.nInterestAllocations += g_nAllocations - nAllocations;
+      ++stats.nInterestDeliveries;
+    }
+    else {
+      node.adHoc->receive(packet, endpointId);
+    }
+  }
+
+  void
+  produce(size_t i, const Interest& interest)
+  {
+    Node& node = *m_nodes[i];
+    if (!node.announcement) {
+      return;
+    }
+
+    auto data = make_shared<Data>(interest.getName());
+    data->setFreshnessPeriod(1_s);
+    data->setSignatureInfo(ndn::SignatureInfo(tlv::NullSignature));
+    data->setSignatureValue(std::make_shared<ndn::Buffer>());
+    data->wireEncode();
+    data->setTag(make_shared<lp::PrefixAnnouncementTag>(*node.announcement));
+
+    // reply asynchronously, as an application would
+    getScheduler().schedule(PRODUCER_DELAY, [&node, data] { node.app->receive(*data); });
+  }
+
+  void
+  consume(size_t i, const Data& data)
+  {
+    Node& node = *m_nodes[i];
+    auto it = node.pending.find(data.getName());
+    if (it == node.pending.end()) {
+      return;
+    }
+
+    ++stats.nSatisfied;
+    stats.totalLatency += time::steady_clock::now() - it->second;
+    node.pending.erase(it);
+  }
+
+public:
+  static constexpr double RADIO_RANGE = 250;
+  static constexpr time::nanoseconds PROPAGATION_DELAY = 1_ms;
+  static constexpr time::nanoseconds PRODUCER_DELAY = 1_ms;
+  static constexpr time::nanoseconds TICK = fw::clf::DeferredInterestPool::DEFAULT_TICK_INTERVAL;
+  static constexpr time::milliseconds INTEREST_LIFETIME = 2_s;
+
+protected:
+  Stats stats;
+
+private:
+  shared_ptr<time::UnitTestSteadyClock> m_steadyClock;
+  shared_ptr<time::UnitTestSystemClock> m_systemClock;
+  time::nanoseconds m_now = 0_ns;
+  ndn::KeyChain m_keyChain{"pib-memory:", "tpm-memory:"};
+  std::vector<unique_ptr<Node>> m_nodes;
+};
+
+constexpr double ClfTraceBenchmarkFixture::RADIO_RANGE;
+constexpr time::nanoseconds ClfTraceBenchmarkFixture::PROPAGATION_DELAY;
+constexpr time::nanoseconds ClfTraceBenchmarkFixture::PRODUCER_DELAY;
+constexpr time::nanoseconds ClfTraceBenchmarkFixture::TICK;
+constexpr time::milliseconds ClfTraceBenchmarkFixture::INTEREST_LIFETIME;
+
+// This test case replays the trace given in the CLF_TRACE environment variable, or a generated
+// trace of 50 vehicles on a 5 km highway for 60 seconds, with the strategy parameters given in the
+// CLF_STRATEGY_PARAMS environment variable (e.g. "coalesce~2000/contention~adaptive"), and reports the forwarding throughput,
+// the cost of an Interest in the forwarder and the strategy in time and heap allocations, and how well
+// rebroadcasts are suppressed.
+BOOST_FIXTURE_TEST_CASE(TraceReplay, ClfTraceBenchmarkFixture)
+{
+  ClfTrace trace;
+  const char* traceFile = std::getenv("CLF_TRACE");
+  if (traceFile != nullptr) {
+    std::ifstream is(traceFile);
+    BOOST_REQUIRE_MESSAGE(is, "cannot open " << traceFile);
+    trace = ClfTrace::load(is);
+  }
+  else {
+    trace = ClfTrace::generate(50, 5, 5000, 60_s, 100_ms, 500_ms);
+  }
+  BOOST_REQUIRE(!trace.events.empty());
+
+  Name strategyName = ClfStrategy::getStrategyName();
+  const char* params = std::getenv("CLF_STRATEGY_PARAMS");
+  if (params != nullptr) {
+    strategyName.append(Name(params));
+  }
+  setup(trace, strategyName);
+
+  auto wall1 = std::chrono::steady_clock::now();
+  for (const auto& event : trace.events) {
+    advanceTo(event.time);
+    apply(event);
+  }
+  // let the last Interests be answered or expire
+  advanceTo(trace.events.back().time + INTEREST_LIFETIME);
+  auto wall2 = std::chrono::steady_clock::now();
+  auto wallTime = std::chrono::duration_cast<std::chrono::microseconds>(wall2 - wall1);
+
+  uint64_t nInInterests = 0;
+  uint64_t nScheduled = 0;
+  uint64_t nCancelled = 0;
+  uint64_t nFired = 0;
+  uint64_t nBatches = 0;
+  uint64_t nDeferred = 0;
+  uint64_t nSuppressed = 0;
+  uint64_t nDuplicates = 0;
+  uint64_t nRedundant = 0;
+  for (size_t i = 0; i < getNodeCount(); ++i) {
+    nInInterests += getNode(i).forwarder.getCounters().nInInterests;
+
+    const auto& strategy = getStrategy(i);
+    const auto& poolCounters = strategy.getDeferredInterests().getCounters();
+    nScheduled += poolCounters.nScheduled;
+    nCancelled += poolCounters.nCancelled;
+    nFired += poolCounters.nFired;
+    nBatches += poolCounters.nBatches;
+
+    const auto* contention = strategy.getContentionController().getCounters(getNode(i).adHocFace->getId());
+    if (contention != nullptr) {
+      nDeferred += contention->nDeferred;
+      nSuppressed += contention->nSuppressed;
+      nDuplicates += contention->nDuplicates;
+      nRedundant += contention->nRedundantRebroadcasts;
+    }
+  }
+
+  // A deferred rebroadcast is suppressed when a copy of the Interest or the Data is overheard from a
+  // neighbor, including the duplicate Interests that the forwarder drops as looped on ad-hoc faces.
+  double suppressionRatio = nDeferred == 0 ? 0.0 : static_cast<double>(nSuppressed) / nDeferred;
+
+  std::cout << "Nodes " << getNodeCount() << ", events " << trace.events.size()
+            << ", virtual time " << time::duration_cast<time::milliseconds>(trace.events.back().time) << "\n"
+            << "Interests expressed " << stats.nExpressed << ", satisfied " << stats.nSatisfied;
+  if (stats.nSatisfied > 0) {
+    std::cout << ", mean latency "
+              << time::duration_cast<time::microseconds>(stats.totalLatency / stats.nSatisfied);
+  }
+  std::cout << "\n"
+            << "Transmissions " << stats.nTransmissions << ", Interests processed " << nInInterests
+            << " in " << wallTime.count() << " us, "
+            << static_cast<uint64_t>(nInInterests * 1e6 / std::max<int64_t>(wallTime.count(), 1))
+            << " Interests/s\n"
+            << "CPU time per received Interest "
+            << (stats.nInterestDeliveries == 0 ? 0 :
+                std::chrono::duration_cast<std::chrono::nanoseconds>(stats.interestCpuTime).count() /
+                stats.nInterestDeliveries) << " ns, heap allocations per received Interest "
+            << (stats.nInterestDeliveries == 0 ? 0.0 :
+                static_cast<double>(stats.nInterestAllocations) / stats.nInterestDeliveries) << "\n"
+            << "Deferred timers scheduled " << nScheduled << ", cancelled " << nCancelled
+            << ", fired " << nFired << ", rebroadcast bursts " << nBatches << "\n"
+            << "Rebroadcasts deferred " << nDeferred << ", suppressed " << nSuppressed
+            << ", suppression ratio " << suppressionRatio << "\n"
+            << "Duplicate Interests " << nDuplicates << ", redundant rebroadcasts " << nRedundant
+            << std::endl;
+
+  BOOST_CHECK_GT(stats.nInterestDeliveries, 0);
+  BOOST_CHECK_GT(stats.nSatisfied, 0);
+  BOOST_CHECK_LE(stats.nSatisfied, stats.nExpressed);
+  BOOST_CHECK_LE(nSuppressed, nDeferred);
+  BOOST_CHECK_GE(suppressionRatio, 0.0);
+  BOOST_CHECK_LE(suppressionRatio, 1.0);
+}
+
+} // namespace tests
+} // namespace nfd
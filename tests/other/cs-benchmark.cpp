@@ -25,8 +25,12 @@
 
 #include "benchmark-helpers.hpp"
 #include "table/cs.hpp"
+#include "table/cs-policy-wtinylfu.hpp"
 
+#include <cmath>
 #include <iostream>
+#include <map>
+#include <random>
 
 #ifdef NFD_HAVE_VALGRIND
 #include <valgrind/callgrind.h>
@@ -210,5 +214,113 @@ BOOST_FIXTURE_TEST_CASE(FindCanBePrefixHit, CsBenchmarkFixture)
   std::cout << "find(CanBePrefix-hit) " << (N_INTERESTS * N_CHILDREN * REPEAT) << ": " << d << std::endl;
 }
 
+// find hit by exact name and by full name in a large store
+BOOST_FIXTURE_TEST_CASE(FindExactHitLarge, CsBenchmarkFixture)
+{
+  constexpr size_t N_ENTRIES = 10000000;
+  constexpr size_t N_INTERESTS = 1000000;
+  constexpr size_t REPEAT = 4;
+
+  cs.setLimit(N_ENTRIES);
+  SimpleNameGenerator genName;
+  std::vector<shared_ptr<Interest>> exactWorkload(N_INTERESTS);
+  std::vector<shared_ptr<Interest>> fullNameWorkload(N_INTERESTS);
+  constexpr size_t STRIDE = N_ENTRIES / N_INTERESTS;
+  for (size_t i = 0; i < N_ENTRIES; ++i) {
+    auto data = makeData(genName(i));
+    cs.insert(*data, false);
+    if (i % STRIDE == 0) {
+      exactWorkload[i / STRIDE] = std::make_shared<Interest>(data->getName());
+      fullNameWorkload[i / STRIDE] = std::make_shared<Interest>(data->getFullName());
+    }
+  }
+  BOOST_REQUIRE(cs.size() == N_ENTRIES);
+
+  for (const auto& workload : {std::make_pair("exact", &exactWorkload),
+                               std::make_pair("full-name", &fullNameWorkload)}) {
+    time::microseconds d = timedRun([&] {
+      for (size_t j = 0; j < REPEAT; ++j) {
+        for (const auto& interest : *workload.second) {
+          find(*interest);
+        }
+      }
+    });
+
+    std::cout << "find(" << workload.first << "-hit) in " << N_ENTRIES << " entries "
+              << (N_INTERESTS * REPEAT) << ": " << d << ", "
+              << static_cast<uint64_t>(N_INTERESTS * REPEAT / (d.count() / 1e6)) << " lookups/s"
+              << std::endl;
+  }
+}
+
+// hit ratio of each policy on Zipf-distributed requests interrupted by sequential scans
+BOOST_FIXTURE_TEST_CASE(ZipfScanHitRatio, CsBenchmarkFixture)
+{
+  constexpr size_t N_CATALOG = CS_CAPACITY * 4;
+  constexpr double ZIPF_EXPONENT = 0.9;
+  constexpr size_t N_REQUESTS = 1000000;
+  constexpr size_t SCAN_INTERVAL = 100000; // a scan starts after this many Zipf requests
+  constexpr size_t SCAN_LENGTH = CS_CAPACITY * 2;
+
+  // request sequence: a catalog index, or -1 for the next Data of a scan
+  std::vector<int64_t> requests;
+  requests.reserve(N_REQUESTS + N_REQUESTS / SCAN_INTERVAL * SCAN_LENGTH);
+  {
+    std::vector<double> weights(N_CATALOG);
+    for (size_t i = 0; i < N_CATALOG; ++i) {
+      weights[i] = 1.0 / std::pow(i + 1, ZIPF_EXPONENT);
+    }
+    std::discrete_distribution<int64_t> zipf(weights.begin(), weights.end());
+    std::mt19937 rng(0);
+    for (size_t i = 0; i < N_REQUESTS; ++i) {
+      requests.push_back(zipf(rng));
+      if ((i + 1) % SCAN_INTERVAL == 0) {
+        requests.insert(requests.end(), SCAN_LENGTH, -1);
+      }
+    }
+  }
+  auto catalog = makeDataWorkload(N_CATALOG, SimpleNameGenerator("/cs/benchmark/zipf"));
+  SimpleNameGenerator genScanName("/cs/benchmark/scan");
+
+  std::map<std::string, double> hitRatios;
+  for (const char* policyName : {"lru", "priority_fifo", "wtinylfu"}) {
+    Cs store;
+    store.setPolicy(cs::Policy::create(policyName));
+    store.setLimit(CS_CAPACITY);
+
+    size_t nZipfHits = 0;
+    size_t nScanned = 0;
+    time::microseconds d = timedRun([&] {
+      for (int64_t request : requests) {
+        shared_ptr<Data> data = request >= 0 ? catalog[request] : makeData(genScanName(nScanned++));
+        bool isHit = false;
+        store.find(Interest(data->getName()),
+                   [&] (auto&&...) { isHit = true; },
+                   [] (auto&&...) {});
+        if (!isHit) {
+          store.insert(*data, false);
+        }
+        else if (request >= 0) {
+          ++nZipfHits;
+        }
+      }
+    });
+
+    double hitRatio = static_cast<double>(nZipfHits) / N_REQUESTS;
+    hitRatios[policyName] = hitRatio;
+    std::cout << "zipf+scan " << policyName << ": hit ratio of Zipf requests "
+              << hitRatio << ", "
+              << requests.size() << " requests in " << d << std::endl;
+
+    if (auto policy = dynamic_cast<const cs::WTinyLfuPolicy*>(store.getPolicy())) {
+      const auto& counters = policy->getCounters();
+      std::cout << "  admitted=" << counters.nAdmitted << " rejected=" << counters.nRejected << std::endl;
+    }
+  }
+
+  // the scans displace the popular Data from LRU, but are not admitted by W-TinyLFU
+  BOOST_CHECK_GT(hitRatios["wtinylfu"], hitRatios["lru"]);
+}
+
 } // namespace tests
 } // namespace nfd
@@ -77,6 +77,72 @@ protected:
     }
   }
 
+  // This models PIT and FIB operations with simple Interest-Data exchanges.
+  // A total of nRoundTrip Interests are received and forwarded, and the same number of Data are returned.
+  void
+  runSimpleExchanges()
+  {
+    // number of Interest-Data exchanges
+    const size_t nRoundTrip = 1000000;
+    // number of iterations between processing incoming Interest and processing incoming Data
+    const size_t replyGap = 20000;
+    // total amount of FIB entries
+    // packet names are homogeneously extended from these FIB entries
+    const size_t nFibEntries = 2000;
+    // length of fibPrefix, must be >= 1
+    const size_t fibPrefixLength = 1;
+    // length of Interest Name >= fibPrefixLength
+    const size_t interestNameLength= 2;
+    // length of Data Name >= Interest Name
+    const size_t dataNameLength = 3;
+
+    generatePacketsAndPopulateFib(nRoundTrip, nFibEntries, fibPrefixLength,
+                                  interestNameLength, dataNameLength);
+
+#ifdef NFD_HAVE_VALGRIND
+    CALLGRIND_START_INSTRUMENTATION;
+#endif
+
+    auto t1 = time::steady_clock::now();
+
+    for (size_t i = 0; i < nRoundTrip + replyGap; ++i) {
+      if (i < nRoundTrip) {
+        // process incoming Interest
+        auto pitEntry = m_pit.insert(*interests[i]).first;
+        m_fib.findLongestPrefixMatch(*pitEntry);
+      }
+      if (i >= replyGap) {
+        // process incoming Data
+        auto matches = m_pit.findAllDataMatches(*data[i - replyGap]);
+        // delete matching PIT entries
+        for (const auto& pitEntry : matches) {
+          m_pit.erase(pitEntry.get());
+        }
+      }
+    }
+
+    auto t2 = time::steady_clock::now();
+
+#ifdef NFD_HAVE_VALGRIND
+    CALLGRIND_STOP_INSTRUMENTATION;
+#endif
+
+    std::cout << m_nameTree.getHashtableLayout() << ' '
+              << time::duration_cast<time::microseconds>(t2 - t1) << ", "
+              << time::duration_cast<time::nanoseconds>(t2 - t1).count() / nRoundTrip
+              << " ns per exchange" << std::endl;
+
+    const auto& resizeStats = m_nameTree.getHashtableResizeStats();
+    std::cout << "  resizes=" << resizeStats.nResizes << " steps=" << resizeStats.nSteps
+              << " timed=" << resizeStats.nTimedSteps
+              << " total=" << time::duration_cast<time::microseconds>(resizeStats.totalTime) << '\n'
+              << "  timed step durations (< 2^i us):";
+    for (uint64_t count : resizeStats.histogram) {
+      std::cout << ' ' << count;
+    }
+    std::cout << std::endl;
+  }
+
 private:
   static void
   extendName(Name& name, size_t length)
@@ -97,56 +163,15 @@ protected:
   Pit m_pit;
 };
 
-// This test case models PIT and FIB operations with simple Interest-Data exchanges.
-// A total of nRoundTrip Interests are received and forwarded, and the same number of Data are returned.
 BOOST_FIXTURE_TEST_CASE(SimpleExchanges, PitFibBenchmarkFixture)
 {
-  // number of Interest-Data exchanges
-  const size_t nRoundTrip = 1000000;
-  // number of iterations between processing incoming Interest and processing incoming Data
-  const size_t replyGap = 20000;
-  // total amount of FIB entries
-  // packet names are homogeneously extended from these FIB entries
-  const size_t nFibEntries = 2000;
-  // length of fibPrefix, must be >= 1
-  const size_t fibPrefixLength = 1;
-  // length of Interest Name >= fibPrefixLength
-  const size_t interestNameLength= 2;
-  // length of Data Name >= Interest Name
-  const size_t dataNameLength = 3;
-
-  generatePacketsAndPopulateFib(nRoundTrip, nFibEntries, fibPrefixLength,
-                                interestNameLength, dataNameLength);
-
-#ifdef NFD_HAVE_VALGRIND
-  CALLGRIND_START_INSTRUMENTATION;
-#endif
-
-  auto t1 = time::steady_clock::now();
-
-  for (size_t i = 0; i < nRoundTrip + replyGap; ++i) {
-    if (i < nRoundTrip) {
-      // process incoming Interest
-      auto pitEntry = m_pit.insert(*interests[i]).first;
-      m_fib.findLongestPrefixMatch(*pitEntry);
-    }
-    if (i >= replyGap) {
-      // process incoming Data
-      auto matches = m_pit.findAllDataMatches(*data[i - replyGap]);
-      // delete matching PIT entries
-      for (const auto& pitEntry : matches) {
-        m_pit.erase(pitEntry.get());
-      }
-    }
-  }
-
-  auto t2 = time::steady_clock::now();
-
-#ifdef NFD_HAVE_VALGRIND
-  CALLGRIND_STOP_INSTRUMENTATION;
-#endif
+  runSimpleExchanges();
+}
 
-  std::cout << time::duration_cast<time::microseconds>(t2 - t1) << std::endl;
+BOOST_FIXTURE_TEST_CASE(SimpleExchangesOpenAddressing, PitFibBenchmarkFixture)
+{
+  m_nameTree.setHashtableLayout(name_tree::HashtableLayout::OPEN_ADDRESSING);
+  runSimpleExchanges();
 }
 
 } // namespace tests
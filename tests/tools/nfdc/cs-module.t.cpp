@@ -24,6 +24,8 @@
  */
 
 #include "nfdc/cs-module.hpp"
+#include "core/cs-byte-info.hpp"
+#include "core/cs-wtinylfu-info.hpp"
 
 #include "status-fixture.hpp"
 #include "execute-command-fixture.hpp"
@@ -275,6 +277,111 @@ BOOST_FIXTURE_TEST_CASE(Status, StatusFixture<CsModule>)
   BOOST_CHECK(statusText.is_equal(STATUS_TEXT));
 }
 
+const std::string STATUS_BYTES_XML = stripXmlSpaces(R"XML(
+  <cs>
+    <capacity>31807</capacity>
+    <admitEnabled/>
+    <nEntries>16131</nEntries>
+    <nHits>14363</nHits>
+    <nMisses>27462</nMisses>
+    <byteCapacity>4194304</byteCapacity>
+    <nBytes>2097152</nBytes>
+  </cs>
+)XML");
+
+const std::string STATUS_BYTES_TEXT = std::string(R"TEXT(
+CS information:
+  capacity=31807
+     admit=on
+     serve=off
+  nEntries=16131
+     nHits=14363
+   nMisses=27462
+  maxBytes=4194304
+    nBytes=2097152
+  hitRatioPerMiB=0.171704
+)TEXT").substr(1);
+
+BOOST_FIXTURE_TEST_CASE(StatusBytes, StatusFixture<CsModule>)
+{
+  this->fetchStatus();
+  CsInfo info;
+  info.setCapacity(31807)
+      .setEnableAdmit(true)
+      .setEnableServe(false)
+      .setNEntries(16131)
+      .setNHits(14363)
+      .setNMisses(27462);
+  CsByteInfo byteInfo;
+  byteInfo.byteCapacity = 4194304;
+  byteInfo.nBytes = 2097152;
+  CsInfo payload(appendCsByteInfo(info.wireEncode(), byteInfo));
+  this->sendDataset("/localhost/nfd/cs/info", payload);
+  this->prepareStatusOutput();
+
+  BOOST_CHECK(statusXml.is_equal(STATUS_BYTES_XML));
+  BOOST_CHECK(statusText.is_equal(STATUS_BYTES_TEXT));
+}
+
+const std::string STATUS_WTINYLFU_XML = stripXmlSpaces(R"XML(
+  <cs>
+    <capacity>31807</capacity>
+    <admitEnabled/>
+    <nEntries>16131</nEntries>
+    <nHits>14363</nHits>
+    <nMisses>27462</nMisses>
+    <nBytes>2097152</nBytes>
+    <wtinylfuCounters>
+      <nWindowHits>211</nWindowHits>
+      <nProbationHits>3560</nProbationHits>
+      <nProtectedHits>10592</nProtectedHits>
+      <nInserted>27462</nInserted>
+      <nAdmitted>1204</nAdmitted>
+      <nRejected>10127</nRejected>
+    </wtinylfuCounters>
+  </cs>
+)XML");
+
+const std::string STATUS_WTINYLFU_TEXT = std::string(R"TEXT(
+CS information:
+  capacity=31807
+     admit=on
+     serve=off
+  nEntries=16131
+     nHits=14363
+   nMisses=27462
+    nBytes=2097152
+  hitRatioPerMiB=0.171704
+  wtinylfu={windowHits=211 probationHits=3560 protectedHits=10592 inserted=27462 admitted=1204 rejected=10127}
+)TEXT").substr(1);
+
+BOOST_FIXTURE_TEST_CASE(StatusWTinyLfu, StatusFixture<CsModule>)
+{
+  this->fetchStatus();
+  CsInfo info;
+  info.setCapacity(31807)
+      .setEnableAdmit(true)
+      .setEnableServe(false)
+      .setNEntries(16131)
+      .setNHits(14363)
+      .setNMisses(27462);
+  CsByteInfo byteInfo;
+  byteInfo.nBytes = 2097152;
+  CsWTinyLfuInfo policyInfo;
+  policyInfo.nWindowHits = 211;
+  policyInfo.nProbationHits = 3560;
+  policyInfo.nProtectedHits = 10592;
+  policyInfo.nInserted = 27462;
+  policyInfo.nAdmitted = 1204;
+  policyInfo.nRejected = 10127;
+  CsInfo payload(appendCsWTinyLfuInfo(appendCsByteInfo(info.wireEncode(), byteInfo), policyInfo));
+  this->sendDataset("/localhost/nfd/cs/info", payload);
+  this->prepareStatusOutput();
+
+  BOOST_CHECK(statusXml.is_equal(STATUS_WTINYLFU_XML));
+  BOOST_CHECK(statusText.is_equal(STATUS_WTINYLFU_TEXT));
+}
+
 BOOST_AUTO_TEST_SUITE_END() // TestCsModule
 BOOST_AUTO_TEST_SUITE_END() // Nfdc
 
@@ -24,6 +24,7 @@
  */
 
 #include "nfdc/face-module.hpp"
+#include "core/face-contention-info.hpp"
 
 #include "execute-command-fixture.hpp"
 #include "status-fixture.hpp"
@@ -1158,6 +1159,83 @@ BOOST_FIXTURE_TEST_CASE(Status, StatusFixture<FaceModule>)
   BOOST_CHECK(statusText.is_equal(STATUS_TEXT));
 }
 
+const std::string STATUS_CONTENTION_XML = stripXmlSpaces(R"XML(
+  <faces>
+    <face>
+      <faceId>262</faceId>
+      <remoteUri>ether://[01:00:5e:00:17:aa]</remoteUri>
+      <localUri>dev://wlan0</localUri>
+      <faceScope>non-local</faceScope>
+      <facePersistency>permanent</facePersistency>
+      <linkType>adhoc</linkType>
+      <congestion/>
+      <flags/>
+      <packetCounters>
+        <incomingPackets>
+          <nInterests>4019</nInterests>
+          <nData>1877</nData>
+          <nNacks>0</nNacks>
+        </incomingPackets>
+        <outgoingPackets>
+          <nInterests>1288</nInterests>
+          <nData>950</nData>
+          <nNacks>0</nNacks>
+        </outgoingPackets>
+      </packetCounters>
+      <byteCounters>
+        <incomingBytes>917504</incomingBytes>
+        <outgoingBytes>393216</outgoingBytes>
+      </byteCounters>
+      <contentionCounters>
+        <nDuplicateInterests>1530</nDuplicateInterests>
+        <nDeferredInterests>1702</nDeferredInterests>
+        <nSuppressedInterests>601</nSuppressedInterests>
+        <nRebroadcastInterests>1101</nRebroadcastInterests>
+        <nRedundantRebroadcasts>87</nRedundantRebroadcasts>
+      </contentionCounters>
+    </face>
+  </faces>
+)XML");
+
+const std::string STATUS_CONTENTION_TEXT =
+  "Faces:\n"
+  "  faceid=262 remote=ether://[01:00:5e:00:17:aa] local=dev://wlan0"
+    " counters={in={4019i 1877d 0n 917504B} out={1288i 950d 0n 393216B}}"
+    " contention={deferred=1702 suppressed=601 rebroadcast=1101 duplicate=1530 redundant=87}"
+    " flags={non-local permanent adhoc}\n";
+
+BOOST_FIXTURE_TEST_CASE(StatusContention, StatusFixture<FaceModule>)
+{
+  this->fetchStatus();
+  FaceStatus status;
+  status.setFaceId(262)
+        .setRemoteUri("ether://[01:00:5e:00:17:aa]")
+        .setLocalUri("dev://wlan0")
+        .setFaceScope(ndn::nfd::FACE_SCOPE_NON_LOCAL)
+        .setFacePersistency(ndn::nfd::FACE_PERSISTENCY_PERMANENT)
+        .setLinkType(ndn::nfd::LINK_TYPE_AD_HOC)
+        .setNInInterests(4019)
+        .setNInData(1877)
+        .setNInNacks(0)
+        .setNOutInterests(1288)
+        .setNOutData(950)
+        .setNOutNacks(0)
+        .setNInBytes(917504)
+        .setNOutBytes(393216);
+  FaceContentionInfo contention;
+  contention.nDuplicateInterests = 1530;
+  contention.nDeferredInterests = 1702;
+  contention.nSuppressedInterests = 601;
+  contention.nRebroadcastInterests = 1101;
+  contention.nRedundantRebroadcasts = 87;
+  FaceStatus payload(appendFaceContentionInfo(status.wireEncode(), contention));
+  this->sendDataset("/localhost/nfd/faces/list", payload);
+  this->prepareStatusOutput();
+
+  BOOST_CHECK(statusXml.is_equal(STATUS_CONTENTION_XML));
+  BOOST_CHECK(statusText.is_equal(STATUS_CONTENTION_TEXT));
+}
+
 BOOST_AUTO_TEST_SUITE_END() // TestFaceModule
 BOOST_AUTO_TEST_SUITE_END() // Nfdc
 
@@ -25,6 +25,8 @@
 
 #include "cs-module.hpp"
 #include "format-helpers.hpp"
+#include "core/cs-byte-info.hpp"
+#include "core/cs-wtinylfu-info.hpp"
 
 #include <ndn-cxx/util/indented-stream.hpp>
 
@@ -160,6 +162,26 @@ CsModule::formatItemXml(std::ostream& os, const CsInfo& item)
   os << "<nEntries>" << item.getNEntries() << "</nEntries>";
   os << "<nHits>" << item.getNHits() << "</nHits>";
   os << "<nMisses>" << item.getNMisses() << "</nMisses>";
+
+  auto byteInfo = extractCsByteInfo(item.wireEncode());
+  if (byteInfo) {
+    if (byteInfo->byteCapacity) {
+      os << "<byteCapacity>" << *byteInfo->byteCapacity << "</byteCapacity>";
+    }
+    os << "<nBytes>" << byteInfo->nBytes << "</nBytes>";
+  }
+
+  auto policyInfo = extractCsWTinyLfuInfo(item.wireEncode());
+  if (policyInfo) {
+    os << "<wtinylfuCounters>";
+    os << "<nWindowHits>" << policyInfo->nWindowHits << "</nWindowHits>";
+    os << "<nProbationHits>" << policyInfo->nProbationHits << "</nProbationHits>";
+    os << "<nProtectedHits>" << policyInfo->nProtectedHits << "</nProtectedHits>";
+    os << "<nInserted>" << policyInfo->nInserted << "</nInserted>";
+    os << "<nAdmitted>" << policyInfo->nAdmitted << "</nAdmitted>";
+    os << "<nRejected>" << policyInfo->nRejected << "</nRejected>";
+    os << "</wtinylfuCounters>";
+  }
   os << "</cs>";
 }
 
@@ -180,8 +202,34 @@ CsModule::formatItemText(std::ostream& os, const CsInfo& item)
      << ia("serve") << text::OnOff{item.getEnableServe()}
      << ia("nEntries") << item.getNEntries()
      << ia("nHits") << item.getNHits()
-     << ia("nMisses") << item.getNMisses()
-     << ia.end();
+     << ia("nMisses") << item.getNMisses();
+
+  auto byteInfo = extractCsByteInfo(item.wireEncode());
+  if (byteInfo) {
+    if (byteInfo->byteCapacity) {
+      os << ia("maxBytes") << *byteInfo->byteCapacity;
+    }
+    os << ia("nBytes") << byteInfo->nBytes;
+
+    // hit ratio per MiB of stored packets, to compare how well caches of different sizes use memory
+    uint64_t nLookups = item.getNHits() + item.getNMisses();
+    if (nLookups > 0 && byteInfo->nBytes > 0) {
+      double hitRatio = static_cast<double>(item.getNHits()) / nLookups;
+      os << ia("hitRatioPerMiB") << hitRatio / (byteInfo->nBytes / 1048576.0);
+    }
+  }
+
+  auto policyInfo = extractCsWTinyLfuInfo(item.wireEncode());
+  if (policyInfo) {
+    os << ia("wtinylfu")
+       << "{windowHits=" << policyInfo->nWindowHits
+       << " probationHits=" << policyInfo->nProbationHits
+       << " protectedHits=" << policyInfo->nProtectedHits
+       << " inserted=" << policyInfo->nInserted
+       << " admitted=" << policyInfo->nAdmitted
+       << " rejected=" << policyInfo->nRejected << "}";
+  }
+  os << ia.end();
 }
 
 } // namespace nfdc
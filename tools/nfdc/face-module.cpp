@@ -26,6 +26,7 @@
 #include "face-module.hpp"
 #include "canonizer.hpp"
 #include "find-face.hpp"
+#include "core/face-contention-info.hpp"
 
 namespace nfd {
 namespace tools {
@@ -450,6 +451,17 @@ FaceModule::formatItemXml(std::ostream& os, const FaceStatus& item) const
   os << "<outgoingBytes>" << item.getNOutBytes() << "</outgoingBytes>";
   os << "</byteCounters>";
 
+  auto contention = extractFaceContentionInfo(item.wireEncode());
+  if (contention) {
+    os << "<contentionCounters>";
+    os << "<nDuplicateInterests>" << contention->nDuplicateInterests << "</nDuplicateInterests>";
+    os << "<nDeferredInterests>" << contention->nDeferredInterests << "</nDeferredInterests>";
+    os << "<nSuppressedInterests>" << contention->nSuppressedInterests << "</nSuppressedInterests>";
+    os << "<nRebroadcastInterests>" << contention->nRebroadcastInterests << "</nRebroadcastInterests>";
+    os << "<nRedundantRebroadcasts>" << contention->nRedundantRebroadcasts << "</nRedundantRebroadcasts>";
+    os << "</contentionCounters>";
+  }
+
   os << "</face>";
 }
 
@@ -506,6 +518,16 @@ FaceModule::formatItemText(std::ostream& os, const FaceStatus& item, bool wantMu
      << item.getNOutNacks() << "n "
      << item.getNOutBytes() << "B}}";
 
+  auto contention = extractFaceContentionInfo(item.wireEncode());
+  if (contention) {
+    os << ia("contention")
+       << "{deferred=" << contention->nDeferredInterests
+       << " suppressed=" << contention->nSuppressedInterests
+       << " rebroadcast=" << contention->nRebroadcastInterests
+       << " duplicate=" << contention->nDuplicateInterests
+       << " redundant=" << contention->nRedundantRebroadcasts << "}";
+  }
+
   os << ia("flags") << '{';
   text::Separator flagSep("", " ");
   os << flagSep << item.getFaceScope();